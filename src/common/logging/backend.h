@@ -135,4 +135,7 @@ const char* GetLevelName(Level log_level);
  * never get the message
  */
 void SetGlobalFilter(const Filter& filter);
+
+/// Returns true if messages of the given class and level pass the global filter.
+bool IsLogEnabled(Class log_class, Level log_level);
 } // namespace Log
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <span>
 #include <vector>
 
 #include "common/common_types.h"
@@ -56,4 +57,14 @@ namespace Common::Compression {
 [[nodiscard]] std::vector<u8> DecompressDataLZ4(const std::vector<u8>& compressed,
                                                 std::size_t uncompressed_size);
 
+/**
+ * Decompresses a source memory region with LZ4 into an existing destination memory region.
+ *
+ * @param compressed the compressed source memory region.
+ * @param uncompressed the destination memory region, sized to the uncompressed data.
+ *
+ * @return true if the data decompressed to exactly the size of the destination.
+ */
+[[nodiscard]] bool DecompressDataLZ4(std::span<const u8> compressed, std::span<u8> uncompressed);
+
 } // namespace Common::Compression
\ No newline at end of file
@@ -21,7 +21,11 @@
 #include <unistd.h>
 #endif
 
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
 #include <string>
+#include <fmt/format.h>
 
 #ifdef __FreeBSD__
 #define cpu_set_t cpuset_t
@@ -136,4 +140,77 @@ void SetCurrentThreadName(const char* name) {
 
 #endif
 
+namespace {
+
+/// Number of logical CPUs representable in an affinity mask
+constexpr u32 MAX_AFFINITY_CPUS = 64;
+
+u32 NumLogicalCPUs() {
+    return std::clamp(std::thread::hardware_concurrency(), 1U, MAX_AFFINITY_CPUS);
+}
+
+#ifdef __linux__
+/// Parses a sysfs CPU list such as "0-3,8" into a mask
+u64 ParseCPUList(const std::string& list) {
+    u64 mask = 0;
+    const char* it = list.c_str();
+    while (*it != '\0') {
+        char* end;
+        const unsigned long first = std::strtoul(it, &end, 10);
+        unsigned long last = first;
+        if (*end == '-') {
+            last = std::strtoul(end + 1, &end, 10);
+        }
+        for (unsigned long cpu = first; cpu <= last && cpu < MAX_AFFINITY_CPUS; ++cpu) {
+            mask |= 1ULL << cpu;
+        }
+        if (end == it || *end != ',') {
+            break;
+        }
+        it = end + 1;
+    }
+    return mask;
+}
+#endif
+
+} // Anonymous namespace
+
+bool SetCurrentThreadAffinity(u64 mask) {
+#if defined(_WIN32)
+    return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(mask)) != 0;
+#elif defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (u32 cpu = 0; cpu < MAX_AFFINITY_CPUS; ++cpu) {
+        if ((mask >> cpu) & 1) {
+            CPU_SET(cpu, &cpu_set);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+#else
+    return false;
+#endif
+}
+
+std::vector<u32> GetPhysicalCoreCPUs() {
+    std::vector<u32> cpus;
+    u64 listed_cpus = 0;
+    for (u32 cpu = 0; cpu < NumLogicalCPUs(); ++cpu) {
+        if ((listed_cpus >> cpu) & 1) {
+            continue;
+        }
+        cpus.push_back(cpu);
+        listed_cpus |= 1ULL << cpu;
+#ifdef __linux__
+        std::ifstream file{
+            fmt::format("/sys/devices/system/cpu/cpu{}/topology/thread_siblings_list", cpu)};
+        std::string siblings;
+        if (std::getline(file, siblings)) {
+            listed_cpus |= ParseCPUList(siblings);
+        }
+#endif
+    }
+    return cpus;
+}
+
 } // namespace Common
@@ -10,6 +10,7 @@
 #include <cstddef>
 #include <mutex>
 #include <thread>
+#include <vector>
 #include "common/common_types.h"
 
 namespace Common {
@@ -98,4 +99,10 @@ void SetCurrentThreadPriority(ThreadPriority new_priority);
 
 void SetCurrentThreadName(const char* name);
 
+/// Restricts the current thread to the host logical CPUs set in the mask, returns true on success.
+bool SetCurrentThreadAffinity(u64 mask);
+
+/// Returns one logical CPU of each physical host core, so SMT siblings aren't listed twice.
+std::vector<u32> GetPhysicalCoreCPUs();
+
 } // namespace Common
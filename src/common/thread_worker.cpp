@@ -32,6 +32,12 @@ ThreadWorker::ThreadWorker(std::size_t num_workers, const std::string& name) {
                 }
 
                 task();
+
+                {
+                    std::unique_lock lock{queue_mutex};
+                    ++work_done;
+                }
+                wait_condition.notify_all();
             }
         });
 }
@@ -51,8 +57,14 @@ void ThreadWorker::QueueWork(std::function<void()>&& work) {
     {
         std::unique_lock lock{queue_mutex};
         requests.emplace(work);
+        ++work_scheduled;
     }
     condition.notify_one();
 }
 
+void ThreadWorker::WaitForRequests() {
+    std::unique_lock lock{queue_mutex};
+    wait_condition.wait(lock, [this] { return work_done == work_scheduled; });
+}
+
 } // namespace Common
@@ -5,11 +5,13 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <mutex>
+#include <queue>
 #include <string>
+#include <thread>
 #include <vector>
-#include <queue>
 
 namespace Common {
 
@@ -19,11 +21,17 @@ public:
     ~ThreadWorker();
     void QueueWork(std::function<void()>&& work);
 
+    /// Blocks until all the work queued so far has finished executing.
+    void WaitForRequests();
+
 private:
     std::vector<std::thread> threads;
     std::queue<std::function<void()>> requests;
     std::mutex queue_mutex;
     std::condition_variable condition;
+    std::condition_variable wait_condition;
+    std::size_t work_scheduled{};
+    std::size_t work_done{};
     std::atomic_bool stop{};
 };
 
@@ -0,0 +1,218 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#ifdef __linux__
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "common/virtual_buffer.h"
+#include "common/write_watcher.h"
+
+namespace Common {
+
+/**
+ * Each page has an entry holding its tag, or zero when it is not watched. The lowest bit of the
+ * tag is set while the page is write protected. The fault handler clears it and pushes the page to
+ * a lock-free ring that is drained when writes are collected. When the ring fills up, the handler
+ * raises a flag and the next collection scans every entry instead.
+ */
+struct WriteWatcher::Impl {
+    static constexpr u64 PROTECTED_BIT = 1;
+    static constexpr std::size_t RING_SIZE = 0x1000;
+
+    explicit Impl(u8* base_, std::size_t size_)
+        : base{base_}, size{size_}, entries(size_ / PAGE_SIZE) {}
+
+    std::atomic<u64>& Entry(const u8* page) {
+        return entries[static_cast<std::size_t>(page - base) / PAGE_SIZE];
+    }
+
+    const std::atomic<u64>& Entry(const u8* page) const {
+        return entries[static_cast<std::size_t>(page - base) / PAGE_SIZE];
+    }
+
+    void Protect(u8* page, bool writable) {
+#ifdef __linux__
+        mprotect(page, PAGE_SIZE, writable ? PROT_READ | PROT_WRITE : PROT_READ);
+#endif
+    }
+
+    /// Called from the signal handler, must only use async-signal-safe operations.
+    void HandleWrite(std::size_t page_index) {
+        // Make the page writable before clearing its protected bit. This way a collection that
+        // protects the page again in between is always seen by the loop below.
+        Protect(base + page_index * PAGE_SIZE, true);
+
+        std::atomic<u64>& entry = entries[page_index];
+        u64 value = entry.load(std::memory_order_acquire);
+        while ((value & PROTECTED_BIT) != 0) {
+            if (entry.compare_exchange_weak(value, value & ~PROTECTED_BIT,
+                                            std::memory_order_acq_rel)) {
+                Push(page_index);
+                break;
+            }
+        }
+    }
+
+    void Push(std::size_t page_index) {
+        // Only reserve a slot when the ring has room, so every reserved slot is eventually written
+        u64 index = write_index.load(std::memory_order_acquire);
+        do {
+            if (index - read_index.load(std::memory_order_acquire) >= RING_SIZE) {
+                overflowed.store(true, std::memory_order_release);
+                return;
+            }
+        } while (!write_index.compare_exchange_weak(index, index + 1, std::memory_order_acq_rel));
+        ring[index % RING_SIZE].store(page_index + 1, std::memory_order_release);
+    }
+
+    /// Protects a written page again and reports its tag. Requires the mutex to be held.
+    bool Rearm(std::size_t page_index, std::vector<u64>& tags) {
+        std::atomic<u64>& entry = entries[page_index];
+        const u64 value = entry.load(std::memory_order_acquire);
+        if (value == 0 || (value & PROTECTED_BIT) != 0) {
+            // Unwatched since it was written, or reported twice
+            return false;
+        }
+        entry.store(value | PROTECTED_BIT, std::memory_order_release);
+        Protect(base + page_index * PAGE_SIZE, false);
+        tags.push_back(value);
+        return true;
+    }
+
+#ifdef __linux__
+    static void HandleSignal(int sig, siginfo_t* info, void* raw_context) {
+        Impl* const impl = active.load(std::memory_order_acquire);
+        const u8* const address = static_cast<const u8*>(info->si_addr);
+        if (impl != nullptr && address >= impl->base && address < impl->base + impl->size) {
+            impl->HandleWrite(static_cast<std::size_t>(address - impl->base) / PAGE_SIZE);
+            return;
+        }
+        // Not a write to a watched page, forward it to whoever was handling it before
+        if ((previous_action.sa_flags & SA_SIGINFO) != 0) {
+            previous_action.sa_sigaction(sig, info, raw_context);
+            return;
+        }
+        if (previous_action.sa_handler == SIG_DFL || previous_action.sa_handler == SIG_IGN) {
+            // Restore the previous disposition, the faulting instruction raises it when retried
+            sigaction(sig, &previous_action, nullptr);
+            return;
+        }
+        previous_action.sa_handler(sig);
+    }
+
+    static inline struct sigaction previous_action {};
+#endif
+
+    static inline std::atomic<Impl*> active{};
+
+    u8* const base;
+    const std::size_t size;
+
+    VirtualBuffer<std::atomic<u64>> entries;
+
+    std::array<std::atomic<u64>, RING_SIZE> ring{};
+    std::atomic<u64> write_index{};
+    std::atomic<u64> read_index{};
+    std::atomic<bool> overflowed{};
+
+    mutable std::mutex mutex;
+};
+
+WriteWatcher::WriteWatcher(std::unique_ptr<Impl> impl_) : impl{std::move(impl_)} {}
+
+WriteWatcher::~WriteWatcher() {
+#ifdef __linux__
+    sigaction(SIGSEGV, &Impl::previous_action, nullptr);
+    mprotect(impl->base, impl->size, PROT_READ | PROT_WRITE);
+#endif
+    Impl::active.store(nullptr, std::memory_order_release);
+}
+
+std::unique_ptr<WriteWatcher> WriteWatcher::Create(u8* base, std::size_t size) {
+#ifdef __linux__
+    if (sysconf(_SC_PAGESIZE) != static_cast<long>(PAGE_SIZE) ||
+        reinterpret_cast<uintptr_t>(base) % PAGE_SIZE != 0 || size % PAGE_SIZE != 0) {
+        return nullptr;
+    }
+    auto impl = std::make_unique<Impl>(base, size);
+    Impl* expected = nullptr;
+    if (!Impl::active.compare_exchange_strong(expected, impl.get())) {
+        return nullptr;
+    }
+
+    struct sigaction action {};
+    action.sa_sigaction = &Impl::HandleSignal;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGSEGV, &action, &Impl::previous_action) != 0) {
+        Impl::active.store(nullptr, std::memory_order_release);
+        return nullptr;
+    }
+    return std::unique_ptr<WriteWatcher>(new WriteWatcher(std::move(impl)));
+#else
+    return nullptr;
+#endif
+}
+
+bool WriteWatcher::Watch(u8* page, u64 tag) {
+    std::scoped_lock lock{impl->mutex};
+    std::atomic<u64>& entry = impl->Entry(page);
+    const u64 value = entry.load(std::memory_order_acquire);
+    if (value != 0) {
+        return (value & ~Impl::PROTECTED_BIT) == tag;
+    }
+    entry.store(tag | Impl::PROTECTED_BIT, std::memory_order_release);
+    impl->Protect(page, false);
+    return true;
+}
+
+void WriteWatcher::Unwatch(u8* page, u64 tag) {
+    std::scoped_lock lock{impl->mutex};
+    std::atomic<u64>& entry = impl->Entry(page);
+    if ((entry.load(std::memory_order_acquire) & ~Impl::PROTECTED_BIT) != tag) {
+        return;
+    }
+    impl->Protect(page, true);
+    entry.store(0, std::memory_order_release);
+}
+
+bool WriteWatcher::IsWatched(const u8* page, u64 tag) const {
+    const u64 value = impl->Entry(page).load(std::memory_order_acquire);
+    return value != 0 && (value & ~Impl::PROTECTED_BIT) == tag;
+}
+
+std::size_t WriteWatcher::CollectWrites(std::vector<u64>& tags) {
+    std::scoped_lock lock{impl->mutex};
+    std::size_t count = 0;
+
+    const u64 begin = impl->read_index.load(std::memory_order_relaxed);
+    const u64 end = impl->write_index.load(std::memory_order_acquire);
+    for (u64 index = begin; index < end; ++index) {
+        std::atomic<u64>& slot = impl->ring[index % Impl::RING_SIZE];
+        u64 value;
+        while ((value = slot.exchange(0, std::memory_order_acq_rel)) == 0) {
+            // The slot was reserved by a handler that has not written it yet
+            std::this_thread::yield();
+        }
+        count += impl->Rearm(static_cast<std::size_t>(value - 1), tags) ? 1 : 0;
+    }
+    impl->read_index.store(end, std::memory_order_release);
+
+    if (impl->overflowed.exchange(false, std::memory_order_acq_rel)) {
+        for (std::size_t page_index = 0; page_index < impl->entries.size(); ++page_index) {
+            count += impl->Rearm(page_index, tags) ? 1 : 0;
+        }
+    }
+    return count;
+}
+
+} // namespace Common
@@ -0,0 +1,63 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "common/common_types.h"
+
+namespace Common {
+
+/**
+ * Detects writes to pages of a host memory region by write protecting them and catching the
+ * resulting access violations. Each watched page reports its first write and stays writable until
+ * the writes are collected, which protects it again.
+ * Only Linux hosts with 4 KiB pages are supported, and only one watcher can exist at a time.
+ */
+class WriteWatcher {
+public:
+    /// Page size watched pages are tracked at.
+    static constexpr std::size_t PAGE_SIZE = 0x1000;
+
+    /**
+     * Creates a watcher over a page aligned region.
+     * @returns The watcher, or nullptr if the host is not supported or another watcher exists.
+     */
+    [[nodiscard]] static std::unique_ptr<WriteWatcher> Create(u8* base, std::size_t size);
+
+    ~WriteWatcher();
+
+    WriteWatcher(const WriteWatcher&) = delete;
+    WriteWatcher& operator=(const WriteWatcher&) = delete;
+
+    /**
+     * Write protects a page and associates a tag to it, reported when the page is written.
+     * @param page Page aligned pointer inside the watched region.
+     * @param tag  Non-zero page aligned value identifying the page.
+     * @returns True if the page is now watched with this tag, false if it is watched with another.
+     */
+    bool Watch(u8* page, u64 tag);
+
+    /// Stops watching a page and makes it writable, if it is watched with the given tag.
+    void Unwatch(u8* page, u64 tag);
+
+    /// Returns true if the page is watched with the given tag.
+    [[nodiscard]] bool IsWatched(const u8* page, u64 tag) const;
+
+    /**
+     * Appends the tags of the pages written since the last call and write protects them again.
+     * @returns The number of tags appended.
+     */
+    std::size_t CollectWrites(std::vector<u64>& tags);
+
+private:
+    struct Impl;
+
+    explicit WriteWatcher(std::unique_ptr<Impl> impl_);
+
+    std::unique_ptr<Impl> impl;
+};
+
+} // namespace Common
@@ -2,24 +2,109 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <thread>
+
 #include "common/thread.h"
 #include "core/arm/cpu_interrupt_handler.h"
+#include "core/hardware_properties.h"
+
+#if _MSC_VER
+#include <intrin.h>
+#if _M_AMD64
+#define __x86_64__ 1
+#endif
+#if _M_ARM64
+#define __aarch64__ 1
+#endif
+#else
+#if __x86_64__
+#include <xmmintrin.h>
+#endif
+#endif
 
 namespace Core {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Longest time an idle core spins, waits longer than this are better spent blocked
+constexpr std::chrono::nanoseconds MAX_SPIN_TIME = std::chrono::microseconds{50};
+constexpr std::chrono::nanoseconds INITIAL_SPIN_TIME = std::chrono::microseconds{10};
+
+void ThreadPause() {
+#if __x86_64__
+    _mm_pause();
+#elif __aarch64__ && _MSC_VER
+    __yield();
+#elif __aarch64__
+    asm("yield");
+#endif
+}
+
+} // Anonymous namespace
 
 CPUInterruptHandler::CPUInterruptHandler() : interrupt_event{std::make_unique<Common::Event>()} {}
 
 CPUInterruptHandler::~CPUInterruptHandler() = default;
 
+void CPUInterruptHandler::SetIdlePolicy(Settings::CPUIdlePolicy policy) {
+    // Spinning only pays off when the thread raising the interrupt has a host CPU of its own
+    if (std::thread::hardware_concurrency() <= Hardware::NUM_CPU_CORES) {
+        policy = Settings::CPUIdlePolicy::Park;
+    }
+    idle_policy = policy;
+    spin_time = policy == Settings::CPUIdlePolicy::Adaptive ? INITIAL_SPIN_TIME
+                                                            : std::chrono::nanoseconds{};
+}
+
 void CPUInterruptHandler::SetInterrupt(bool is_interrupted_) {
+    // Publish the state before waking up the core, so it sees the interrupt once awake
+    is_interrupted = is_interrupted_;
     if (is_interrupted_) {
-        interrupt_event->Set();
+        // Waking a spinning core only needs the flag, the event is set when it might be blocked
+        is_wake_pending.store(true);
+        if (is_parked.load()) {
+            interrupt_event->Set();
+        }
     }
-    is_interrupted = is_interrupted_;
 }
 
 void CPUInterruptHandler::AwaitInterrupt() {
-    interrupt_event->Wait();
+    const Clock::time_point start = Clock::now();
+    if (spin_time.count() > 0) {
+        const Clock::time_point spin_end = start + spin_time;
+        do {
+            if (is_wake_pending.load(std::memory_order_relaxed) &&
+                is_wake_pending.exchange(false)) {
+                // The wake up came in time, keep spinning for at least twice as long as it took
+                const auto elapsed = Clock::now() - start;
+                spin_time = std::clamp<std::chrono::nanoseconds>(elapsed * 2, spin_time,
+                                                                 MAX_SPIN_TIME);
+                return;
+            }
+            ThreadPause();
+        } while (Clock::now() < spin_end);
+    }
+
+    // Publish that we are about to block before checking for a wake up, SetInterrupt does the
+    // same in the opposite order, so at least one of the two sides sees the other.
+    is_parked.store(true);
+    if (!is_wake_pending.load()) {
+        interrupt_event->Wait();
+    }
+    is_wake_pending.store(false);
+    is_parked.store(false);
+
+    if (idle_policy == Settings::CPUIdlePolicy::Adaptive) {
+        // Spin next time if this wake up would have been caught, otherwise spin less
+        const auto elapsed = Clock::now() - start;
+        if (elapsed <= MAX_SPIN_TIME) {
+            spin_time = std::min<std::chrono::nanoseconds>(elapsed * 2, MAX_SPIN_TIME);
+        } else {
+            spin_time /= 2;
+        }
+    }
 }
 
 } // namespace Core
@@ -5,8 +5,11 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 
+#include "core/settings.h"
+
 namespace Common {
 class Event;
 }
@@ -28,13 +31,22 @@ public:
         return is_interrupted;
     }
 
+    /// Selects how AwaitInterrupt waits. Must not be called while a thread is waiting.
+    void SetIdlePolicy(Settings::CPUIdlePolicy policy);
+
     void SetInterrupt(bool is_interrupted);
 
+    /// Blocks until an interrupt is signaled. It may return spuriously.
     void AwaitInterrupt();
 
 private:
     std::unique_ptr<Common::Event> interrupt_event;
     std::atomic_bool is_interrupted{false};
+    std::atomic_bool is_wake_pending{false};
+    std::atomic_bool is_parked{false};
+
+    Settings::CPUIdlePolicy idle_policy{Settings::CPUIdlePolicy::Park};
+    std::chrono::nanoseconds spin_time{};
 };
 
 } // namespace Core
@@ -12,6 +12,7 @@
 #include "core/arm/cpu_interrupt_handler.h"
 #include "core/arm/dynarmic/arm_dynarmic_64.h"
 #include "core/arm/dynarmic/arm_exclusive_monitor.h"
+#include "core/arm/jit_block_profile.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hardware_properties.h"
@@ -29,6 +30,19 @@ class DynarmicCallbacks64 : public Dynarmic::A64::UserCallbacks {
 public:
     explicit DynarmicCallbacks64(ARM_Dynarmic_64& parent) : parent(parent) {}
 
+    u32 MemoryReadCode(u64 vaddr) override {
+        // Instructions are only read to translate them, a read that does not follow the previous
+        // instruction, or that follows a branch or an exception, starts a new block
+        const u32 instruction = MemoryRead32(vaddr);
+        if (auto* const block_profile = parent.system.GetJitBlockProfile();
+            block_profile != nullptr && (vaddr != next_code_address || previous_ends_block)) {
+            block_profile->RecordBlock(vaddr);
+        }
+        next_code_address = vaddr + 4;
+        previous_ends_block = JitBlockProfile::EndsBlock(instruction);
+        return instruction;
+    }
+
     u8 MemoryRead8(u64 vaddr) override {
         return parent.system.Memory().Read8(vaddr);
     }
@@ -83,7 +97,7 @@ public:
     void InterpreterFallback(u64 pc, std::size_t num_instructions) override {
         LOG_ERROR(Core_ARM,
                   "Unimplemented instruction @ 0x{:X} for {} instructions (instr = {:08X})", pc,
-                  num_instructions, MemoryReadCode(pc));
+                  num_instructions, MemoryRead32(pc));
     }
 
     void ExceptionRaised(u64 pc, Dynarmic::A64::Exception exception) override {
@@ -97,7 +111,7 @@ public:
         case Dynarmic::A64::Exception::Breakpoint:
         default:
             ASSERT_MSG(false, "ExceptionRaised(exception = {}, pc = {:08X}, code = {:08X})",
-                       static_cast<std::size_t>(exception), pc, MemoryReadCode(pc));
+                       static_cast<std::size_t>(exception), pc, MemoryRead32(pc));
         }
     }
 
@@ -139,6 +153,8 @@ public:
     ARM_Dynarmic_64& parent;
     u64 tpidrro_el0 = 0;
     u64 tpidr_el0 = 0;
+    u64 next_code_address = 0;
+    bool previous_ends_block = false;
     static constexpr u64 minimum_run_cycles = 1000U;
 };
 
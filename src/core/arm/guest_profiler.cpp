@@ -0,0 +1,118 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <fmt/format.h>
+#include "common/logging/log.h"
+#include "core/arm/arm_interface.h"
+#include "core/arm/guest_profiler.h"
+#include "core/arm/symbols.h"
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/hardware_properties.h"
+#include "core/hle/kernel/k_scheduler.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/thread.h"
+#include "core/loader/loader.h"
+
+namespace Core {
+namespace {
+constexpr auto SAMPLE_INTERVAL = std::chrono::microseconds{500};
+constexpr std::size_t FUNCTIONS_PER_MODULE = 10;
+
+double Percentage(u64 part, u64 total) {
+    return total == 0 ? 0.0 : static_cast<double>(part) * 100.0 / static_cast<double>(total);
+}
+
+template <typename Map>
+std::vector<std::pair<std::string, u64>> SortByCount(const Map& counts) {
+    std::vector<std::pair<std::string, u64>> sorted(counts.begin(), counts.end());
+    std::sort(sorted.begin(), sorted.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+    return sorted;
+}
+} // Anonymous namespace
+
+GuestProfiler::GuestProfiler(System& system_) : system{system_} {}
+
+GuestProfiler::~GuestProfiler() {
+    if (event) {
+        system.CoreTiming().UnscheduleEvent(event, 0);
+    }
+}
+
+void GuestProfiler::Initialize() {
+    event = Timing::CreateEvent("GuestProfiler::Sample",
+                                [this](std::uintptr_t, std::chrono::nanoseconds ns_late) {
+                                    Sample(ns_late);
+                                });
+    system.CoreTiming().ScheduleEvent(SAMPLE_INTERVAL, event);
+}
+
+void GuestProfiler::Sample(std::chrono::nanoseconds ns_late) {
+    auto& kernel = system.Kernel();
+    {
+        std::scoped_lock lock{mutex};
+        for (std::size_t core = 0; core < Hardware::NUM_CPU_CORES; ++core) {
+            const Kernel::Thread* const thread = kernel.Scheduler(core).GetCurrentThread();
+            if (thread == nullptr || thread->IsIdleThread()) {
+                ++num_idle_samples;
+                continue;
+            }
+            ++samples[system.ArmInterface(core).GetPC()];
+            ++num_samples;
+        }
+    }
+    system.CoreTiming().ScheduleEvent(SAMPLE_INTERVAL - ns_late, event);
+}
+
+void GuestProfiler::LogProfile() {
+    std::scoped_lock lock{mutex};
+    LOG_INFO(Core_ARM, "Guest profile: {} samples, {:.2f}% of them idle", num_samples,
+             Percentage(num_idle_samples, num_samples + num_idle_samples));
+    if (num_samples == 0) {
+        return;
+    }
+
+    std::map<VAddr, std::string> modules;
+    if (system.GetAppLoader().ReadNSOModules(modules) != Loader::ResultStatus::Success) {
+        modules.clear();
+    }
+    std::map<VAddr, Symbols::Symbols> symbols;
+    for (const auto& [base, name] : modules) {
+        symbols.emplace(base, Symbols::GetSymbols(base, system.Memory()));
+    }
+
+    std::map<std::string, u64> module_samples;
+    std::map<std::string, std::map<std::string, u64>> function_samples;
+    for (const auto& [pc, count] : samples) {
+        auto module = modules.upper_bound(pc);
+        if (module == modules.begin()) {
+            module_samples["unknown"] += count;
+            function_samples["unknown"][fmt::format("{:016X}", pc)] += count;
+            continue;
+        }
+        --module;
+        const VAddr offset = pc - module->first;
+        const auto name = Symbols::GetSymbolName(symbols[module->first], offset);
+        module_samples[module->second] += count;
+        function_samples[module->second][name.value_or(fmt::format("+0x{:X}", offset))] += count;
+    }
+
+    for (const auto& [module, count] : SortByCount(module_samples)) {
+        LOG_INFO(Core_ARM, "{:6.2f}% {}", Percentage(count, num_samples), module);
+        const auto functions = SortByCount(function_samples[module]);
+        const std::size_t num_functions = std::min(functions.size(), FUNCTIONS_PER_MODULE);
+        for (std::size_t i = 0; i < num_functions; ++i) {
+            LOG_INFO(Core_ARM, "    {:6.2f}% {}", Percentage(functions[i].second, num_samples),
+                     functions[i].first);
+        }
+    }
+}
+
+} // namespace Core
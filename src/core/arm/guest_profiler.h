@@ -0,0 +1,51 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "common/common_types.h"
+
+namespace Core {
+class System;
+}
+
+namespace Core::Timing {
+struct EventType;
+}
+
+namespace Core {
+
+/**
+ * Periodically samples the PC of each emulated core and builds a flat profile of the guest
+ * functions of every loaded module. Dynarmic only updates the PC between blocks, so samples are
+ * attributed to the start of the block being executed.
+ */
+class GuestProfiler {
+public:
+    explicit GuestProfiler(System& system_);
+    ~GuestProfiler();
+
+    /// Starts sampling. Must be called once the cores are running the current process.
+    void Initialize();
+
+    /// Logs the share of samples spent in each module and its hottest functions.
+    void LogProfile();
+
+private:
+    void Sample(std::chrono::nanoseconds ns_late);
+
+    System& system;
+    std::shared_ptr<Timing::EventType> event;
+
+    std::mutex mutex;
+    std::unordered_map<VAddr, u64> samples;
+    u64 num_samples{};
+    u64 num_idle_samples{};
+};
+
+} // namespace Core
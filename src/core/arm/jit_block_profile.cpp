@@ -0,0 +1,66 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/logging/log.h"
+#include "core/arm/jit_block_profile.h"
+
+namespace Core {
+namespace {
+std::chrono::milliseconds CPUTimeSince(std::clock_t start) {
+    const auto elapsed = static_cast<s64>(std::clock() - start);
+    return std::chrono::milliseconds{elapsed * 1000 / static_cast<s64>(CLOCKS_PER_SEC)};
+}
+} // Anonymous namespace
+
+JitBlockProfile::JitBlockProfile()
+    : start_time{std::chrono::steady_clock::now()}, start_cpu_time{std::clock()} {}
+
+JitBlockProfile::~JitBlockProfile() = default;
+
+bool JitBlockProfile::EndsBlock(u32 instruction) noexcept {
+    return (instruction & 0x7C000000) == 0x14000000 || // B, BL
+           (instruction & 0xFF000010) == 0x54000000 || // B.cond
+           (instruction & 0x7E000000) == 0x34000000 || // CBZ, CBNZ
+           (instruction & 0x7E000000) == 0x36000000 || // TBZ, TBNZ
+           (instruction & 0xFE000000) == 0xD6000000 || // BR, BLR, RET, ERET
+           (instruction & 0xFF000000) == 0xD4000000;   // SVC, HVC, SMC, BRK, HLT
+}
+
+void JitBlockProfile::RecordBlock(VAddr address) {
+    std::scoped_lock lock{mutex};
+    ++statistics.num_translations;
+
+    if (!is_startup_measured) {
+        if (std::chrono::steady_clock::now() - start_time < STARTUP_WINDOW) {
+            ++statistics.num_startup_translations;
+        } else {
+            statistics.startup_cpu_time = CPUTimeSince(start_cpu_time);
+            is_startup_measured = true;
+        }
+    }
+
+    if (blocks.insert(address).second) {
+        ++statistics.num_blocks;
+    }
+}
+
+JitBlockProfileStatistics JitBlockProfile::GetStatistics() const {
+    std::scoped_lock lock{mutex};
+    JitBlockProfileStatistics result = statistics;
+    if (!is_startup_measured) {
+        result.startup_cpu_time = CPUTimeSince(start_cpu_time);
+    }
+    return result;
+}
+
+void JitBlockProfile::LogStatistics() const {
+    const JitBlockProfileStatistics stats = GetStatistics();
+    LOG_INFO(Core_ARM, "JIT blocks: {} translations, {} distinct blocks", stats.num_translations,
+             stats.num_blocks);
+    LOG_INFO(Core_ARM, "JIT startup: {} translations and {} ms of CPU time in the first {} s",
+             stats.num_startup_translations, stats.startup_cpu_time.count(),
+             STARTUP_WINDOW.count());
+}
+
+} // namespace Core
@@ -0,0 +1,59 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <chrono>
+#include <ctime>
+#include <mutex>
+#include <unordered_set>
+#include "common/common_types.h"
+
+namespace Core {
+
+struct JitBlockProfileStatistics {
+    /// Blocks translated by any core, including re-translations after cache invalidations
+    u64 num_translations{};
+    /// Distinct blocks translated in this run
+    u64 num_blocks{};
+    /// Blocks translated during the startup window
+    u64 num_startup_translations{};
+    /// Process CPU time spent during the startup window
+    std::chrono::milliseconds startup_cpu_time{};
+};
+
+/**
+ * Counts the guest blocks translated by the JIT, to measure how much translation work is done
+ * during startup and how much of it is repeated after cache invalidations.
+ */
+class JitBlockProfile {
+public:
+    /// Translations in this window after creation are accounted as startup work
+    static constexpr std::chrono::seconds STARTUP_WINDOW{60};
+
+    JitBlockProfile();
+    ~JitBlockProfile();
+
+    /// Returns true when an A64 instruction is a branch or an exception, ending the block that
+    /// contains it. The instruction that follows it is translated as the start of another block.
+    [[nodiscard]] static bool EndsBlock(u32 instruction) noexcept;
+
+    /// Records the translation of the block starting at address. Thread-safe.
+    void RecordBlock(VAddr address);
+
+    [[nodiscard]] JitBlockProfileStatistics GetStatistics() const;
+
+    void LogStatistics() const;
+
+private:
+    std::chrono::steady_clock::time_point start_time;
+    std::clock_t start_cpu_time;
+
+    mutable std::mutex mutex;
+    std::unordered_set<VAddr> blocks;
+    JitBlockProfileStatistics statistics;
+    bool is_startup_measured = false;
+};
+
+} // namespace Core
@@ -0,0 +1,42 @@
+// Copyright 2018 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+#include "common/common_types.h"
+
+namespace Core::Memory {
+class Memory;
+}
+
+namespace Core::Symbols {
+
+struct Symbol {
+    /// Offset of the symbol from the start of its module
+    u64 offset;
+    u64 size;
+    std::string name;
+};
+
+using Symbols = std::vector<Symbol>;
+
+/// Reads the dynamic symbol table of the NSO module loaded at text_offset.
+Symbols GetSymbols(VAddr text_offset, Core::Memory::Memory& memory);
+
+/// Returns the name of the symbol containing the given offset from the start of its module.
+std::optional<std::string> GetSymbolName(const Symbols& symbols, VAddr func_address);
+
+/**
+ * Writes the symbols of the given modules to a file, one "<address> <size> <module>!<name>" line
+ * per symbol with hexadecimal guest addresses, in the layout of perf map files.
+ * @returns true if the file could be written.
+ */
+bool WriteSymbolMap(const std::string& path, const std::map<VAddr, std::string>& modules,
+                    Core::Memory::Memory& memory);
+
+} // namespace Core::Symbols
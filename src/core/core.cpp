@@ -6,11 +6,19 @@
 #include <memory>
 #include <utility>
 
+#ifdef __linux__
+#include <cstdlib>
+#include <unistd.h>
+#endif
+
 #include "common/file_util.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "common/string_util.h"
 #include "core/arm/exclusive_monitor.h"
+#include "core/arm/guest_profiler.h"
+#include "core/arm/jit_block_profile.h"
+#include "core/arm/symbols.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/cpu_manager.h"
@@ -156,7 +164,15 @@ struct System::Impl {
     ResultStatus Init(System& system, Frontend::EmuWindow& emu_window) {
         LOG_DEBUG(Core, "initialized OK");
 
+#ifdef __linux__
+        if (Settings::values.enable_jit_perf_map) {
+            // Makes dynarmic write /tmp/perf-<pid>.map, naming each block after its guest location
+            setenv("PERF_BUILDID_DIR", "/tmp", 0);
+        }
+#endif
+
         device_memory = std::make_unique<Core::DeviceMemory>();
+        memory.SetHostWriteTracking(Settings::values.use_host_write_tracking);
 
         is_multicore = Settings::values.use_multi_core.GetValue();
         is_async_gpu = Settings::values.use_asynchronous_gpu_emulation.GetValue();
@@ -233,6 +249,9 @@ struct System::Impl {
         }
 
         telemetry_session->AddInitialInfo(*app_loader, fs_controller, *content_provider);
+        if (Settings::values.enable_jit_block_profile) {
+            jit_block_profile = std::make_unique<JitBlockProfile>();
+        }
         auto main_process =
             Kernel::Process::Create(system, "main", Kernel::Process::ProcessType::Userland);
         const auto [load_result, load_parameters] = app_loader->Load(*main_process, system);
@@ -252,6 +271,16 @@ struct System::Impl {
             cheat_engine->Initialize();
         }
 
+#ifdef __linux__
+        if (Settings::values.enable_jit_perf_map) {
+            WriteGuestSymbolMap();
+        }
+#endif
+        if (Settings::values.enable_guest_profiler) {
+            guest_profiler = std::make_unique<GuestProfiler>(system);
+            guest_profiler->Initialize();
+        }
+
         // All threads are started, begin main process execution, now that we're in the clear.
         main_process->Run(load_parameters->main_thread_priority,
                           load_parameters->main_thread_stack_size);
@@ -302,6 +331,11 @@ struct System::Impl {
             gpu_core->WaitIdle();
         }
 
+        if (guest_profiler) {
+            guest_profiler->LogProfile();
+            guest_profiler.reset();
+        }
+
         // Shutdown emulation session
         services.reset();
         service_manager.reset();
@@ -310,6 +344,13 @@ struct System::Impl {
 
         // Close all CPU/threading state
         cpu_manager.Shutdown();
+        if (app_loader) {
+            kernel.LogSchedulerStatistics();
+        }
+        if (jit_block_profile) {
+            jit_block_profile->LogStatistics();
+            jit_block_profile.reset();
+        }
 
         // Shutdown kernel and core timing
         core_timing.Shutdown();
@@ -318,6 +359,7 @@ struct System::Impl {
         // Close app loader
         app_loader.reset();
         gpu_core.reset();
+        memory.SetHostWriteTracking(false);
         perf_stats.reset();
 
         // Clear all applets
@@ -357,6 +399,22 @@ struct System::Impl {
         arp_manager.Register(launch.title_id, launch, std::move(nacp_data));
     }
 
+#ifdef __linux__
+    /// Writes the guest symbols of the loaded modules next to the perf map written by dynarmic
+    void WriteGuestSymbolMap() {
+        std::map<VAddr, std::string> modules;
+        if (app_loader->ReadNSOModules(modules) != Loader::ResultStatus::Success) {
+            return;
+        }
+        const std::string path = fmt::format("/tmp/perf-{}.guest.map", getpid());
+        if (Symbols::WriteSymbolMap(path, modules, memory)) {
+            LOG_INFO(Core, "Wrote guest symbols to {}", path);
+        } else {
+            LOG_ERROR(Core, "Failed to write guest symbols to {}", path);
+        }
+    }
+#endif
+
     void SetStatus(ResultStatus new_status, const char* details = nullptr) {
         status = new_status;
         if (details) {
@@ -387,6 +445,8 @@ struct System::Impl {
 
     Reporter reporter;
     std::unique_ptr<Memory::CheatEngine> cheat_engine;
+    std::unique_ptr<GuestProfiler> guest_profiler;
+    std::unique_ptr<JitBlockProfile> jit_block_profile;
     std::unique_ptr<Tools::Freezer> memory_freezer;
     std::array<u8, 0x20> build_id{};
 
@@ -752,6 +812,10 @@ const System::CurrentBuildProcessID& System::GetCurrentProcessBuildID() const {
     return impl->build_id;
 }
 
+JitBlockProfile* System::GetJitBlockProfile() {
+    return impl->jit_block_profile.get();
+}
+
 Service::SM::ServiceManager& System::ServiceManager() {
     return *impl->service_manager;
 }
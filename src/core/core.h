@@ -100,6 +100,7 @@ class CpuManager;
 class DeviceMemory;
 class ExclusiveMonitor;
 class FrameLimiter;
+class JitBlockProfile;
 class PerfStats;
 class Reporter;
 class TelemetrySession;
@@ -363,6 +364,9 @@ public:
     void SetCurrentProcessBuildID(const CurrentBuildProcessID& id);
     [[nodiscard]] const CurrentBuildProcessID& GetCurrentProcessBuildID() const;
 
+    /// Gets the profile of translated guest blocks, or nullptr if it is disabled.
+    [[nodiscard]] JitBlockProfile* GetJitBlockProfile();
+
     /// Register a host thread as an emulated CPU Core.
     void RegisterCoreThread(std::size_t id);
 
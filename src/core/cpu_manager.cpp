@@ -14,6 +14,7 @@
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/physical_core.h"
 #include "core/hle/kernel/thread.h"
+#include "core/host_affinity.h"
 #include "video_core/gpu.h"
 
 namespace Core {
@@ -330,6 +331,7 @@ void CpuManager::RunThread(std::size_t core) {
     MicroProfileOnThreadCreate(name.c_str());
     Common::SetCurrentThreadName(name.c_str());
     Common::SetCurrentThreadPriority(Common::ThreadPriority::High);
+    PinCurrentThread(HostThreadType::CPUCore, core);
     auto& data = core_data[core];
     data.enter_barrier = std::make_unique<Common::Event>();
     data.exit_barrier = std::make_unique<Common::Event>();
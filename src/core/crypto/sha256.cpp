@@ -0,0 +1,231 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#endif
+
+#include "common/common_types.h"
+#ifdef ARCHITECTURE_x86_64
+#include "common/x64/cpu_detect.h"
+#endif
+#include "core/crypto/sha256.h"
+
+namespace Core::Crypto {
+
+namespace {
+
+constexpr std::array<u32, 8> INITIAL_STATE{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+alignas(16) constexpr std::array<u32, 64> ROUND_CONSTANTS{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+constexpr u32 RotateRight(u32 value, u32 amount) {
+    return (value >> amount) | (value << (32 - amount));
+}
+
+void CompressGeneric(std::array<u32, 8>& state, const u8* data, std::size_t num_blocks) {
+    for (std::size_t block = 0; block < num_blocks; ++block, data += 64) {
+        std::array<u32, 64> w;
+        for (std::size_t i = 0; i < 16; ++i) {
+            w[i] = (u32{data[i * 4]} << 24) | (u32{data[i * 4 + 1]} << 16) |
+                   (u32{data[i * 4 + 2]} << 8) | u32{data[i * 4 + 3]};
+        }
+        for (std::size_t i = 16; i < 64; ++i) {
+            const u32 s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const u32 s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        u32 a = state[0], b = state[1], c = state[2], d = state[3];
+        u32 e = state[4], f = state[5], g = state[6], h = state[7];
+        for (std::size_t i = 0; i < 64; ++i) {
+            const u32 s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+            const u32 ch = (e & f) ^ (~e & g);
+            const u32 temp1 = h + s1 + ch + ROUND_CONSTANTS[i] + w[i];
+            const u32 s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+            const u32 maj = (a & b) ^ (a & c) ^ (b & c);
+            const u32 temp2 = s0 + maj;
+            h = g;
+            g = f;
+            f = e;
+            e = d + temp1;
+            d = c;
+            c = b;
+            b = a;
+            a = temp1 + temp2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#ifdef ARCHITECTURE_x86_64
+
+#ifndef _MSC_VER
+__attribute__((target("sha,sse4.1")))
+#endif
+void CompressSHANI(std::array<u32, 8>& state, const u8* data, std::size_t num_blocks) {
+    const __m128i byte_swap_mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // Shuffle the state from ABCD/EFGH into the ABEF/CDGH layout used by the SHA instructions
+    __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    state1 = _mm_shuffle_epi32(state1, 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    for (std::size_t block = 0; block < num_blocks; ++block, data += 64) {
+        const __m128i abef_save = state0;
+        const __m128i cdgh_save = state1;
+
+        __m128i msgs[4];
+        for (std::size_t group = 0; group < 16; ++group) {
+            __m128i& current = msgs[group % 4];
+            __m128i& next = msgs[(group + 1) % 4];
+            __m128i& previous = msgs[(group + 3) % 4];
+            if (group < 4) {
+                current = _mm_shuffle_epi8(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + group * 16)),
+                    byte_swap_mask);
+            }
+
+            __m128i msg = _mm_add_epi32(
+                current,
+                _mm_load_si128(reinterpret_cast<const __m128i*>(&ROUND_CONSTANTS[group * 4])));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+            if (group >= 3 && group <= 14) {
+                next = _mm_add_epi32(next, _mm_alignr_epi8(current, previous, 4));
+                next = _mm_sha256msg2_epu32(next, current);
+            }
+            msg = _mm_shuffle_epi32(msg, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+            if (group >= 1 && group <= 12) {
+                previous = _mm_sha256msg1_epu32(previous, current);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+    }
+
+    // Shuffle back into ABCD/EFGH
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+
+bool HasSHAExtensions() {
+    static const bool has_sha = Common::GetCPUCaps().sha && Common::GetCPUCaps().sse4_1;
+    return has_sha;
+}
+
+#endif
+
+void Compress(std::array<u32, 8>& state, const u8* data, std::size_t num_blocks) {
+#ifdef ARCHITECTURE_x86_64
+    if (HasSHAExtensions()) {
+        CompressSHANI(state, data, num_blocks);
+        return;
+    }
+#endif
+    CompressGeneric(state, data, num_blocks);
+}
+
+} // Anonymous namespace
+
+SHA256Hasher::SHA256Hasher() {
+    Reset();
+}
+
+void SHA256Hasher::Update(std::span<const u8> data) {
+    total_size += data.size();
+
+    if (buffered_size != 0) {
+        const std::size_t to_copy = std::min(buffer.size() - buffered_size, data.size());
+        std::memcpy(buffer.data() + buffered_size, data.data(), to_copy);
+        buffered_size += to_copy;
+        data = data.subspan(to_copy);
+        if (buffered_size < buffer.size()) {
+            return;
+        }
+        Compress(state, buffer.data(), 1);
+        buffered_size = 0;
+    }
+
+    const std::size_t num_blocks = data.size() / buffer.size();
+    if (num_blocks != 0) {
+        Compress(state, data.data(), num_blocks);
+        data = data.subspan(num_blocks * buffer.size());
+    }
+
+    std::memcpy(buffer.data(), data.data(), data.size());
+    buffered_size = data.size();
+}
+
+std::array<u8, 0x20> SHA256Hasher::Finish() {
+    const u64 bit_length = total_size * 8;
+
+    std::array<u8, 128> padding{};
+    padding[0] = 0x80;
+    const std::size_t padding_size =
+        (buffered_size < 56 ? 56 - buffered_size : 120 - buffered_size);
+    Update(std::span{padding}.first(padding_size));
+
+    std::array<u8, 8> length_bytes;
+    for (std::size_t i = 0; i < length_bytes.size(); ++i) {
+        length_bytes[i] = static_cast<u8>(bit_length >> (56 - i * 8));
+    }
+    Update(length_bytes);
+
+    std::array<u8, 0x20> digest;
+    for (std::size_t i = 0; i < state.size(); ++i) {
+        digest[i * 4] = static_cast<u8>(state[i] >> 24);
+        digest[i * 4 + 1] = static_cast<u8>(state[i] >> 16);
+        digest[i * 4 + 2] = static_cast<u8>(state[i] >> 8);
+        digest[i * 4 + 3] = static_cast<u8>(state[i]);
+    }
+
+    Reset();
+    return digest;
+}
+
+void SHA256Hasher::Reset() {
+    state = INITIAL_STATE;
+    buffered_size = 0;
+    total_size = 0;
+}
+
+bool SHA256Hasher::IsAccelerated() {
+#ifdef ARCHITECTURE_x86_64
+    return HasSHAExtensions();
+#else
+    return false;
+#endif
+}
+
+} // namespace Core::Crypto
@@ -0,0 +1,40 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <span>
+#include "common/common_types.h"
+
+namespace Core::Crypto {
+
+/**
+ * Incremental SHA-256 hasher. Uses the x86 SHA extensions when the host supports them and falls
+ * back to a portable implementation otherwise.
+ */
+class SHA256Hasher {
+public:
+    SHA256Hasher();
+
+    /// Appends data to the message being hashed.
+    void Update(std::span<const u8> data);
+
+    /// Finishes the message and returns its digest. The hasher is reset afterwards.
+    std::array<u8, 0x20> Finish();
+
+    /// Resets the hasher to hash a new message.
+    void Reset();
+
+    /// Returns true when the hardware accelerated implementation is in use.
+    static bool IsAccelerated();
+
+private:
+    std::array<u32, 8> state{};
+    std::array<u8, 64> buffer{};
+    std::size_t buffered_size{};
+    u64 total_size{};
+};
+
+} // namespace Core::Crypto
@@ -0,0 +1,303 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "common/common_paths.h"
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "core/core.h"
+#include "core/file_sys/content_scanner.h"
+#include "core/file_sys/mode.h"
+#include "core/file_sys/nca_metadata.h"
+#include "core/file_sys/registered_cache.h"
+#include "core/file_sys/vfs.h"
+#include "core/loader/loader.h"
+#include "core/settings.h"
+
+namespace FileSys {
+
+namespace {
+
+constexpr u32 CacheMagic = Common::MakeMagic('Y', 'C', 'M', 'C');
+constexpr u32 CacheVersion = 2;
+
+bool WriteString(Common::FS::IOFile& file, std::string_view str) {
+    return file.WriteObject(static_cast<u32>(str.size())) == 1 &&
+           file.WriteArray(str.data(), str.size()) == str.size();
+}
+
+bool ReadString(Common::FS::IOFile& file, std::string& str) {
+    u32 size{};
+    if (file.ReadArray(&size, 1) != 1) {
+        return false;
+    }
+    str.resize(size);
+    return file.ReadArray(str.data(), size) == size;
+}
+
+bool WriteEntry(Common::FS::IOFile& file, const ContentMetadata& entry) {
+    return WriteString(file, entry.path) && file.WriteObject(entry.file_size) == 1 &&
+           file.WriteObject(entry.modification_time) == 1 &&
+           file.WriteObject(static_cast<u32>(entry.file_type)) == 1 &&
+           file.WriteObject(entry.program_id) == 1 && WriteString(file, entry.title) &&
+           file.WriteObject(static_cast<u32>(entry.icon.size())) == 1 &&
+           file.WriteArray(entry.icon.data(), entry.icon.size()) == entry.icon.size() &&
+           file.WriteObject(entry.update_id) == 1 && file.WriteObject(entry.language_index) == 1;
+}
+
+bool ReadEntry(Common::FS::IOFile& file, ContentMetadata& entry) {
+    u32 file_type{};
+    u32 icon_size{};
+    if (!ReadString(file, entry.path) || file.ReadArray(&entry.file_size, 1) != 1 ||
+        file.ReadArray(&entry.modification_time, 1) != 1 || file.ReadArray(&file_type, 1) != 1 ||
+        file.ReadArray(&entry.program_id, 1) != 1 || !ReadString(file, entry.title) ||
+        file.ReadArray(&icon_size, 1) != 1) {
+        return false;
+    }
+    entry.file_type = static_cast<Loader::FileType>(file_type);
+    entry.icon.resize(icon_size);
+    return file.ReadArray(entry.icon.data(), icon_size) == icon_size &&
+           file.ReadArray(&entry.update_id, 1) == 1 &&
+           file.ReadArray(&entry.language_index, 1) == 1;
+}
+
+/**
+ * Returns a value identifying the update applied to a title: its version when it is installed,
+ * the size of its control data when it comes from a game directory, or zero without update.
+ */
+u64 GetUpdateId(const ContentProvider& provider, u64 program_id) {
+    if (program_id == 0) {
+        return 0;
+    }
+    const u64 update_title_id = GetUpdateTitleID(program_id);
+    if (!provider.HasEntry(update_title_id, ContentRecordType::Program)) {
+        return 0;
+    }
+    if (const auto version = provider.GetEntryVersion(update_title_id)) {
+        return *version;
+    }
+    const auto control = provider.GetEntryRaw(update_title_id, ContentRecordType::Control);
+    return control != nullptr ? control->GetSize() : 1;
+}
+
+} // Anonymous namespace
+
+bool ContentMetadata::IsValid() const {
+    return file_type != Loader::FileType::Unknown && file_type != Loader::FileType::Error;
+}
+
+ContentMetadataCache::ContentMetadataCache(std::string cache_path_)
+    : cache_path{std::move(cache_path_)} {}
+
+ContentMetadataCache::~ContentMetadataCache() = default;
+
+void ContentMetadataCache::Load() {
+    std::scoped_lock lock{mutex};
+    entries.clear();
+    used_paths.clear();
+    is_dirty = false;
+
+    Common::FS::IOFile file(cache_path, "rb");
+    if (!file.IsOpen()) {
+        return;
+    }
+
+    u32 magic{};
+    u32 version{};
+    u32 num_entries{};
+    if (file.ReadArray(&magic, 1) != 1 || file.ReadArray(&version, 1) != 1 ||
+        file.ReadArray(&num_entries, 1) != 1 || magic != CacheMagic || version != CacheVersion) {
+        LOG_INFO(Loader, "Content metadata cache is invalid or outdated, ignoring it");
+        return;
+    }
+
+    for (u32 i = 0; i < num_entries; ++i) {
+        ContentMetadata entry;
+        if (!ReadEntry(file, entry)) {
+            LOG_ERROR(Loader, "Content metadata cache is corrupted, discarding it");
+            entries.clear();
+            return;
+        }
+        auto path = entry.path;
+        entries.insert_or_assign(std::move(path), std::move(entry));
+    }
+
+    LOG_INFO(Loader, "Loaded {} content metadata cache entries", entries.size());
+}
+
+void ContentMetadataCache::Save() {
+    std::scoped_lock lock{mutex};
+    if (!is_dirty) {
+        return;
+    }
+
+    if (!Common::FS::CreateFullPath(cache_path)) {
+        LOG_ERROR(Loader, "Failed to create content metadata cache path={}", cache_path);
+        return;
+    }
+
+    Common::FS::IOFile file(cache_path, "wb");
+    if (!file.IsOpen()) {
+        LOG_ERROR(Loader, "Failed to open content metadata cache path={}", cache_path);
+        return;
+    }
+
+    bool success = file.WriteObject(CacheMagic) == 1 && file.WriteObject(CacheVersion) == 1 &&
+                   file.WriteObject(static_cast<u32>(entries.size())) == 1;
+    for (const auto& [path, entry] : entries) {
+        success = success && WriteEntry(file, entry);
+    }
+
+    if (!success) {
+        LOG_ERROR(Loader, "Failed to write content metadata cache");
+        file.Close();
+        Common::FS::Delete(cache_path);
+        return;
+    }
+
+    is_dirty = false;
+}
+
+std::optional<ContentMetadata> ContentMetadataCache::Find(const std::string& path, u64 file_size,
+                                                          s64 modification_time) {
+    std::scoped_lock lock{mutex};
+    const auto it = entries.find(path);
+    if (it == entries.end() || it->second.file_size != file_size ||
+        it->second.modification_time != modification_time) {
+        return std::nullopt;
+    }
+    used_paths.insert(path);
+    return it->second;
+}
+
+void ContentMetadataCache::Insert(ContentMetadata metadata) {
+    std::scoped_lock lock{mutex};
+    used_paths.insert(metadata.path);
+    auto path = metadata.path;
+    entries.insert_or_assign(std::move(path), std::move(metadata));
+    is_dirty = true;
+}
+
+void ContentMetadataCache::PruneUnused() {
+    std::scoped_lock lock{mutex};
+    const std::size_t num_removed = std::erase_if(
+        entries, [this](const auto& entry) { return !used_paths.contains(entry.first); });
+    if (num_removed > 0) {
+        LOG_INFO(Loader, "Removed {} unused content metadata cache entries", num_removed);
+        is_dirty = true;
+    }
+}
+
+ContentScanner::ContentScanner(Core::System& system_, VirtualFilesystem vfs_,
+                               ContentMetadataCache* cache_)
+    : system{system_}, vfs{std::move(vfs_)}, cache{cache_} {}
+
+ContentScanner::~ContentScanner() = default;
+
+std::vector<std::string> ContentScanner::CollectFiles(const std::string& directory, u32 recursion,
+                                                      const Filter& filter,
+                                                      std::vector<std::string>* directories_out) {
+    std::vector<std::string> files;
+    const auto callback = [&](u64*, const std::string& parent, const std::string& virtual_name) {
+        const std::string physical_name = parent + DIR_SEP + virtual_name;
+        if (Common::FS::IsDirectory(physical_name)) {
+            if (recursion > 0) {
+                if (directories_out != nullptr) {
+                    directories_out->push_back(physical_name);
+                }
+                auto children = CollectFiles(physical_name, recursion - 1, filter, directories_out);
+                files.insert(files.end(), std::make_move_iterator(children.begin()),
+                             std::make_move_iterator(children.end()));
+            }
+        } else if (filter(physical_name)) {
+            files.push_back(physical_name);
+        }
+        return true;
+    };
+    Common::FS::ForeachDirectoryEntry(nullptr, directory, callback);
+    return files;
+}
+
+void ContentScanner::Scan(const std::vector<std::string>& paths, const Callback& callback,
+                          const std::atomic_bool& stop) {
+    cache_hits = 0;
+
+    // Files are parsed serially, as parsing containers decrypts them and registers title keys
+    // through the KeyManager, which is not thread-safe
+    for (const std::string& path : paths) {
+        if (stop) {
+            break;
+        }
+        ContentMetadata metadata = MakeMetadata(path);
+        std::optional<ContentMetadata> cached;
+        if (cache != nullptr) {
+            cached = cache->Find(path, metadata.file_size, metadata.modification_time);
+            if (cached && !IsPatchStateCurrent(*cached)) {
+                cached.reset();
+            }
+        }
+        if (cached) {
+            metadata = std::move(*cached);
+            ++cache_hits;
+        } else {
+            if (const auto file = vfs->OpenFile(path, Mode::Read)) {
+                if (const auto loader = Loader::GetLoader(system, file)) {
+                    ReadMetadata(*loader, metadata);
+                    ReadPatchState(metadata);
+                }
+            }
+            if (cache != nullptr) {
+                cache->Insert(metadata);
+            }
+        }
+        if (metadata.IsValid()) {
+            callback(metadata);
+        }
+    }
+
+    LOG_INFO(Loader, "Scanned {} files, {} served from the metadata cache", paths.size(),
+             cache_hits);
+}
+
+ContentMetadata ContentScanner::MakeMetadata(const std::string& path) {
+    return ContentMetadata{
+        .path = path,
+        .file_size = Common::FS::GetSize(path),
+        .modification_time = Common::FS::GetModificationTime(path),
+        .file_type = Loader::FileType::Unknown,
+        .program_id = 0,
+        .title = {},
+        .icon = {},
+        .update_id = 0,
+        .language_index = 0,
+    };
+}
+
+void ContentScanner::ReadMetadata(Loader::AppLoader& loader, ContentMetadata& metadata) {
+    metadata.file_type = loader.GetFileType();
+    if (!metadata.IsValid()) {
+        return;
+    }
+
+    [[maybe_unused]] const auto program_id_result = loader.ReadProgramId(metadata.program_id);
+    [[maybe_unused]] const auto icon_result = loader.ReadIcon(metadata.icon);
+
+    metadata.title = " ";
+    [[maybe_unused]] const auto title_result = loader.ReadTitle(metadata.title);
+}
+
+void ContentScanner::ReadPatchState(ContentMetadata& metadata) const {
+    metadata.update_id = GetUpdateId(system.GetContentProvider(), metadata.program_id);
+    metadata.language_index = Settings::values.language_index.GetValue();
+}
+
+bool ContentScanner::IsPatchStateCurrent(const ContentMetadata& metadata) const {
+    return metadata.update_id == GetUpdateId(system.GetContentProvider(), metadata.program_id) &&
+           metadata.language_index == Settings::values.language_index.GetValue();
+}
+
+} // namespace FileSys
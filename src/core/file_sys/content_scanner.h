@@ -0,0 +1,139 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "common/common_types.h"
+#include "core/file_sys/vfs_types.h"
+
+namespace Core {
+class System;
+}
+
+namespace Loader {
+class AppLoader;
+enum class FileType;
+} // namespace Loader
+
+namespace FileSys {
+
+/// Metadata of a game file that is required to list it without opening the file again.
+struct ContentMetadata {
+    std::string path;
+    u64 file_size{};
+    s64 modification_time{};
+    Loader::FileType file_type{};
+    u64 program_id{};
+    std::string title;
+    std::vector<u8> icon;
+    /// Identifies the update whose control data provided the title and icon, zero without update.
+    u64 update_id{};
+    /// System language the title was read in.
+    s32 language_index{};
+
+    /// Whether the file could be loaded. Unsupported files are cached too, to avoid reopening them.
+    bool IsValid() const;
+};
+
+/**
+ * Persistent cache of ContentMetadata keyed by path, file size and modification time. The update
+ * and language an entry was read with are stored too, as they change its title and icon.
+ * All operations are thread-safe.
+ */
+class ContentMetadataCache {
+public:
+    explicit ContentMetadataCache(std::string cache_path_);
+    ~ContentMetadataCache();
+
+    /// Loads the cache from disk, discarding the entries currently in memory.
+    void Load();
+
+    /// Writes the cache to disk if it has been modified since it was loaded.
+    void Save();
+
+    /// Returns the cached metadata of path, if the file has not changed since it was cached.
+    std::optional<ContentMetadata> Find(const std::string& path, u64 file_size,
+                                        s64 modification_time);
+
+    /// Adds or replaces the metadata of a file.
+    void Insert(ContentMetadata metadata);
+
+    /// Removes the entries that have not been found or inserted since the cache was loaded, such
+    /// as deleted files or files in directories that are no longer scanned.
+    void PruneUnused();
+
+private:
+    std::string cache_path;
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, ContentMetadata> entries;
+    std::unordered_set<std::string> used_paths;
+    bool is_dirty = false;
+};
+
+/**
+ * Extracts ContentMetadata from game files, skipping files that are already present in a
+ * ContentMetadataCache. Files are parsed serially, the cache is what avoids the cost of reopening
+ * unchanged files.
+ */
+class ContentScanner {
+public:
+    /// Called from the scanning thread with the metadata of each loadable file.
+    using Callback = std::function<void(const ContentMetadata& metadata)>;
+
+    /// Used to filter the files and directories visited by CollectFiles.
+    using Filter = std::function<bool(const std::string& path)>;
+
+    /// @param cache_ Optional cache to look up and store metadata in.
+    explicit ContentScanner(Core::System& system_, VirtualFilesystem vfs_,
+                            ContentMetadataCache* cache_);
+    ~ContentScanner();
+
+    /**
+     * Recursively lists the files in directory accepted by filter.
+     * @param directories_out If not null, receives every subdirectory that was traversed.
+     */
+    static std::vector<std::string> CollectFiles(const std::string& directory, u32 recursion,
+                                                 const Filter& filter,
+                                                 std::vector<std::string>* directories_out);
+
+    /**
+     * Extracts the metadata of every file in paths and invokes callback for each of them that
+     * could be loaded, in order. Returns once all the files have been processed or stop is set.
+     */
+    void Scan(const std::vector<std::string>& paths, const Callback& callback,
+              const std::atomic_bool& stop);
+
+    /// Number of files served from the cache during the last Scan.
+    std::size_t CacheHits() const {
+        return cache_hits;
+    }
+
+private:
+    /// Returns the metadata of an unsupported file at path with its current size and time.
+    static ContentMetadata MakeMetadata(const std::string& path);
+
+    /// Fills the metadata of a file from its loader.
+    static void ReadMetadata(Loader::AppLoader& loader, ContentMetadata& metadata);
+
+    /// Stores the update and language that apply to the title of metadata.
+    void ReadPatchState(ContentMetadata& metadata) const;
+
+    /// Returns true when cached metadata was read with the update and language that apply now.
+    bool IsPatchStateCurrent(const ContentMetadata& metadata) const;
+
+    Core::System& system;
+    VirtualFilesystem vfs;
+    ContentMetadataCache* cache;
+    std::size_t cache_hits = 0;
+};
+
+} // namespace FileSys
@@ -22,6 +22,7 @@
  * Refer to the license.txt file included.
  */
 
+#include <algorithm>
 #include <cstring>
 #include <string_view>
 #include "common/alignment.h"
@@ -238,6 +239,54 @@ RomFSBuildContext::RomFSBuildContext(VirtualDir base_, VirtualDir ext_)
     VisitDirectory(base, ext, root);
 }
 
+RomFSBuildContext::RomFSBuildContext(
+    const std::vector<std::string>& directory_paths,
+    const std::vector<std::pair<std::string, VirtualFile>>& file_sources) {
+    root = std::make_shared<RomFSBuildDirectoryContext>();
+    root->path = "\0";
+    directories.emplace(root->path, root);
+    num_dirs = 1;
+    dir_table_size = 0x18;
+
+    const auto find_parent = [this](std::string_view path) {
+        const auto it = directories.find(path.substr(0, path.rfind('/')));
+        ASSERT(it != directories.end());
+        return it->second;
+    };
+
+    // Parents sort before their children, so they are always added first
+    std::vector<std::string> sorted_paths = directory_paths;
+    std::sort(sorted_paths.begin(), sorted_paths.end());
+    for (const auto& path : sorted_paths) {
+        const auto parent = find_parent(path);
+        const auto child = std::make_shared<RomFSBuildDirectoryContext>();
+        child->cur_path_ofs = parent->path_len + 1;
+        child->path_len = static_cast<u32>(path.size());
+        child->path = path;
+
+        // Sanity check on path_len
+        ASSERT(child->path_len < FS_MAX_PATH);
+
+        AddDirectory(parent, child);
+    }
+
+    for (const auto& [path, source] : file_sources) {
+        const auto parent = find_parent(path);
+        const auto child = std::make_shared<RomFSBuildFileContext>();
+        child->cur_path_ofs = parent->path_len + 1;
+        child->path_len = static_cast<u32>(path.size());
+        child->path = path;
+
+        // Sanity check on path_len
+        ASSERT(child->path_len < FS_MAX_PATH);
+
+        child->source = source;
+        child->size = source->GetSize();
+
+        AddFile(parent, child);
+    }
+}
+
 RomFSBuildContext::~RomFSBuildContext() = default;
 
 std::multimap<u64, VirtualFile> RomFSBuildContext::Build() {
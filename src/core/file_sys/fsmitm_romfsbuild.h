@@ -27,6 +27,8 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 #include "common/common_types.h"
 #include "core/file_sys/vfs.h"
 
@@ -40,6 +42,9 @@ struct RomFSFileEntry;
 class RomFSBuildContext {
 public:
     explicit RomFSBuildContext(VirtualDir base, VirtualDir ext = nullptr);
+    // Builds from a resolved set of directories and files, with paths like "/dir/file".
+    RomFSBuildContext(const std::vector<std::string>& directory_paths,
+                      const std::vector<std::pair<std::string, VirtualFile>>& file_sources);
     ~RomFSBuildContext();
 
     // This finalizes the context.
@@ -0,0 +1,452 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <set>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include "common/cityhash.h"
+#include "common/common_funcs.h"
+#include "common/common_paths.h"
+#include "common/file_util.h"
+#include "common/logging/log.h"
+#include "common/swap.h"
+#include "core/file_sys/fsmitm_romfsbuild.h"
+#include "core/file_sys/ips_layer.h"
+#include "core/file_sys/layered_fs_index.h"
+#include "core/file_sys/vfs.h"
+#include "core/file_sys/vfs_concat.h"
+
+namespace FileSys {
+namespace {
+constexpr u32 INDEX_MAGIC = Common::MakeMagic('Y', 'L', 'F', 'I');
+constexpr u32 INDEX_VERSION = 1;
+constexpr u32 NO_LAYER = 0xFFFFFFFF;
+
+/// Directories modified this close to the listing may change again without a new mtime
+constexpr s64 MTIME_GRANULARITY = 2;
+constexpr s64 UNSTABLE_MTIME = -1;
+
+struct RomFSHeader {
+    u64_le header_size;
+    u64_le directory_hash_offset;
+    u64_le directory_hash_size;
+    u64_le directory_meta_offset;
+    u64_le directory_meta_size;
+    u64_le file_hash_offset;
+    u64_le file_hash_size;
+    u64_le file_meta_offset;
+    u64_le file_meta_size;
+    u64_le data_offset;
+};
+static_assert(sizeof(RomFSHeader) == 0x50, "RomFSHeader has incorrect size.");
+
+/// Paths are relative to the layer root, like "/dir/file", and the root directory is ""
+struct LayerListing {
+    std::string root;
+    std::vector<std::pair<std::string, s64>> directories;
+    std::vector<std::string> files;
+};
+
+struct ResolvedFile {
+    std::string path;
+    u32 layer{};     ///< Index of the layer providing the file, the base follows the mod layers
+    u32 ips_layer{}; ///< Index of the ext layer patching the file, or NO_LAYER
+    u64 size{};
+};
+
+struct Index {
+    u64 base_hash{};
+    std::vector<LayerListing> layers; ///< Mod layers followed by the ext layers
+    std::vector<std::string> directories;
+    std::vector<ResolvedFile> files;
+};
+
+class IndexWriter {
+public:
+    template <typename T>
+    void Write(T value) {
+        static_assert(std::is_arithmetic_v<T>);
+        const auto offset = data.size();
+        data.resize(offset + sizeof(T));
+        std::memcpy(data.data() + offset, &value, sizeof(T));
+    }
+
+    void WriteString(std::string_view value) {
+        Write(static_cast<u32>(value.size()));
+        data.insert(data.end(), value.begin(), value.end());
+    }
+
+    std::vector<u8> data;
+};
+
+class IndexReader {
+public:
+    explicit IndexReader(const std::vector<u8>& data_) : data{data_} {}
+
+    template <typename T>
+    T Read() {
+        static_assert(std::is_arithmetic_v<T>);
+        T value{};
+        if (!Check(sizeof(T))) {
+            return value;
+        }
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return value;
+    }
+
+    std::string ReadString() {
+        const auto size = Read<u32>();
+        if (!Check(size)) {
+            return {};
+        }
+        std::string value(reinterpret_cast<const char*>(data.data() + offset), size);
+        offset += size;
+        return value;
+    }
+
+    /// Reads an element count, bounded by the remaining data to reject corrupted indices
+    std::size_t ReadCount() {
+        const auto count = Read<u64>();
+        if (count > data.size() - offset) {
+            is_valid = false;
+            return 0;
+        }
+        return static_cast<std::size_t>(count);
+    }
+
+    bool IsValid() const {
+        return is_valid;
+    }
+
+private:
+    bool Check(std::size_t size) {
+        if (!is_valid || data.size() - offset < size) {
+            is_valid = false;
+            return false;
+        }
+        return true;
+    }
+
+    const std::vector<u8>& data;
+    std::size_t offset = 0;
+    bool is_valid = true;
+};
+
+s64 CurrentTime() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+/// Hashes the header and metadata tables of a RomFS, which change along with its layout
+u64 HashRomFSMetadata(const VirtualFile& romfs) {
+    RomFSHeader header{};
+    if (romfs->ReadObject(&header) != sizeof(RomFSHeader)) {
+        return 0;
+    }
+    const auto directory_meta =
+        romfs->ReadBytes(header.directory_meta_size, header.directory_meta_offset);
+    const auto file_meta = romfs->ReadBytes(header.file_meta_size, header.file_meta_offset);
+
+    u64 hash = Common::CityHash64(reinterpret_cast<const char*>(&header), sizeof(header));
+    hash = Common::CityHash64WithSeed(reinterpret_cast<const char*>(directory_meta.data()),
+                                      directory_meta.size(), hash);
+    hash = Common::CityHash64WithSeed(reinterpret_cast<const char*>(file_meta.data()),
+                                      file_meta.size(), hash);
+    return hash;
+}
+
+void ListHostDirectory(const std::string& root, const std::string& path, s64 unstable_after,
+                       LayerListing& listing) {
+    const std::string host_path = root + path;
+    const s64 mtime = Common::FS::GetModificationTime(host_path);
+    listing.directories.emplace_back(path, mtime >= unstable_after ? UNSTABLE_MTIME : mtime);
+
+    Common::FS::ForeachDirectoryEntry(
+        nullptr, host_path,
+        [&](u64*, const std::string& directory, const std::string& name) {
+            const std::string child = path + '/' + name;
+            if (Common::FS::IsDirectory(directory + DIR_SEP + name)) {
+                ListHostDirectory(root, child, unstable_after, listing);
+            } else {
+                listing.files.push_back(child);
+            }
+            return true;
+        });
+}
+
+LayerListing ListLayer(const std::string& root) {
+    LayerListing listing{.root = root, .directories = {}, .files = {}};
+    ListHostDirectory(root, "", CurrentTime() - MTIME_GRANULARITY, listing);
+    return listing;
+}
+
+bool IsLayerUnchanged(const LayerListing& listing) {
+    return std::all_of(listing.directories.begin(), listing.directories.end(),
+                       [&listing](const auto& directory) {
+                           const std::string host_path = listing.root + directory.first;
+                           return directory.second != UNSTABLE_MTIME &&
+                                  Common::FS::IsDirectory(host_path) &&
+                                  Common::FS::GetModificationTime(host_path) == directory.second;
+                       });
+}
+
+void ListVirtualDirectory(const VirtualDir& dir, const std::string& path, LayerListing& listing) {
+    listing.directories.emplace_back(path, 0);
+    for (const auto& file : dir->GetFiles()) {
+        listing.files.push_back(path + '/' + file->GetName());
+    }
+    for (const auto& subdir : dir->GetSubdirectories()) {
+        ListVirtualDirectory(subdir, path + '/' + subdir->GetName(), listing);
+    }
+}
+
+/// Resolves the RomFS contents the same way as walking the layered directories would
+void Resolve(Index& index, std::size_t num_layers, const LayerListing& base) {
+    std::set<std::string, std::less<>> all_directories;
+    std::map<std::string, u32, std::less<>> file_layers;
+    const auto add_layer = [&](const LayerListing& listing, u32 layer) {
+        for (const auto& directory : listing.directories) {
+            all_directories.insert(directory.first);
+        }
+        for (const auto& file : listing.files) {
+            file_layers.emplace(file, layer);
+        }
+    };
+    for (std::size_t layer = 0; layer < num_layers; ++layer) {
+        add_layer(index.layers[layer], static_cast<u32>(layer));
+    }
+    add_layer(base, static_cast<u32>(num_layers));
+
+    std::unordered_set<std::string> ext_files;
+    std::map<std::string, u32, std::less<>> ips_layers;
+    for (std::size_t layer = num_layers; layer < index.layers.size(); ++layer) {
+        for (const auto& file : index.layers[layer].files) {
+            ext_files.insert(file);
+            if (file.ends_with(".ips")) {
+                ips_layers.emplace(file.substr(0, file.size() - 4),
+                                   static_cast<u32>(layer - num_layers));
+            }
+        }
+    }
+    const auto is_included = [&](const std::string& path,
+                                 const std::unordered_set<std::string>& directories) {
+        const std::string parent = path.substr(0, path.rfind('/'));
+        return directories.contains(parent) && !ext_files.contains(path + ".stub");
+    };
+
+    // Directories sort before their children, so parents are decided first
+    std::unordered_set<std::string> included_directories{""};
+    index.directories.clear();
+    for (const auto& path : all_directories) {
+        if (!path.empty() && is_included(path, included_directories)) {
+            included_directories.insert(path);
+            index.directories.push_back(path);
+        }
+    }
+
+    // Directories take precedence over files with the same path in another layer
+    index.files.clear();
+    for (const auto& [path, layer] : file_layers) {
+        if (all_directories.contains(path) || !is_included(path, included_directories)) {
+            continue;
+        }
+        const auto ips = ips_layers.find(path);
+        index.files.push_back({
+            .path = path,
+            .layer = layer,
+            .ips_layer = ips != ips_layers.end() ? ips->second : NO_LAYER,
+        });
+    }
+}
+
+/// Opens the sources of the resolved files and builds the RomFS, nullptr if a file changed size
+VirtualFile BuildRomFS(Index& index, const VirtualDir& base, const std::vector<VirtualDir>& layers,
+                       const std::vector<VirtualDir>& ext_layers, bool validate_sizes) {
+    std::vector<std::pair<std::string, VirtualFile>> sources;
+    sources.reserve(index.files.size());
+    for (ResolvedFile& file : index.files) {
+        const VirtualDir& layer = file.layer < layers.size() ? layers[file.layer] : base;
+        VirtualFile source = layer->GetFileRelative(file.path);
+        if (source == nullptr) {
+            return nullptr;
+        }
+        if (file.ips_layer != NO_LAYER) {
+            const auto ips = ext_layers[file.ips_layer]->GetFileRelative(file.path + ".ips");
+            if (ips != nullptr) {
+                if (auto patched = PatchIPS(source, ips); patched != nullptr) {
+                    source = std::move(patched);
+                }
+            }
+        }
+        const u64 size = source->GetSize();
+        if (validate_sizes && size != file.size) {
+            return nullptr;
+        }
+        file.size = size;
+        sources.emplace_back(file.path, std::move(source));
+    }
+
+    RomFSBuildContext ctx{index.directories, sources};
+    return ConcatenatedVfsFile::MakeConcatenatedFile(0, ctx.Build(), base->GetName());
+}
+
+std::optional<Index> LoadIndex(const std::string& path) {
+    if (!Common::FS::Exists(path)) {
+        return std::nullopt;
+    }
+    Common::FS::IOFile file(path, "rb");
+    std::vector<u8> data(file.GetSize());
+    if (!file.IsOpen() || file.ReadBytes(data.data(), data.size()) != data.size()) {
+        return std::nullopt;
+    }
+
+    IndexReader reader{data};
+    if (reader.Read<u32>() != INDEX_MAGIC || reader.Read<u32>() != INDEX_VERSION) {
+        return std::nullopt;
+    }
+    Index index;
+    index.base_hash = reader.Read<u64>();
+    index.layers.resize(reader.ReadCount());
+    for (LayerListing& layer : index.layers) {
+        layer.root = reader.ReadString();
+        layer.directories.resize(reader.ReadCount());
+        for (auto& [directory, mtime] : layer.directories) {
+            directory = reader.ReadString();
+            mtime = reader.Read<s64>();
+        }
+        layer.files.resize(reader.ReadCount());
+        for (std::string& file : layer.files) {
+            file = reader.ReadString();
+        }
+    }
+    index.directories.resize(reader.ReadCount());
+    for (std::string& directory : index.directories) {
+        directory = reader.ReadString();
+    }
+    index.files.resize(reader.ReadCount());
+    for (ResolvedFile& file : index.files) {
+        file.path = reader.ReadString();
+        file.layer = reader.Read<u32>();
+        file.ips_layer = reader.Read<u32>();
+        file.size = reader.Read<u64>();
+    }
+    if (!reader.IsValid()) {
+        LOG_WARNING(Loader, "Invalid LayeredFS index in path={}", path);
+        return std::nullopt;
+    }
+    return index;
+}
+
+void SaveIndex(const std::string& path, const Index& index) {
+    IndexWriter writer;
+    writer.Write(INDEX_MAGIC);
+    writer.Write(INDEX_VERSION);
+    writer.Write(index.base_hash);
+    writer.Write(static_cast<u64>(index.layers.size()));
+    for (const LayerListing& layer : index.layers) {
+        writer.WriteString(layer.root);
+        writer.Write(static_cast<u64>(layer.directories.size()));
+        for (const auto& [directory, mtime] : layer.directories) {
+            writer.WriteString(directory);
+            writer.Write(mtime);
+        }
+        writer.Write(static_cast<u64>(layer.files.size()));
+        for (const std::string& file : layer.files) {
+            writer.WriteString(file);
+        }
+    }
+    writer.Write(static_cast<u64>(index.directories.size()));
+    for (const std::string& directory : index.directories) {
+        writer.WriteString(directory);
+    }
+    writer.Write(static_cast<u64>(index.files.size()));
+    for (const ResolvedFile& file : index.files) {
+        writer.WriteString(file.path);
+        writer.Write(file.layer);
+        writer.Write(file.ips_layer);
+        writer.Write(file.size);
+    }
+
+    if (!Common::FS::CreateFullPath(path)) {
+        LOG_ERROR(Loader, "Failed to create LayeredFS index directory for path={}", path);
+        return;
+    }
+    Common::FS::IOFile file(path, "wb");
+    if (!file.IsOpen() ||
+        file.WriteBytes(writer.data.data(), writer.data.size()) != writer.data.size()) {
+        LOG_ERROR(Loader, "Failed to write LayeredFS index in path={}", path);
+    }
+}
+} // Anonymous namespace
+
+VirtualFile CreateLayeredRomFS(const VirtualFile& romfs, const VirtualDir& base,
+                               const std::vector<VirtualDir>& layers,
+                               const std::vector<VirtualDir>& ext_layers,
+                               const std::string& index_path,
+                               LayeredFSIndexStatistics* statistics) {
+    std::vector<std::string> roots;
+    roots.reserve(layers.size() + ext_layers.size());
+    for (const auto* layer_list : {&layers, &ext_layers}) {
+        for (const VirtualDir& layer : *layer_list) {
+            std::string root = layer->GetFullPath();
+            if (!Common::FS::IsDirectory(root)) {
+                return nullptr;
+            }
+            roots.push_back(std::move(root));
+        }
+    }
+
+    LayeredFSIndexStatistics stats{.num_layers = roots.size()};
+    std::optional<Index> previous = LoadIndex(index_path);
+    Index index;
+    index.base_hash = HashRomFSMetadata(romfs);
+
+    bool is_unchanged = previous && previous->base_hash == index.base_hash &&
+                        previous->layers.size() == roots.size();
+    for (std::size_t i = 0; i < roots.size(); ++i) {
+        if (previous && i < previous->layers.size() && previous->layers[i].root == roots[i] &&
+            IsLayerUnchanged(previous->layers[i])) {
+            index.layers.push_back(std::move(previous->layers[i]));
+            continue;
+        }
+        index.layers.push_back(ListLayer(roots[i]));
+        ++stats.num_listed_layers;
+        is_unchanged = false;
+    }
+
+    VirtualFile packed;
+    if (is_unchanged) {
+        // The previous layout is still valid as long as no file changed in size
+        index.directories = std::move(previous->directories);
+        index.files = std::move(previous->files);
+        packed = BuildRomFS(index, base, layers, ext_layers, true);
+        stats.is_warm = packed != nullptr;
+    }
+    if (packed == nullptr) {
+        LayerListing base_listing;
+        ListVirtualDirectory(base, "", base_listing);
+        Resolve(index, layers.size(), base_listing);
+        packed = BuildRomFS(index, base, layers, ext_layers, false);
+        if (packed != nullptr) {
+            SaveIndex(index_path, index);
+        }
+    }
+
+    stats.num_files = index.files.size();
+    if (statistics != nullptr) {
+        *statistics = stats;
+    }
+    return packed;
+}
+
+} // namespace FileSys
@@ -0,0 +1,47 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "common/common_types.h"
+#include "core/file_sys/vfs_types.h"
+
+namespace FileSys {
+
+struct LayeredFSIndexStatistics {
+    /// Whether the resolved layout of the previous boot was reused as is
+    bool is_warm = false;
+    /// Mod layers listed from the host filesystem, the rest were taken from the index
+    std::size_t num_listed_layers = 0;
+    std::size_t num_layers = 0;
+    std::size_t num_files = 0;
+};
+
+/**
+ * Builds a RomFS with LayeredFS mods applied, persisting the result in an index file so later
+ * boots avoid walking the base RomFS and every mod directory.
+ *
+ * The index records the listing of each mod layer along with the modification times of its
+ * directories, and the files resolved from all layers. A layer is listed again only when one of
+ * its directories changed, and the resolved files are reused when no layer changed and the base
+ * RomFS metadata is the same.
+ *
+ * @param romfs      Base RomFS.
+ * @param base       Extracted base RomFS.
+ * @param layers     Mod directories to layer over the base, highest priority first.
+ * @param ext_layers Directories with .stub and .ips files, highest priority first.
+ * @param index_path Host path of the index file.
+ * @param statistics Optional output of how the RomFS was built.
+ *
+ * @return The built RomFS, or nullptr when a layer is not a host directory.
+ */
+VirtualFile CreateLayeredRomFS(const VirtualFile& romfs, const VirtualDir& base,
+                               const std::vector<VirtualDir>& layers,
+                               const std::vector<VirtualDir>& ext_layers,
+                               const std::string& index_path,
+                               LayeredFSIndexStatistics* statistics = nullptr);
+
+} // namespace FileSys
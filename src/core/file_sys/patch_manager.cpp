@@ -4,9 +4,12 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstring>
 
+#include "common/cityhash.h"
+#include "common/common_paths.h"
 #include "common/file_util.h"
 #include "common/hex_util.h"
 #include "common/logging/log.h"
@@ -16,6 +19,7 @@
 #include "core/file_sys/content_archive.h"
 #include "core/file_sys/control_metadata.h"
 #include "core/file_sys/ips_layer.h"
+#include "core/file_sys/layered_fs_index.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/file_sys/registered_cache.h"
 #include "core/file_sys/romfs.h"
@@ -308,6 +312,30 @@ bool PatchManager::HasNSOPatch(const BuildID& build_id_) const {
     return !CollectPatches(patch_dirs, build_id).empty();
 }
 
+u64 PatchManager::GetNSOPatchHash(const BuildID& build_id_) const {
+    const auto build_id_raw = Common::HexToString(build_id_);
+    const auto build_id = build_id_raw.substr(0, build_id_raw.find_last_not_of('0') + 1);
+
+    const auto load_dir = fs_controller.GetModificationLoadRoot(title_id);
+    if (load_dir == nullptr) {
+        return 0;
+    }
+
+    auto patch_dirs = load_dir->GetSubdirectories();
+    std::sort(patch_dirs.begin(), patch_dirs.end(),
+              [](const VirtualDir& l, const VirtualDir& r) { return l->GetName() < r->GetName(); });
+
+    u64 hash = 0;
+    for (const auto& patch_file : CollectPatches(patch_dirs, build_id)) {
+        const auto name = patch_file->GetName();
+        const auto data = patch_file->ReadAllBytes();
+        hash = Common::CityHash64WithSeed(name.data(), name.size(), hash);
+        hash = Common::CityHash64WithSeed(reinterpret_cast<const char*>(data.data()), data.size(),
+                                          hash);
+    }
+    return hash;
+}
+
 std::vector<Core::Memory::CheatEntry> PatchManager::CreateCheatList(
     const BuildID& build_id_) const {
     const auto load_dir = fs_controller.GetModificationLoadRoot(title_id);
@@ -384,6 +412,25 @@ static void ApplyLayeredFS(VirtualFile& romfs, u64 title_id, ContentRecordType t
         return;
     }
 
+    const auto start_time = std::chrono::steady_clock::now();
+    const auto index_path = fmt::format("{}{}layeredfs{}{:016X}_{}.bin",
+                                        Common::FS::GetUserPath(Common::FS::UserPath::CacheDir),
+                                        DIR_SEP, DIR_SEP, title_id, static_cast<u32>(type));
+    LayeredFSIndexStatistics statistics;
+    auto indexed =
+        CreateLayeredRomFS(romfs, extracted, layers, layers_ext, index_path, &statistics);
+    if (indexed != nullptr) {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_time);
+        LOG_INFO(Loader,
+                 "    RomFS: LayeredFS patches applied successfully, {} build of {} files in {} ms "
+                 "({} of {} layers listed)",
+                 statistics.is_warm ? "warm" : "cold", statistics.num_files, elapsed.count(),
+                 statistics.num_listed_layers, statistics.num_layers);
+        romfs = std::move(indexed);
+        return;
+    }
+
     layers.push_back(std::move(extracted));
 
     auto layered = LayeredVfsDirectory::MakeLayeredDirectory(std::move(layers));
@@ -55,6 +55,10 @@ public:
     // Used to prevent expensive copies in NSO loader.
     [[nodiscard]] bool HasNSOPatch(const BuildID& build_id) const;
 
+    // Hashes the contents of the patches PatchNSO() would apply to the NSO with the given build
+    // ID. Returns zero if there are none.
+    [[nodiscard]] u64 GetNSOPatchHash(const BuildID& build_id) const;
+
     // Creates a CheatList object with all
     [[nodiscard]] std::vector<Core::Memory::CheatEntry> CreateCheatList(
         const BuildID& build_id) const;
@@ -17,6 +17,7 @@
 #include "core/file_sys/registered_cache.h"
 #include "core/file_sys/submission_package.h"
 #include "core/file_sys/vfs_concat.h"
+#include "core/file_sys/vfs_streaming_copy.h"
 #include "core/loader/loader.h"
 
 namespace FileSys {
@@ -24,6 +25,11 @@ namespace FileSys {
 // The size of blocks to use when vfs raw copying into nand.
 constexpr size_t VFS_RC_LARGE_COPY_BLOCK = 0x400000;
 
+bool VfsInstallCopy(const VirtualFile& src, const VirtualFile& dest, size_t block_size,
+                    Core::Crypto::SHA256Hash* hash) {
+    return VfsStreamingCopy(src, dest, {.chunk_size = block_size, .hash = hash});
+}
+
 std::string ContentProviderEntry::DebugInfo() const {
     return fmt::format("title_id={:016X}, content_type={:02X}", title_id, static_cast<u8>(type));
 }
@@ -200,7 +206,7 @@ bool PlaceholderCache::Register(RegisteredCache* cache, const NcaID& placeholder
     if (file == nullptr)
         return false;
 
-    const auto res = cache->RawInstallNCA(NCA{file}, &VfsRawCopy, false, install);
+    const auto res = cache->RawInstallNCA(NCA{file}, &VfsInstallCopy, false, install);
 
     if (res != InstallResult::Success)
         return false;
@@ -606,7 +612,8 @@ InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_ex
         if (nca == nullptr) {
             return InstallResult::ErrorCopyFailed;
         }
-        const auto res2 = RawInstallNCA(*nca, copy, overwrite_if_exists, record.nca_id);
+        const auto res2 =
+            RawInstallNCA(*nca, copy, overwrite_if_exists, record.nca_id, record.hash);
         if (res2 != InstallResult::Success) {
             return res2;
         }
@@ -698,9 +705,9 @@ bool RegisteredCache::RemoveExistingEntry(u64 title_id) const {
     return false;
 }
 
-InstallResult RegisteredCache::RawInstallNCA(const NCA& nca, const VfsCopyFunction& copy,
-                                             bool overwrite_if_exists,
-                                             std::optional<NcaID> override_id) {
+InstallResult RegisteredCache::RawInstallNCA(
+    const NCA& nca, const VfsCopyFunction& copy, bool overwrite_if_exists,
+    std::optional<NcaID> override_id, std::optional<Core::Crypto::SHA256Hash> expected_hash) {
     const auto in = nca.GetBaseFile();
     Core::Crypto::SHA256Hash hash{};
 
@@ -735,8 +742,23 @@ InstallResult RegisteredCache::RawInstallNCA(const NCA& nca, const VfsCopyFuncti
     if (out == nullptr) {
         return InstallResult::ErrorCopyFailed;
     }
-    return copy(in, out, VFS_RC_LARGE_COPY_BLOCK) ? InstallResult::Success
-                                                  : InstallResult::ErrorCopyFailed;
+
+    // The full hash comes for free while streaming, so verify it whenever the CNMT provides one.
+    Core::Crypto::SHA256Hash content_hash{};
+    if (!copy(in, out, VFS_RC_LARGE_COPY_BLOCK, expected_hash ? &content_hash : nullptr)) {
+        return InstallResult::ErrorCopyFailed;
+    }
+
+    if (expected_hash && content_hash != *expected_hash) {
+        LOG_ERROR(Loader, "Hash mismatch for NCA {}, expected {} but got {}. Removing it...",
+                  Common::HexToString(id, false), Common::HexToString(*expected_hash),
+                  Common::HexToString(content_hash));
+        const auto c_dir = out->GetContainingDirectory();
+        out.reset();
+        c_dir->DeleteFile(Common::FS::GetFilename(path));
+        return InstallResult::ErrorHashMismatch;
+    }
+    return InstallResult::Success;
 }
 
 bool RegisteredCache::RawInstallYuzuMeta(const CNMT& cnmt) {
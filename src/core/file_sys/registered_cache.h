@@ -30,7 +30,9 @@ class RegisteredCache;
 
 using NcaID = std::array<u8, 0x10>;
 using ContentProviderParsingFunction = std::function<VirtualFile(const VirtualFile&, const NcaID&)>;
-using VfsCopyFunction = std::function<bool(const VirtualFile&, const VirtualFile&, size_t)>;
+// Copies src to dest. If hash is not null, it receives the SHA-256 of the copied data.
+using VfsCopyFunction = std::function<bool(const VirtualFile& src, const VirtualFile& dest,
+                                           size_t block_size, Core::Crypto::SHA256Hash* hash)>;
 
 enum class InstallResult {
     Success,
@@ -38,8 +40,13 @@ enum class InstallResult {
     ErrorAlreadyExists,
     ErrorCopyFailed,
     ErrorMetaFailed,
+    ErrorHashMismatch,
 };
 
+// Default VfsCopyFunction, streams the copy through VfsStreamingCopy.
+bool VfsInstallCopy(const VirtualFile& src, const VirtualFile& dest, size_t block_size,
+                    Core::Crypto::SHA256Hash* hash);
+
 struct ContentProviderEntry {
     u64 title_id;
     ContentRecordType type;
@@ -156,18 +163,19 @@ public:
         std::optional<u64> title_id = {}) const override;
 
     // Raw copies all the ncas from the xci/nsp to the csache. Does some quick checks to make sure
-    // there is a meta NCA and all of them are accessible.
+    // there is a meta NCA and all of them are accessible. Each NCA is hashed while it is copied and
+    // verified against the hash recorded in the CNMT.
     InstallResult InstallEntry(const XCI& xci, bool overwrite_if_exists = false,
-                               const VfsCopyFunction& copy = &VfsRawCopy);
+                               const VfsCopyFunction& copy = &VfsInstallCopy);
     InstallResult InstallEntry(const NSP& nsp, bool overwrite_if_exists = false,
-                               const VfsCopyFunction& copy = &VfsRawCopy);
+                               const VfsCopyFunction& copy = &VfsInstallCopy);
 
     // Due to the fact that we must use Meta-type NCAs to determine the existance of files, this
     // poses quite a challenge. Instead of creating a new meta NCA for this file, yuzu will create a
     // dir inside the NAND called 'yuzu_meta' and store the raw CNMT there.
     // TODO(DarkLordZach): Author real meta-type NCAs and install those.
     InstallResult InstallEntry(const NCA& nca, TitleType type, bool overwrite_if_exists = false,
-                               const VfsCopyFunction& copy = &VfsRawCopy);
+                               const VfsCopyFunction& copy = &VfsInstallCopy);
 
     // Removes an existing entry based on title id
     bool RemoveExistingEntry(u64 title_id) const;
@@ -184,7 +192,8 @@ private:
     VirtualFile GetFileAtID(NcaID id) const;
     VirtualFile OpenFileOrDirectoryConcat(const VirtualDir& dir, std::string_view path) const;
     InstallResult RawInstallNCA(const NCA& nca, const VfsCopyFunction& copy,
-                                bool overwrite_if_exists, std::optional<NcaID> override_id = {});
+                                bool overwrite_if_exists, std::optional<NcaID> override_id = {},
+                                std::optional<Core::Crypto::SHA256Hash> expected_hash = {});
     bool RawInstallYuzuMeta(const CNMT& cnmt);
 
     VirtualDir dir;
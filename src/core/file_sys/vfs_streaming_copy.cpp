@@ -0,0 +1,199 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "common/div_ceil.h"
+#include "common/logging/log.h"
+#include "common/thread.h"
+#include "core/crypto/sha256.h"
+#include "core/file_sys/vfs.h"
+#include "core/file_sys/vfs_streaming_copy.h"
+
+namespace FileSys {
+
+namespace {
+
+/**
+ * Tracks the progress of the reader, hasher and writer stages over a ring of chunk buffers.
+ * Chunk i lives in buffer i % num_buffers, which can only be reused once both the hasher and the
+ * writer are done with the chunk that previously occupied it.
+ */
+class CopyPipeline {
+public:
+    explicit CopyPipeline(std::size_t num_buffers_, bool has_hasher)
+        : num_buffers{num_buffers_},
+          chunks_hashed{has_hasher ? 0 : std::numeric_limits<std::size_t>::max()} {}
+
+    /// Waits until the buffer for chunk can be filled. Returns false if the copy was aborted.
+    bool WaitForFreeBuffer(std::size_t chunk) {
+        std::unique_lock lock{mutex};
+        condition.wait(lock, [&] {
+            return aborted || std::min(chunks_hashed, chunks_written) + num_buffers > chunk;
+        });
+        return !aborted;
+    }
+
+    /// Waits until chunk has been read. Returns false if the copy was aborted.
+    bool WaitForRead(std::size_t chunk) {
+        std::unique_lock lock{mutex};
+        condition.wait(lock, [&] { return aborted || chunks_read > chunk; });
+        return !aborted;
+    }
+
+    void MarkRead() {
+        Signal([this] { ++chunks_read; });
+    }
+
+    void MarkHashed() {
+        Signal([this] { ++chunks_hashed; });
+    }
+
+    void MarkWritten() {
+        Signal([this] { ++chunks_written; });
+    }
+
+    void Abort() {
+        Signal([this] { aborted = true; });
+    }
+
+    bool IsAborted() {
+        std::scoped_lock lock{mutex};
+        return aborted;
+    }
+
+private:
+    template <typename Func>
+    void Signal(Func&& func) {
+        {
+            std::scoped_lock lock{mutex};
+            func();
+        }
+        condition.notify_all();
+    }
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::size_t num_buffers;
+    std::size_t chunks_read = 0;
+    std::size_t chunks_hashed;
+    std::size_t chunks_written = 0;
+    bool aborted = false;
+};
+
+} // Anonymous namespace
+
+bool VfsStreamingCopy(const VirtualFile& src, const VirtualFile& dest,
+                      const StreamingCopyParameters& parameters) {
+    if (src == nullptr || dest == nullptr || !src->IsReadable() || !dest->IsWritable()) {
+        return false;
+    }
+
+    const std::size_t size = src->GetSize();
+    if (!dest->Resize(size)) {
+        return false;
+    }
+
+    const auto start_time = std::chrono::steady_clock::now();
+    const std::size_t chunk_size = std::max<std::size_t>(parameters.chunk_size, 1);
+    const std::size_t num_chunks = Common::DivCeil(size, chunk_size);
+    const std::size_t num_buffers =
+        std::clamp<std::size_t>(parameters.max_chunks, 1, std::max<std::size_t>(num_chunks, 1));
+
+    std::vector<std::vector<u8>> buffers(num_buffers);
+    for (auto& buffer : buffers) {
+        buffer.resize(std::min(chunk_size, size));
+    }
+
+    const auto chunk_span = [&](std::size_t chunk) {
+        const std::size_t offset = chunk * chunk_size;
+        return std::span<u8>(buffers[chunk % num_buffers])
+            .first(std::min(chunk_size, size - offset));
+    };
+
+    CopyPipeline pipeline{num_buffers, parameters.hash != nullptr};
+
+    std::thread reader{[&] {
+        Common::SetCurrentThreadName("yuzu:StreamingCopyReader");
+        for (std::size_t chunk = 0; chunk < num_chunks; ++chunk) {
+            if (!pipeline.WaitForFreeBuffer(chunk)) {
+                return;
+            }
+            const auto data = chunk_span(chunk);
+            if (src->Read(data.data(), data.size(), chunk * chunk_size) != data.size()) {
+                LOG_ERROR(Loader, "Failed to read chunk {} of {}", chunk, src->GetName());
+                pipeline.Abort();
+                return;
+            }
+            pipeline.MarkRead();
+        }
+    }};
+
+    std::thread hasher;
+    if (parameters.hash != nullptr) {
+        hasher = std::thread{[&] {
+            Common::SetCurrentThreadName("yuzu:StreamingCopyHasher");
+            Core::Crypto::SHA256Hasher sha;
+            for (std::size_t chunk = 0; chunk < num_chunks; ++chunk) {
+                if (!pipeline.WaitForRead(chunk)) {
+                    return;
+                }
+                sha.Update(chunk_span(chunk));
+                pipeline.MarkHashed();
+            }
+            *parameters.hash = sha.Finish();
+        }};
+    }
+
+    for (std::size_t chunk = 0; chunk < num_chunks; ++chunk) {
+        if (!pipeline.WaitForRead(chunk)) {
+            break;
+        }
+        const auto data = chunk_span(chunk);
+        if (dest->Write(data.data(), data.size(), chunk * chunk_size) != data.size()) {
+            LOG_ERROR(Loader, "Failed to write chunk {} of {}", chunk, dest->GetName());
+            pipeline.Abort();
+            break;
+        }
+        pipeline.MarkWritten();
+
+        if (parameters.progress && !parameters.progress(data.size())) {
+            pipeline.Abort();
+            break;
+        }
+    }
+
+    reader.join();
+    if (hasher.joinable()) {
+        hasher.join();
+    }
+
+    if (pipeline.IsAborted()) {
+        return false;
+    }
+
+    const StreamingCopyStatistics statistics{
+        .bytes_copied = size,
+        .elapsed = std::chrono::steady_clock::now() - start_time,
+    };
+    LOG_INFO(Loader, "Copied {} ({} bytes) in {} ms, {:.2f} MB/s{}", src->GetName(), size,
+             std::chrono::duration_cast<std::chrono::milliseconds>(statistics.elapsed).count(),
+             statistics.MegabytesPerSecond(),
+             parameters.hash == nullptr
+                 ? ""
+                 : (Core::Crypto::SHA256Hasher::IsAccelerated() ? ", hashed with SHA extensions"
+                                                                : ", hashed"));
+    if (parameters.statistics != nullptr) {
+        *parameters.statistics = statistics;
+    }
+    return true;
+}
+
+} // namespace FileSys
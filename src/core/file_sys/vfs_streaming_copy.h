@@ -0,0 +1,52 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <functional>
+#include "common/common_types.h"
+#include "core/file_sys/vfs_types.h"
+
+namespace FileSys {
+
+/// Throughput of a finished VfsStreamingCopy.
+struct StreamingCopyStatistics {
+    u64 bytes_copied{};
+    std::chrono::nanoseconds elapsed{};
+
+    double MegabytesPerSecond() const {
+        const double seconds = std::chrono::duration<double>(elapsed).count();
+        return seconds > 0.0 ? static_cast<double>(bytes_copied) / (1024.0 * 1024.0) / seconds
+                             : 0.0;
+    }
+};
+
+struct StreamingCopyParameters {
+    /// Size of each chunk read from the source.
+    std::size_t chunk_size = 0x400000;
+
+    /// Maximum number of chunks in flight. Memory usage is bounded by chunk_size * max_chunks.
+    std::size_t max_chunks = 4;
+
+    /// If not null, receives the SHA-256 of the copied data.
+    std::array<u8, 0x20>* hash = nullptr;
+
+    /// If not null, receives the throughput of the copy.
+    StreamingCopyStatistics* statistics = nullptr;
+
+    /// Called on the calling thread with the number of bytes written after each chunk.
+    /// Returning false cancels the copy.
+    std::function<bool(std::size_t bytes_written)> progress;
+};
+
+/**
+ * Copies src into dest in chunks, reading, hashing and writing concurrently on separate threads.
+ * @returns true if the whole file was copied, false on error or cancellation.
+ */
+bool VfsStreamingCopy(const VirtualFile& src, const VirtualFile& dest,
+                      const StreamingCopyParameters& parameters = {});
+
+} // namespace FileSys
@@ -272,6 +272,17 @@ std::vector<u8> HLERequestContext::ReadBuffer(std::size_t buffer_index) const {
     return buffer;
 }
 
+std::size_t HLERequestContext::ReadBufferInto(std::span<u8> buffer,
+                                              std::size_t buffer_index) const {
+    const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
+                           BufferDescriptorA()[buffer_index].Size()};
+    ASSERT_OR_EXECUTE_MSG(
+        is_buffer_a || BufferDescriptorX().size() > buffer_index, { return 0; },
+        "BufferDescriptorX invalid buffer_index {}", buffer_index);
+    return ReadDescriptorBuffer(memory, BufferDescriptorA(), BufferDescriptorX(), buffer,
+                                buffer_index);
+}
+
 std::size_t HLERequestContext::WriteBuffer(const void* buffer, std::size_t size,
                                            std::size_t buffer_index) const {
     if (size == 0) {
@@ -4,10 +4,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -175,6 +177,40 @@ public:
     /// Helper function to read a buffer using the appropriate buffer descriptor
     std::vector<u8> ReadBuffer(std::size_t buffer_index = 0) const;
 
+    /**
+     * Helper function to read a buffer into caller-provided storage, avoiding an allocation.
+     * At most buffer.size() bytes are read.
+     * @returns The number of bytes read.
+     */
+    std::size_t ReadBufferInto(std::span<u8> buffer, std::size_t buffer_index = 0) const;
+
+    /**
+     * Reads the buffer at buffer_index into caller-provided storage, from the A descriptors when
+     * the buffer is present there and from the X descriptors otherwise. Buffers larger than the
+     * storage are truncated.
+     * @returns The number of bytes read, zero when there is no such buffer.
+     */
+    template <typename MemoryType>
+    static std::size_t ReadDescriptorBuffer(MemoryType& memory,
+                                            std::span<const IPC::BufferDescriptorABW> buffers_a,
+                                            std::span<const IPC::BufferDescriptorX> buffers_x,
+                                            std::span<u8> buffer, std::size_t buffer_index) {
+        VAddr address{};
+        u64 size{};
+        if (buffers_a.size() > buffer_index && buffers_a[buffer_index].Size() != 0) {
+            address = buffers_a[buffer_index].Address();
+            size = buffers_a[buffer_index].Size();
+        } else if (buffers_x.size() > buffer_index) {
+            address = buffers_x[buffer_index].Address();
+            size = buffers_x[buffer_index].Size();
+        } else {
+            return 0;
+        }
+        const std::size_t read_size = std::min<std::size_t>(buffer.size(), size);
+        memory.ReadBlock(address, buffer.data(), read_size);
+        return read_size;
+    }
+
     /// Helper function to write a buffer using the appropriate buffer descriptor
     std::size_t WriteBuffer(const void* buffer, std::size_t size,
                             std::size_t buffer_index = 0) const;
@@ -9,6 +9,7 @@
 #include "common/bit_util.h"
 #include "common/fiber.h"
 #include "common/logging/log.h"
+#include "common/microprofile.h"
 #include "core/arm/arm_interface.h"
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -21,6 +22,9 @@
 #include "core/hle/kernel/thread.h"
 #include "core/hle/kernel/time_manager.h"
 
+MICROPROFILE_DEFINE(Kernel_SchedulerLockWait, "Kernel", "Scheduler Lock Wait",
+                    MP_RGB(200, 70, 70));
+
 namespace Kernel {
 
 static void IncrementScheduledCount(Kernel::Thread* thread) {
@@ -685,6 +689,7 @@ void KScheduler::ScheduleImpl() {
     Process* const previous_process = system.Kernel().CurrentProcess();
 
     UpdateLastContextSwitchTime(previous_thread, previous_process);
+    num_context_switches.fetch_add(1, std::memory_order_relaxed);
 
     // Save context for previous thread
     Unload(previous_thread);
@@ -748,7 +753,10 @@ void KScheduler::UpdateLastContextSwitchTime(Thread* thread, Process* process) {
     const u64 update_ticks = most_recent_switch_ticks - prev_switch_ticks;
 
     if (thread != nullptr) {
-        thread->UpdateCPUTimeTicks(update_ticks);
+        thread->UpdateCPUTimeTicks(update_ticks, core_id);
+    }
+    if (thread == nullptr || thread->IsIdleThread()) {
+        idle_ticks.fetch_add(update_ticks, std::memory_order_relaxed);
     }
 
     if (process != nullptr) {
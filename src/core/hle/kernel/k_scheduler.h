@@ -56,6 +56,16 @@ public:
     /// Gets the timestamp for the last context switch in ticks.
     [[nodiscard]] u64 GetLastContextSwitchTicks() const;
 
+    /// Gets the number of context switches performed on this core.
+    [[nodiscard]] u64 GetNumContextSwitches() const {
+        return num_context_switches.load(std::memory_order_relaxed);
+    }
+
+    /// Gets the CPU ticks this core spent without a thread to run.
+    [[nodiscard]] u64 GetIdleTicks() const {
+        return idle_ticks.load(std::memory_order_relaxed);
+    }
+
     [[nodiscard]] bool ContextSwitchPending() const {
         return state.needs_scheduling.load(std::memory_order_relaxed);
     }
@@ -188,6 +198,9 @@ private:
     u64 last_context_switch_time{};
     const std::size_t core_id;
 
+    std::atomic<u64> num_context_switches{};
+    std::atomic<u64> idle_ticks{};
+
     Common::SpinLock guard{};
 };
 
@@ -7,15 +7,30 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+
 #include "common/assert.h"
+#include "common/microprofile.h"
 #include "common/spin_lock.h"
 #include "core/hardware_properties.h"
 #include "core/hle/kernel/kernel.h"
 
+MICROPROFILE_DECLARE(Kernel_SchedulerLockWait);
+
 namespace Kernel {
 
 class KernelCore;
 
+/// Contention counters of a scheduler lock, in host time. Recursive acquisitions aren't counted.
+struct KSchedulerLockStatistics {
+    u64 num_acquisitions{}; ///< Times the lock was acquired
+    u64 num_contended{};    ///< Acquisitions that had to wait for another host thread
+    u64 wait_ns{};          ///< Time spent spinning on the lock
+    u64 hold_ns{};          ///< Time the lock was held
+    u64 max_hold_ns{};      ///< Longest time the lock was held at once
+};
+
 template <typename SchedulerType>
 class KAbstractSchedulerLock {
 public:
@@ -33,7 +48,15 @@ public:
         } else {
             // Otherwise, we want to disable scheduling and acquire the spinlock.
             SchedulerType::DisableScheduling(kernel);
-            this->spin_lock.lock();
+            if (!this->spin_lock.try_lock()) {
+                MICROPROFILE_SCOPE(Kernel_SchedulerLockWait);
+                const auto wait_start = Clock::now();
+                this->spin_lock.lock();
+                this->wait_ns.fetch_add(ElapsedNs(wait_start), std::memory_order_relaxed);
+                this->num_contended.fetch_add(1, std::memory_order_relaxed);
+            }
+            this->num_acquisitions.fetch_add(1, std::memory_order_relaxed);
+            this->hold_start = Clock::now();
 
             // For debug, ensure that our state is valid.
             ASSERT(this->lock_count == 0);
@@ -56,6 +79,13 @@ public:
                 SchedulerType::UpdateHighestPriorityThreads(kernel);
             Core::EmuThreadHandle leaving_thread = owner_thread;
 
+            // Account the time the lock was held, the counters are only written under the lock.
+            const u64 held_ns = ElapsedNs(this->hold_start);
+            this->hold_ns.fetch_add(held_ns, std::memory_order_relaxed);
+            if (held_ns > this->max_hold_ns.load(std::memory_order_relaxed)) {
+                this->max_hold_ns.store(held_ns, std::memory_order_relaxed);
+            }
+
             // Note that we no longer hold the lock, and unlock the spinlock.
             this->owner_thread = Core::EmuThreadHandle::InvalidHandle();
             this->spin_lock.unlock();
@@ -65,11 +95,35 @@ public:
         }
     }
 
+    KSchedulerLockStatistics GetStatistics() const {
+        return {
+            .num_acquisitions = this->num_acquisitions.load(std::memory_order_relaxed),
+            .num_contended = this->num_contended.load(std::memory_order_relaxed),
+            .wait_ns = this->wait_ns.load(std::memory_order_relaxed),
+            .hold_ns = this->hold_ns.load(std::memory_order_relaxed),
+            .max_hold_ns = this->max_hold_ns.load(std::memory_order_relaxed),
+        };
+    }
+
 private:
+    using Clock = std::chrono::steady_clock;
+
+    static u64 ElapsedNs(Clock::time_point start) {
+        return static_cast<u64>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+
     KernelCore& kernel;
     Common::SpinLock spin_lock{};
     s32 lock_count{};
     Core::EmuThreadHandle owner_thread{Core::EmuThreadHandle::InvalidHandle()};
+
+    Clock::time_point hold_start{};
+    std::atomic<u64> num_acquisitions{};
+    std::atomic<u64> num_contended{};
+    std::atomic<u64> wait_ns{};
+    std::atomic<u64> hold_ns{};
+    std::atomic<u64> max_hold_ns{};
 };
 
 } // namespace Kernel
@@ -7,9 +7,11 @@
 #include <bitset>
 #include <functional>
 #include <memory>
+#include <string>
 #include <thread>
 #include <unordered_set>
 #include <utility>
+#include <fmt/format.h>
 
 #include "common/assert.h"
 #include "common/logging/log.h"
@@ -43,6 +45,7 @@
 #include "core/hle/lock.h"
 #include "core/hle/result.h"
 #include "core/memory.h"
+#include "core/settings.h"
 
 MICROPROFILE_DEFINE(Kernel_SVC, "Kernel", "SVC", MP_RGB(70, 200, 70));
 
@@ -119,6 +122,7 @@ struct KernelCore::Impl {
         for (std::size_t i = 0; i < Core::Hardware::NUM_CPU_CORES; i++) {
             schedulers[i] = std::make_unique<Kernel::KScheduler>(system, i);
             cores.emplace_back(i, system, *schedulers[i], interrupts);
+            interrupts[i].SetIdlePolicy(Settings::values.cpu_idle_policy);
         }
     }
 
@@ -628,6 +632,42 @@ void KernelCore::ExitSVCProfile() {
     MicroProfileLeave(MICROPROFILE_TOKEN(Kernel_SVC), impl->svc_ticks[core]);
 }
 
+void KernelCore::LogSchedulerStatistics() const {
+    const auto ticks_to_ms = [](u64 ticks) {
+        return static_cast<double>(ticks) * 1000.0 /
+               static_cast<double>(Core::Hardware::BASE_CLOCK_RATE);
+    };
+    const KSchedulerLockStatistics lock = GlobalSchedulerContext().SchedulerLock().GetStatistics();
+    LOG_INFO(Kernel,
+             "Scheduler lock: {} acquisitions, {} contended, {:.3f} ms waiting, "
+             "{:.3f} ms held, {} ns longest hold",
+             lock.num_acquisitions, lock.num_contended, static_cast<double>(lock.wait_ns) / 1e6,
+             static_cast<double>(lock.hold_ns) / 1e6, lock.max_hold_ns);
+
+    const u64 elapsed_ticks = impl->system.CoreTiming().GetCPUTicks();
+    for (std::size_t core = 0; core < Core::Hardware::NUM_CPU_CORES; ++core) {
+        const KScheduler& scheduler = Scheduler(core);
+        const u64 idle_ticks = scheduler.GetIdleTicks();
+        LOG_INFO(Kernel, "Core {}: {} context switches, {:.3f} ms idle ({:.2f}%)", core,
+                 scheduler.GetNumContextSwitches(), ticks_to_ms(idle_ticks),
+                 elapsed_ticks == 0 ? 0.0
+                                    : static_cast<double>(idle_ticks) * 100.0 /
+                                          static_cast<double>(elapsed_ticks));
+    }
+
+    for (const auto& thread : GlobalSchedulerContext().GetThreadList()) {
+        if (thread->IsIdleThread() || thread->GetTotalCPUTimeTicks() == 0) {
+            continue;
+        }
+        std::string per_core;
+        for (std::size_t core = 0; core < Core::Hardware::NUM_CPU_CORES; ++core) {
+            per_core += fmt::format(" {:.3f}", ticks_to_ms(thread->GetCoreCPUTimeTicks(core)));
+        }
+        LOG_DEBUG(Kernel, "Thread {} ({}): {:.3f} ms, per core{} ms", thread->GetThreadID(),
+                  thread->GetName(), ticks_to_ms(thread->GetTotalCPUTimeTicks()), per_core);
+    }
+}
+
 std::weak_ptr<Kernel::ServiceThread> KernelCore::CreateServiceThread(const std::string& name) {
     auto service_thread = std::make_shared<Kernel::ServiceThread>(*this, 1, name);
     impl->service_thread_manager->QueueWork(
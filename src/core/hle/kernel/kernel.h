@@ -221,6 +221,10 @@ public:
 
     void ExitSVCProfile();
 
+    /// Logs the scheduler lock contention, the context switches and idle time of each core and
+    /// the time each thread has run on every core.
+    void LogSchedulerStatistics() const;
+
     /**
      * Creates an HLE service thread, which are used to execute service routines asynchronously.
      * While these are allocated per ServerSession, these need to be owned and managed outside of
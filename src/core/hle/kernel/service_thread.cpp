@@ -17,6 +17,7 @@
 #include "core/hle/kernel/server_session.h"
 #include "core/hle/kernel/service_thread.h"
 #include "core/hle/lock.h"
+#include "core/host_affinity.h"
 #include "video_core/renderer_base.h"
 
 namespace Kernel {
@@ -42,6 +43,7 @@ ServiceThread::Impl::Impl(KernelCore& kernel, std::size_t num_threads, const std
     for (std::size_t i = 0; i < num_threads; ++i)
         threads.emplace_back([this, &kernel] {
             Common::SetCurrentThreadName(std::string{"yuzu:HleService:" + service_name}.c_str());
+            Core::PinCurrentThread(Core::HostThreadType::Service);
 
             // Wait for first request before trying to acquire a render context
             {
@@ -16,6 +16,7 @@
 #include "common/intrusive_red_black_tree.h"
 #include "common/spin_lock.h"
 #include "core/arm/arm_interface.h"
+#include "core/hardware_properties.h"
 #include "core/hle/kernel/k_affinity_mask.h"
 #include "core/hle/kernel/k_synchronization_object.h"
 #include "core/hle/kernel/object.h"
@@ -344,8 +345,14 @@ public:
         return total_cpu_time_ticks;
     }
 
-    void UpdateCPUTimeTicks(u64 ticks) {
+    /// Returns the CPU ticks this thread has run on the given core.
+    u64 GetCoreCPUTimeTicks(std::size_t core) const {
+        return core_cpu_time_ticks[core];
+    }
+
+    void UpdateCPUTimeTicks(u64 ticks, std::size_t core) {
         total_cpu_time_ticks += ticks;
+        core_cpu_time_ticks[core] += ticks;
     }
 
     s32 GetProcessorID() const {
@@ -692,6 +699,9 @@ private:
     s64 schedule_count{};
     s64 last_scheduled_tick{};
 
+    /// CPU running ticks on each core.
+    std::array<u64, Core::Hardware::NUM_CPU_CORES> core_cpu_time_ticks{};
+
     s32 processor_id = 0;
 
     VAddr tls_address = 0; ///< Virtual address of the Thread Local Storage of the thread
@@ -224,11 +224,14 @@ void Controller_NPad::InitNewlyAddedController(std::size_t controller_idx) {
     controller.battery_level[0] = BATTERY_FULL;
     controller.battery_level[1] = BATTERY_FULL;
     controller.battery_level[2] = BATTERY_FULL;
+    full_update_pending = true;
 
     SignalStyleSetChangedEvent(IndexToNPad(controller_idx));
 }
 
 void Controller_NPad::OnInit() {
+    full_update_pending = true;
+
     auto& kernel = system.Kernel();
     for (std::size_t i = 0; i < styleset_changed_events.size(); ++i) {
         styleset_changed_events[i] = Kernel::WritableEvent::CreateEventPair(
@@ -533,8 +536,22 @@ void Controller_NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing, u8*
 
         press_state |= static_cast<u32>(pad_state.pad_states.raw);
     }
-    std::memcpy(data + NPAD_OFFSET, shared_memory_entries.data(),
-                shared_memory_entries.size() * sizeof(NPadEntry));
+
+    if (full_update_pending.exchange(false)) {
+        std::memcpy(data + NPAD_OFFSET, shared_memory_entries.data(),
+                    shared_memory_entries.size() * sizeof(NPadEntry));
+        return;
+    }
+    // Only the ring headers and their newest entries changed, skip copying the rest of the ~200KB
+    for (const auto& npad : shared_memory_entries) {
+        WriteLatestEntry(data, npad.main_controller_states);
+        WriteLatestEntry(data, npad.handheld_states);
+        WriteLatestEntry(data, npad.dual_states);
+        WriteLatestEntry(data, npad.left_joy_states);
+        WriteLatestEntry(data, npad.right_joy_states);
+        WriteLatestEntry(data, npad.pokeball_states);
+        WriteLatestEntry(data, npad.libnx);
+    }
 }
 
 void Controller_NPad::OnMotionUpdate(const Core::Timing::CoreTiming& core_timing, u8* data,
@@ -658,8 +675,41 @@ void Controller_NPad::OnMotionUpdate(const Core::Timing::CoreTiming& core_timing
             break;
         }
     }
-    std::memcpy(data + NPAD_OFFSET, shared_memory_entries.data(),
-                shared_memory_entries.size() * sizeof(NPadEntry));
+
+    if (full_update_pending.exchange(false)) {
+        std::memcpy(data + NPAD_OFFSET, shared_memory_entries.data(),
+                    shared_memory_entries.size() * sizeof(NPadEntry));
+        return;
+    }
+    for (std::size_t i = 0; i < shared_memory_entries.size(); ++i) {
+        const auto& controller_type = connected_controllers[i].type;
+        if (controller_type == NPadControllerType::None || !connected_controllers[i].is_connected) {
+            continue;
+        }
+        const auto& npad = shared_memory_entries[i];
+        WriteLatestEntry(data, npad.sixaxis_full);
+        WriteLatestEntry(data, npad.sixaxis_handheld);
+        WriteLatestEntry(data, npad.sixaxis_dual_left);
+        WriteLatestEntry(data, npad.sixaxis_dual_right);
+        WriteLatestEntry(data, npad.sixaxis_left);
+        WriteLatestEntry(data, npad.sixaxis_right);
+    }
+}
+
+void Controller_NPad::WriteLatestEntry(u8* data, const NPadGeneric& ring) const {
+    WriteSharedMemory(data, &ring.common, sizeof(ring.common));
+    WriteSharedMemory(data, &ring.npad[ring.common.last_entry_index], sizeof(ring.npad[0]));
+}
+
+void Controller_NPad::WriteLatestEntry(u8* data, const SixAxisGeneric& ring) const {
+    WriteSharedMemory(data, &ring.common, sizeof(ring.common));
+    WriteSharedMemory(data, &ring.sixaxis[ring.common.last_entry_index], sizeof(ring.sixaxis[0]));
+}
+
+void Controller_NPad::WriteSharedMemory(u8* data, const void* source, std::size_t size) const {
+    const u8* const base = reinterpret_cast<const u8*>(shared_memory_entries.data());
+    const auto offset = static_cast<std::size_t>(static_cast<const u8*>(source) - base);
+    std::memcpy(data + NPAD_OFFSET + offset, source, size);
 }
 
 void Controller_NPad::SetSupportedStyleSet(NpadStyleSet style_set) {
@@ -715,6 +765,7 @@ void Controller_NPad::SetNpadMode(u32 npad_id, NpadAssignments assignment_mode)
     ASSERT(npad_index < shared_memory_entries.size());
     if (shared_memory_entries[npad_index].pad_assignment != assignment_mode) {
         shared_memory_entries[npad_index].pad_assignment = assignment_mode;
+        full_update_pending = true;
     }
 }
 
@@ -924,6 +975,7 @@ void Controller_NPad::DisconnectNpadAtIndex(std::size_t npad_index) {
     controller.joy_styles.raw = 0; // Zero out
     controller.device_type.raw = 0;
     controller.properties.raw = 0;
+    full_update_pending = true;
 
     SignalStyleSetChangedEvent(IndexToNPad(npad_index));
 }
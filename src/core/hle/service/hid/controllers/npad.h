@@ -413,6 +413,12 @@ private:
     };
 
     void InitNewlyAddedController(std::size_t controller_idx);
+
+    /// Copies the header and newest entry of a ring in shared_memory_entries to shared memory.
+    void WriteLatestEntry(u8* data, const NPadGeneric& ring) const;
+    void WriteLatestEntry(u8* data, const SixAxisGeneric& ring) const;
+    /// Copies a range of shared_memory_entries to the same location in shared memory.
+    void WriteSharedMemory(u8* data, const void* source, std::size_t size) const;
     bool IsControllerSupported(NPadControllerType controller) const;
     void RequestPadStateUpdate(u32 npad_id);
 
@@ -420,6 +426,9 @@ private:
 
     NpadStyleSet style{};
     std::array<NPadEntry, 10> shared_memory_entries{};
+    // Set when shared_memory_entries changed outside of the sampling rings, so the next update
+    // has to copy all of it instead of only the newest ring entries.
+    std::atomic<bool> full_update_pending{true};
     using ButtonArray = std::array<
         std::array<std::unique_ptr<Input::ButtonDevice>, Settings::NativeButton::NUM_BUTTONS_HID>,
         10>;
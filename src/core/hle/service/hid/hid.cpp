@@ -43,6 +43,8 @@ namespace Service::HID {
 constexpr auto pad_update_ns = std::chrono::nanoseconds{1000 * 1000};         // (1ms, 1000Hz)
 constexpr auto motion_update_ns = std::chrono::nanoseconds{15 * 1000 * 1000}; // (15ms, 66.666Hz)
 constexpr std::size_t SHARED_MEMORY_SIZE = 0x40000;
+// Number of pad updates in one emulated second, used to report the host time spent in HID
+constexpr u32 pad_updates_per_second = 1000;
 
 IAppletResource::IAppletResource(Core::System& system_)
     : ServiceFramework{system_, "IAppletResource"} {
@@ -117,6 +119,7 @@ void IAppletResource::GetSharedMemoryHandle(Kernel::HLERequestContext& ctx) {
 void IAppletResource::UpdateControllers(std::uintptr_t user_data,
                                         std::chrono::nanoseconds ns_late) {
     auto& core_timing = system.CoreTiming();
+    const auto update_start = std::chrono::steady_clock::now();
 
     const bool should_reload = Settings::values.is_device_reload_pending.exchange(false);
     for (const auto& controller : controllers) {
@@ -126,6 +129,14 @@ void IAppletResource::UpdateControllers(std::uintptr_t user_data,
         controller->OnUpdate(core_timing, shared_mem->GetPointer(), SHARED_MEMORY_SIZE);
     }
 
+    update_time += std::chrono::steady_clock::now() - update_start;
+    if (++update_count == pad_updates_per_second) {
+        LOG_DEBUG(Service_HID, "Spent {} us of host time updating controllers in the last second",
+                  std::chrono::duration_cast<std::chrono::microseconds>(update_time).count());
+        update_time = {};
+        update_count = 0;
+    }
+
     core_timing.ScheduleEvent(pad_update_ns - ns_late, pad_update_event);
 }
 
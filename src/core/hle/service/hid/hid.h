@@ -74,6 +74,10 @@ private:
 
     std::array<std::unique_ptr<ControllerBase>, static_cast<size_t>(HidController::MaxControllers)>
         controllers{};
+
+    /// Host time spent in pad updates since the last report
+    std::chrono::steady_clock::duration update_time{};
+    u32 update_count{};
 };
 
 class Hid final : public ServiceFramework<Hid> {
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cinttypes>
 #include "common/logging/log.h"
 #include "core/core.h"
@@ -16,6 +17,23 @@
 
 namespace Service::Nvidia {
 
+std::span<u8> NVDRV::PrepareScratch(std::vector<u8>& scratch, std::size_t size) {
+    // The scratch buffers only ever grow, so after the first few ioctls of a session no further
+    // allocations are made. Zero the used region to match the semantics of a fresh buffer.
+    if (scratch.size() < size) {
+        scratch.resize(size);
+    }
+    const std::span<u8> span{scratch.data(), size};
+    std::fill(span.begin(), span.end(), u8{0});
+    return span;
+}
+
+std::span<const u8> NVDRV::ReadScratch(Kernel::HLERequestContext& ctx,
+                                       std::vector<u8>& scratch, std::size_t buffer_index) {
+    const auto span = PrepareScratch(scratch, ctx.GetReadBufferSize(buffer_index));
+    return span.first(ctx.ReadBufferInto(span, buffer_index));
+}
+
 void NVDRV::SignalGPUInterruptSyncpt(const u32 syncpoint_id, const u32 value) {
     nvdrv->SignalSyncpt(syncpoint_id, value);
 }
@@ -57,13 +75,12 @@ void NVDRV::Ioctl1(Kernel::HLERequestContext& ctx) {
         return;
     }
 
-    // Check device
-    std::vector<u8> output_buffer(ctx.GetWriteBufferSize(0));
-    const auto input_buffer = ctx.ReadBuffer(0);
+    const auto input = ReadScratch(ctx, input_scratch, 0);
+    const auto output = PrepareScratch(output_scratch, ctx.GetWriteBufferSize(0));
 
-    const auto nv_result = nvdrv->Ioctl1(fd, command, input_buffer, output_buffer);
+    const auto nv_result = nvdrv->Ioctl1(fd, command, input, output);
     if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer);
+        ctx.WriteBuffer(output.data(), output.size());
     }
 
     IPC::ResponseBuilder rb{ctx, 3};
@@ -83,14 +100,13 @@ void NVDRV::Ioctl2(Kernel::HLERequestContext& ctx) {
         return;
     }
 
-    const auto input_buffer = ctx.ReadBuffer(0);
-    const auto input_inlined_buffer = ctx.ReadBuffer(1);
-    std::vector<u8> output_buffer(ctx.GetWriteBufferSize(0));
+    const auto input = ReadScratch(ctx, input_scratch, 0);
+    const auto inline_input = ReadScratch(ctx, inline_scratch, 1);
+    const auto output = PrepareScratch(output_scratch, ctx.GetWriteBufferSize(0));
 
-    const auto nv_result =
-        nvdrv->Ioctl2(fd, command, input_buffer, input_inlined_buffer, output_buffer);
+    const auto nv_result = nvdrv->Ioctl2(fd, command, input, inline_input, output);
     if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer);
+        ctx.WriteBuffer(output.data(), output.size());
     }
 
     IPC::ResponseBuilder rb{ctx, 3};
@@ -110,15 +126,14 @@ void NVDRV::Ioctl3(Kernel::HLERequestContext& ctx) {
         return;
     }
 
-    const auto input_buffer = ctx.ReadBuffer(0);
-    std::vector<u8> output_buffer(ctx.GetWriteBufferSize(0));
-    std::vector<u8> output_buffer_inline(ctx.GetWriteBufferSize(1));
+    const auto input = ReadScratch(ctx, input_scratch, 0);
+    const auto output = PrepareScratch(output_scratch, ctx.GetWriteBufferSize(0));
+    const auto inline_output = PrepareScratch(inline_scratch, ctx.GetWriteBufferSize(1));
 
-    const auto nv_result =
-        nvdrv->Ioctl3(fd, command, input_buffer, output_buffer, output_buffer_inline);
+    const auto nv_result = nvdrv->Ioctl3(fd, command, input, output, inline_output);
     if (command.is_out != 0) {
-        ctx.WriteBuffer(output_buffer, 0);
-        ctx.WriteBuffer(output_buffer_inline, 1);
+        ctx.WriteBuffer(output.data(), output.size(), 0);
+        ctx.WriteBuffer(inline_output.data(), inline_output.size(), 1);
     }
 
     IPC::ResponseBuilder rb{ctx, 3};
@@ -5,6 +5,8 @@
 #pragma once
 
 #include <memory>
+#include <span>
+#include <vector>
 #include "core/hle/service/nvdrv/nvdrv.h"
 #include "core/hle/service/service.h"
 
@@ -36,8 +38,21 @@ private:
 
     void ServiceError(Kernel::HLERequestContext& ctx, NvResult result);
 
+    /// Returns a zeroed view of the first size bytes of scratch, growing it if needed.
+    static std::span<u8> PrepareScratch(std::vector<u8>& scratch, std::size_t size);
+
+    /// Reads the given request buffer into scratch and returns a view of the data read.
+    static std::span<const u8> ReadScratch(Kernel::HLERequestContext& ctx,
+                                           std::vector<u8>& scratch, std::size_t buffer_index);
+
     std::shared_ptr<Module> nvdrv;
 
+    // Ioctl buffers are reused between requests, as Ioctl1/2/3 are called thousands of times per
+    // second (GPFIFO submissions, syncpoint waits). Requests are serialized by the service lock.
+    std::vector<u8> input_scratch;
+    std::vector<u8> inline_scratch;
+    std::vector<u8> output_scratch;
+
     u64 pid{};
     bool is_initialized{};
 };
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <chrono>
 #include <utility>
 
 #include <fmt/format.h>
@@ -62,7 +63,13 @@ Module::Module(Core::System& system) : syncpoint_manager{system.GPU()} {
         std::make_shared<Devices::nvhost_vic>(system, nvmap_dev, syncpoint_manager);
 }
 
-Module::~Module() = default;
+Module::~Module() {
+    for (const auto& [command, statistics] : ioctl_statistics.Snapshot()) {
+        LOG_DEBUG(Service_NVDRV, "ioctl=0x{:08X} calls={} average={}ns max={}ns", command,
+                  statistics.calls, statistics.total_time.count() / statistics.calls,
+                  statistics.max_time.count());
+    }
+}
 
 NvResult Module::VerifyFD(DeviceFD fd) const {
     if (fd < 0) {
@@ -92,8 +99,8 @@ DeviceFD Module::Open(const std::string& device_name) {
     return fd;
 }
 
-NvResult Module::Ioctl1(DeviceFD fd, Ioctl command, const std::vector<u8>& input,
-                        std::vector<u8>& output) {
+NvResult Module::Ioctl1(DeviceFD fd, Ioctl command, std::span<const u8> input,
+                        std::span<u8> output) {
     if (fd < 0) {
         LOG_ERROR(Service_NVDRV, "Invalid DeviceFD={}!", fd);
         return NvResult::InvalidState;
@@ -106,11 +113,14 @@ NvResult Module::Ioctl1(DeviceFD fd, Ioctl command, const std::vector<u8>& input
         return NvResult::NotImplemented;
     }
 
-    return itr->second->Ioctl1(command, input, output);
+    const auto start = std::chrono::steady_clock::now();
+    const auto result = itr->second->Ioctl1(command, input, output);
+    ioctl_statistics.Record(command, std::chrono::steady_clock::now() - start);
+    return result;
 }
 
-NvResult Module::Ioctl2(DeviceFD fd, Ioctl command, const std::vector<u8>& input,
-                        const std::vector<u8>& inline_input, std::vector<u8>& output) {
+NvResult Module::Ioctl2(DeviceFD fd, Ioctl command, std::span<const u8> input,
+                        std::span<const u8> inline_input, std::span<u8> output) {
     if (fd < 0) {
         LOG_ERROR(Service_NVDRV, "Invalid DeviceFD={}!", fd);
         return NvResult::InvalidState;
@@ -123,11 +133,14 @@ NvResult Module::Ioctl2(DeviceFD fd, Ioctl command, const std::vector<u8>& input
         return NvResult::NotImplemented;
     }
 
-    return itr->second->Ioctl2(command, input, inline_input, output);
+    const auto start = std::chrono::steady_clock::now();
+    const auto result = itr->second->Ioctl2(command, input, inline_input, output);
+    ioctl_statistics.Record(command, std::chrono::steady_clock::now() - start);
+    return result;
 }
 
-NvResult Module::Ioctl3(DeviceFD fd, Ioctl command, const std::vector<u8>& input,
-                        std::vector<u8>& output, std::vector<u8>& inline_output) {
+NvResult Module::Ioctl3(DeviceFD fd, Ioctl command, std::span<const u8> input, std::span<u8> output,
+                        std::span<u8> inline_output) {
     if (fd < 0) {
         LOG_ERROR(Service_NVDRV, "Invalid DeviceFD={}!", fd);
         return NvResult::InvalidState;
@@ -140,7 +153,10 @@ NvResult Module::Ioctl3(DeviceFD fd, Ioctl command, const std::vector<u8>& input
         return NvResult::NotImplemented;
     }
 
-    return itr->second->Ioctl3(command, input, output, inline_output);
+    const auto start = std::chrono::steady_clock::now();
+    const auto result = itr->second->Ioctl3(command, input, output, inline_output);
+    ioctl_statistics.Record(command, std::chrono::steady_clock::now() - start);
+    return result;
 }
 
 NvResult Module::Close(DeviceFD fd) {
@@ -179,4 +195,8 @@ std::shared_ptr<Kernel::WritableEvent> Module::GetEventWriteable(const u32 event
     return events_interface.events[event_id].event.writable;
 }
 
+std::unordered_map<u32, IoctlStatistics> Module::GetIoctlStatistics() const {
+    return ioctl_statistics.Snapshot();
+}
+
 } // namespace Service::Nvidia
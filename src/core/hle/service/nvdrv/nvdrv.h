@@ -4,9 +4,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <unordered_map>
-#include <vector>
 #include "common/common_types.h"
 #include "core/hle/kernel/writable_event.h"
 #include "core/hle/service/nvdrv/nvdata.h"
@@ -98,6 +101,36 @@ struct EventInterface {
     }
 };
 
+/// Latency counters for a single ioctl command.
+struct IoctlStatistics {
+    u64 calls{};
+    std::chrono::nanoseconds total_time{};
+    std::chrono::nanoseconds max_time{};
+};
+
+/// Latency counters of every ioctl command, keyed by the raw ioctl value. Thread-safe.
+class IoctlStatisticsTable {
+public:
+    /// Accounts the time spent by a device handling the given ioctl command.
+    void Record(Ioctl command, std::chrono::nanoseconds duration) {
+        std::scoped_lock lock{mutex};
+        auto& statistics = table[command.raw];
+        ++statistics.calls;
+        statistics.total_time += duration;
+        statistics.max_time = std::max(statistics.max_time, duration);
+    }
+
+    /// Returns a snapshot of the counters.
+    std::unordered_map<u32, IoctlStatistics> Snapshot() const {
+        std::scoped_lock lock{mutex};
+        return table;
+    }
+
+private:
+    mutable std::mutex mutex;
+    std::unordered_map<u32, IoctlStatistics> table;
+};
+
 class Module final {
 public:
     explicit Module(Core::System& system_);
@@ -118,14 +151,13 @@ public:
     DeviceFD Open(const std::string& device_name);
 
     /// Sends an ioctl command to the specified file descriptor.
-    NvResult Ioctl1(DeviceFD fd, Ioctl command, const std::vector<u8>& input,
-                    std::vector<u8>& output);
+    NvResult Ioctl1(DeviceFD fd, Ioctl command, std::span<const u8> input, std::span<u8> output);
 
-    NvResult Ioctl2(DeviceFD fd, Ioctl command, const std::vector<u8>& input,
-                    const std::vector<u8>& inline_input, std::vector<u8>& output);
+    NvResult Ioctl2(DeviceFD fd, Ioctl command, std::span<const u8> input,
+                    std::span<const u8> inline_input, std::span<u8> output);
 
-    NvResult Ioctl3(DeviceFD fd, Ioctl command, const std::vector<u8>& input,
-                    std::vector<u8>& output, std::vector<u8>& inline_output);
+    NvResult Ioctl3(DeviceFD fd, Ioctl command, std::span<const u8> input, std::span<u8> output,
+                    std::span<u8> inline_output);
 
     /// Closes a device file descriptor and returns operation success.
     NvResult Close(DeviceFD fd);
@@ -136,6 +168,9 @@ public:
 
     std::shared_ptr<Kernel::WritableEvent> GetEventWriteable(u32 event_id) const;
 
+    /// Returns a snapshot of the per-command latency counters, keyed by the raw ioctl value.
+    std::unordered_map<u32, IoctlStatistics> GetIoctlStatistics() const;
+
 private:
     /// Manages syncpoints on the host
     SyncpointManager syncpoint_manager;
@@ -150,6 +185,8 @@ private:
     std::unordered_map<std::string, std::shared_ptr<Devices::nvdevice>> devices;
 
     EventInterface events_interface;
+
+    IoctlStatisticsTable ioctl_statistics;
 };
 
 /// Registers all NVDRV services with the specified service manager.
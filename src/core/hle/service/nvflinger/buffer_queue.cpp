@@ -3,8 +3,10 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <chrono>
 
 #include "common/assert.h"
+#include "common/bit_util.h"
 #include "common/logging/log.h"
 #include "core/core.h"
 #include "core/hle/kernel/kernel.h"
@@ -14,6 +16,34 @@
 
 namespace Service::NVFlinger {
 
+namespace {
+
+s64 GetTimestampNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/// Returns the slot set in mask with the lowest order that satisfies pred.
+template <typename Pred>
+std::optional<u32> FindOldestSlot(u64 mask, const std::array<std::atomic<u64>, buffer_slots>& order,
+                                  Pred&& pred) {
+    std::optional<u32> oldest_slot;
+    u64 oldest_order = 0;
+    while (mask != 0) {
+        const u32 slot = Common::CountTrailingZeroes64(mask);
+        mask &= mask - 1;
+        const u64 slot_order = order[slot].load(std::memory_order_relaxed);
+        if ((!oldest_slot || slot_order < oldest_order) && pred(slot)) {
+            oldest_slot = slot;
+            oldest_order = slot_order;
+        }
+    }
+    return oldest_slot;
+}
+
+} // Anonymous namespace
+
 BufferQueue::BufferQueue(Kernel::KernelCore& kernel, u32 id, u64 layer_id)
     : id(id), layer_id(layer_id) {
     buffer_wait_event = Kernel::WritableEvent::CreateEventPair(kernel, "BufferQueue NativeHandle");
@@ -25,12 +55,6 @@ void BufferQueue::SetPreallocatedBuffer(u32 slot, const IGBPBuffer& igbp_buffer)
     ASSERT(slot < buffer_slots);
     LOG_WARNING(Service, "Adding graphics buffer {}", slot);
 
-    {
-        std::unique_lock lock{free_buffers_mutex};
-        free_buffers.push_back(slot);
-    }
-    free_buffers_condition.notify_one();
-
     buffers[slot] = {
         .slot = slot,
         .status = Buffer::Status::Free,
@@ -40,6 +64,7 @@ void BufferQueue::SetPreallocatedBuffer(u32 slot, const IGBPBuffer& igbp_buffer)
         .swap_interval = 0,
         .multi_fence = {},
     };
+    MarkSlotFree(slot);
 
     buffer_wait_event.writable->Signal();
 }
@@ -47,10 +72,7 @@ void BufferQueue::SetPreallocatedBuffer(u32 slot, const IGBPBuffer& igbp_buffer)
 std::optional<std::pair<u32, Service::Nvidia::MultiFence*>> BufferQueue::DequeueBuffer(u32 width,
                                                                                        u32 height) {
     // Wait for first request before trying to dequeue
-    {
-        std::unique_lock lock{free_buffers_mutex};
-        free_buffers_condition.wait(lock, [this] { return !free_buffers.empty() || !is_connect; });
-    }
+    WaitForFreeSlot();
 
     if (!is_connect) {
         // Buffer was disconnected while the thread was blocked, this is most likely due to
@@ -58,26 +80,30 @@ std::optional<std::pair<u32, Service::Nvidia::MultiFence*>> BufferQueue::Dequeue
         return std::nullopt;
     }
 
-    std::unique_lock lock{free_buffers_mutex};
-
-    auto f_itr = free_buffers.begin();
-    auto slot = buffers.size();
-
-    while (f_itr != free_buffers.end()) {
-        const Buffer& buffer = buffers[*f_itr];
-        if (buffer.status == Buffer::Status::Free && buffer.igbp_buffer.width == width &&
-            buffer.igbp_buffer.height == height) {
-            slot = *f_itr;
-            free_buffers.erase(f_itr);
-            break;
+    u64 free = free_slots.load(std::memory_order_acquire);
+    std::optional<u32> slot;
+    do {
+        slot = FindOldestSlot(free, free_order, [&](u32 index) {
+            const IGBPBuffer& igbp_buffer = buffers[index].igbp_buffer;
+            return igbp_buffer.width == width && igbp_buffer.height == height;
+        });
+        if (!slot) {
+            return std::nullopt;
         }
-        ++f_itr;
-    }
-    if (slot == buffers.size()) {
-        return std::nullopt;
-    }
-    buffers[slot].status = Buffer::Status::Dequeued;
-    return {{buffers[slot].slot, &buffers[slot].multi_fence}};
+    } while (!free_slots.compare_exchange_weak(free, free & ~(u64{1} << *slot),
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_acquire));
+
+    buffers[*slot].status = Buffer::Status::Dequeued;
+    pending_pacing[*slot] = {
+        .frame_number = 0,
+        .slot = *slot,
+        .dequeue_ns = GetTimestampNs(),
+        .queue_ns = 0,
+        .acquire_ns = 0,
+        .present_ns = 0,
+    };
+    return {{buffers[*slot].slot, &buffers[*slot].multi_fence}};
 }
 
 const IGBPBuffer& BufferQueue::RequestBuffer(u32 slot) const {
@@ -100,8 +126,13 @@ void BufferQueue::QueueBuffer(u32 slot, BufferTransformFlags transform,
     buffers[slot].crop_rect = crop_rect;
     buffers[slot].swap_interval = swap_interval;
     buffers[slot].multi_fence = multi_fence;
-    std::unique_lock lock{queue_sequence_mutex};
-    queue_sequence.push_back(slot);
+
+    const u64 frame_number = queue_counter.fetch_add(1, std::memory_order_relaxed);
+    pending_pacing[slot].frame_number = frame_number;
+    pending_pacing[slot].queue_ns = GetTimestampNs();
+
+    queue_order[slot].store(frame_number, std::memory_order_relaxed);
+    queued_slots.fetch_or(u64{1} << slot, std::memory_order_release);
 }
 
 void BufferQueue::CancelBuffer(u32 slot, const Service::Nvidia::MultiFence& multi_fence) {
@@ -109,37 +140,35 @@ void BufferQueue::CancelBuffer(u32 slot, const Service::Nvidia::MultiFence& mult
     ASSERT(buffers[slot].status != Buffer::Status::Free);
     ASSERT(buffers[slot].slot == slot);
 
+    queued_slots.fetch_and(~(u64{1} << slot), std::memory_order_acq_rel);
+
     buffers[slot].status = Buffer::Status::Free;
     buffers[slot].multi_fence = multi_fence;
     buffers[slot].swap_interval = 0;
-
-    {
-        std::unique_lock lock{free_buffers_mutex};
-        free_buffers.push_back(slot);
-    }
-    free_buffers_condition.notify_one();
+    MarkSlotFree(slot);
 
     buffer_wait_event.writable->Signal();
 }
 
 std::optional<std::reference_wrapper<const BufferQueue::Buffer>> BufferQueue::AcquireBuffer() {
-    std::unique_lock lock{queue_sequence_mutex};
-    std::size_t buffer_slot = buffers.size();
-    // Iterate to find a queued buffer matching the requested slot.
-    while (buffer_slot == buffers.size() && !queue_sequence.empty()) {
-        const auto slot = static_cast<std::size_t>(queue_sequence.front());
-        ASSERT(slot < buffers.size());
-        if (buffers[slot].status == Buffer::Status::Queued) {
-            ASSERT(buffers[slot].slot == slot);
-            buffer_slot = slot;
+    // Only the compositor acquires buffers, so a slot can only be taken away from us by a
+    // concurrent CancelBuffer. Retry when that happens.
+    u64 queued = queued_slots.load(std::memory_order_acquire);
+    while (queued != 0) {
+        const u32 slot = *FindOldestSlot(queued, queue_order, [](u32) { return true; });
+        const u64 bit = u64{1} << slot;
+        const u64 previous = queued_slots.fetch_and(~bit, std::memory_order_acq_rel);
+        if ((previous & bit) == 0) {
+            queued = previous;
+            continue;
         }
-        queue_sequence.pop_front();
-    }
-    if (buffer_slot == buffers.size()) {
-        return std::nullopt;
+
+        ASSERT(buffers[slot].slot == slot);
+        buffers[slot].status = Buffer::Status::Acquired;
+        pending_pacing[slot].acquire_ns = GetTimestampNs();
+        return {{buffers[slot]}};
     }
-    buffers[buffer_slot].status = Buffer::Status::Acquired;
-    return {{buffers[buffer_slot]}};
+    return std::nullopt;
 }
 
 void BufferQueue::ReleaseBuffer(u32 slot) {
@@ -147,31 +176,31 @@ void BufferQueue::ReleaseBuffer(u32 slot) {
     ASSERT(buffers[slot].status == Buffer::Status::Acquired);
     ASSERT(buffers[slot].slot == slot);
 
+    // The buffer has been flipped at this point, record when it was presented
+    pending_pacing[slot].present_ns = GetTimestampNs();
+    frame_pacing_records.Push(&pending_pacing[slot], 1);
+
     buffers[slot].status = Buffer::Status::Free;
-    {
-        std::unique_lock lock{free_buffers_mutex};
-        free_buffers.push_back(slot);
-    }
-    free_buffers_condition.notify_one();
+    MarkSlotFree(slot);
 
     buffer_wait_event.writable->Signal();
 }
 
 void BufferQueue::Connect() {
-    std::unique_lock lock{queue_sequence_mutex};
-    queue_sequence.clear();
+    queued_slots.store(0, std::memory_order_release);
     is_connect = true;
 }
 
 void BufferQueue::Disconnect() {
     buffers.fill({});
+    free_slots.store(0, std::memory_order_release);
+    queued_slots.store(0, std::memory_order_release);
+    buffer_wait_event.writable->Signal();
     {
-        std::unique_lock lock{queue_sequence_mutex};
-        queue_sequence.clear();
+        std::scoped_lock lock{free_slots_mutex};
+        is_connect = false;
     }
-    buffer_wait_event.writable->Signal();
-    is_connect = false;
-    free_buffers_condition.notify_one();
+    free_slots_condition.notify_all();
 }
 
 u32 BufferQueue::Query(QueryType type) {
@@ -194,4 +223,32 @@ std::shared_ptr<Kernel::ReadableEvent> BufferQueue::GetBufferWaitEvent() const {
     return buffer_wait_event.readable;
 }
 
+std::vector<FramePacingRecord> BufferQueue::PopFramePacingRecords() {
+    return frame_pacing_records.Pop();
+}
+
+void BufferQueue::WaitForFreeSlot() {
+    if (free_slots.load(std::memory_order_acquire) != 0 || !is_connect) {
+        return;
+    }
+
+    std::unique_lock lock{free_slots_mutex};
+    ++free_slot_waiters;
+    free_slots_condition.wait(lock, [this] { return free_slots.load() != 0 || !is_connect; });
+    --free_slot_waiters;
+}
+
+void BufferQueue::MarkSlotFree(u32 slot) {
+    free_order[slot].store(free_counter.fetch_add(1, std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+    free_slots.fetch_or(u64{1} << slot);
+
+    // Only go through the mutex when a thread is actually sleeping in DequeueBuffer
+    if (free_slot_waiters.load() == 0) {
+        return;
+    }
+    { std::scoped_lock lock{free_slots_mutex}; }
+    free_slots_condition.notify_all();
+}
+
 } // namespace Service::NVFlinger
@@ -4,14 +4,16 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <condition_variable>
-#include <list>
 #include <mutex>
 #include <optional>
 #include <vector>
 
 #include "common/common_funcs.h"
 #include "common/math_util.h"
+#include "common/ring_buffer.h"
 #include "common/swap.h"
 #include "core/hle/kernel/object.h"
 #include "core/hle/kernel/writable_event.h"
@@ -43,6 +45,16 @@ struct IGBPBuffer {
 
 static_assert(sizeof(IGBPBuffer) == 0x16C, "IGBPBuffer has wrong size");
 
+/// Host timestamps, in nanoseconds, of a single frame going through a buffer queue.
+struct FramePacingRecord {
+    u64 frame_number;
+    u32 slot;
+    s64 dequeue_ns;
+    s64 queue_ns;
+    s64 acquire_ns;
+    s64 present_ns;
+};
+
 class BufferQueue final {
 public:
     enum class QueryType {
@@ -117,22 +129,46 @@ public:
 
     std::shared_ptr<Kernel::ReadableEvent> GetBufferWaitEvent() const;
 
+    /// Pops the pacing records of the frames presented since the last call. Records of newer
+    /// frames are dropped while 256 are pending, so this should be called after each composition.
+    std::vector<FramePacingRecord> PopFramePacingRecords();
+
 private:
     BufferQueue(const BufferQueue&) = delete;
 
+    /// Blocks until a slot is free or the queue is disconnected.
+    void WaitForFreeSlot();
+
+    /// Marks a slot as free and wakes up any thread waiting in DequeueBuffer.
+    void MarkSlotFree(u32 slot);
+
     u32 id{};
     u64 layer_id{};
     std::atomic_bool is_connect{};
 
-    std::list<u32> free_buffers;
     std::array<Buffer, buffer_slots> buffers;
-    std::list<u32> queue_sequence;
     Kernel::EventPair buffer_wait_event;
 
-    std::mutex free_buffers_mutex;
-    std::condition_variable free_buffers_condition;
-
-    std::mutex queue_sequence_mutex;
+    /// Bitmask of the slots that can be dequeued.
+    std::atomic<u64> free_slots{};
+    /// Bitmask of the slots that have been queued and are waiting to be acquired.
+    std::atomic<u64> queued_slots{};
+
+    /// Order in which slots were freed and queued, used to hand out slots in FIFO order.
+    std::array<std::atomic<u64>, buffer_slots> free_order{};
+    std::array<std::atomic<u64>, buffer_slots> queue_order{};
+    std::atomic<u64> free_counter{};
+    std::atomic<u64> queue_counter{};
+
+    /// Only used to sleep in DequeueBuffer when no slot is free.
+    std::mutex free_slots_mutex;
+    std::condition_variable free_slots_condition;
+    std::atomic<u32> free_slot_waiters{};
+
+    /// Pacing of the frame currently held by each slot, handed over between threads together with
+    /// the slot itself.
+    std::array<FramePacingRecord, buffer_slots> pending_pacing{};
+    Common::RingBuffer<FramePacingRecord, 256> frame_pacing_records;
 };
 
 } // namespace Service::NVFlinger
@@ -0,0 +1,94 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <utility>
+
+#include "common/logging/log.h"
+#include "core/hle/service/nvflinger/composition_scheduler.h"
+
+namespace Service::NVFlinger {
+
+CompositionScheduler::CompositionScheduler(Duration target_latency_, bool unlocked_)
+    : target_latency{target_latency_}, unlocked{unlocked_} {}
+
+CompositionScheduler::~CompositionScheduler() = default;
+
+void CompositionScheduler::BeginComposition(Duration now) {
+    composition_begin = now;
+    if (!has_schedule) {
+        return;
+    }
+
+    const Duration jitter = now - scheduled_time;
+    const Duration abs_jitter = jitter < Duration::zero() ? -jitter : jitter;
+    LOG_TRACE(Service, "Composition jitter: {} us",
+              std::chrono::duration_cast<std::chrono::microseconds>(jitter).count());
+
+    // Waking up late is compensated by scheduling earlier, waking up early is not expected
+    wakeup_latency = (wakeup_latency * 7 + std::max(jitter, Duration::zero())) / 8;
+
+    ++statistics.frames;
+    statistics.total_jitter += abs_jitter;
+    statistics.max_jitter = std::max(statistics.max_jitter, abs_jitter);
+}
+
+void CompositionScheduler::EndComposition(Duration now) {
+    durations[duration_index] = now - composition_begin;
+    duration_index = (duration_index + 1) % HISTORY_SIZE;
+    num_durations = std::min(num_durations + 1, HISTORY_SIZE);
+
+    if (has_schedule && now > next_deadline) {
+        ++statistics.missed_deadlines;
+    }
+}
+
+CompositionScheduler::Duration CompositionScheduler::NextCompositionTime(Duration frame_period) {
+    const Duration last_duration =
+        num_durations == 0 ? Duration::zero()
+                           : durations[(duration_index + HISTORY_SIZE - 1) % HISTORY_SIZE];
+    const Duration composition_end = composition_begin + last_duration;
+    const Duration predicted = PredictedDuration();
+
+    const Duration period =
+        unlocked ? std::max(predicted + SAFETY_MARGIN, MIN_UNLOCKED_PERIOD) : frame_period;
+
+    const bool is_latency_targeted = target_latency > Duration::zero() && !unlocked;
+    Duration lead = period;
+    if (is_latency_targeted) {
+        lead = std::clamp(std::max(target_latency, predicted + SAFETY_MARGIN), Duration::zero(),
+                          period);
+    }
+
+    if (!has_schedule) {
+        // The first composition is considered on time, its deadline anchors the grid
+        next_deadline = composition_begin + lead;
+        has_schedule = true;
+    }
+
+    // Latched frames are only shown at the deadline, otherwise vsync follows the composition
+    vsync_time = is_latency_targeted ? std::max(next_deadline, composition_end) : composition_end;
+
+    // Move to the next vsync deadline, skipping the ones that have already been missed
+    next_deadline += period;
+    if (next_deadline <= composition_end) {
+        const auto missed = (composition_end - next_deadline) / period + 1;
+        next_deadline += missed * period;
+    }
+
+    scheduled_time = std::max(next_deadline - lead - wakeup_latency, composition_end);
+    return scheduled_time;
+}
+
+CompositionScheduler::Duration CompositionScheduler::PredictedDuration() const {
+    // Use the slowest recent composition, a single late frame is worse than composing early
+    const auto end = durations.begin() + num_durations;
+    return num_durations == 0 ? Duration::zero() : *std::max_element(durations.begin(), end);
+}
+
+CompositionScheduler::Statistics CompositionScheduler::GetAndResetStatistics() {
+    return std::exchange(statistics, Statistics{});
+}
+
+} // namespace Service::NVFlinger
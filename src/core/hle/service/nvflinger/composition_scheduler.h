@@ -0,0 +1,105 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include "common/common_types.h"
+
+namespace Service::NVFlinger {
+
+/**
+ * Decides when the next screen composition should begin and when its vsync should be signalled.
+ *
+ * Compositions are aligned to a grid of vsync deadlines spaced by the frame period, the first
+ * composition anchors the grid. Without a target latency the composition begins at the start of
+ * each frame and vsync is signalled as soon as it finishes, which is the classic fixed rate
+ * behaviour. With a target latency the composition latches the guest buffer that long before the
+ * deadline, or earlier if recent compositions took longer, and vsync is only signalled at the
+ * deadline. The guest then has the whole frame minus the target latency to render after vsync, and
+ * its frame is shown that much sooner than it would be at the next vsync.
+ *
+ * The scheduler does not read any clock by itself, all times are passed in by the caller. This
+ * class is not thread-safe.
+ */
+class CompositionScheduler {
+public:
+    using Duration = std::chrono::nanoseconds;
+
+    struct Statistics {
+        u64 frames;
+        u64 missed_deadlines;
+        Duration total_jitter;
+        Duration max_jitter;
+    };
+
+    explicit CompositionScheduler(Duration target_latency = Duration::zero(),
+                                  bool unlocked = false);
+    ~CompositionScheduler();
+
+    /// Sets how long before each vsync deadline the composition should begin. Zero disables
+    /// latency targeting.
+    void SetTargetLatency(Duration target_latency_) {
+        target_latency = target_latency_;
+    }
+
+    /// When unlocked, compositions are paced at the rate the compositions themselves complete
+    /// instead of the guest requested frame period.
+    void SetUnlocked(bool unlocked_) {
+        unlocked = unlocked_;
+    }
+
+    /// Notifies that a composition is beginning at the given time.
+    void BeginComposition(Duration now);
+
+    /// Notifies that the composition that began last has finished at the given time.
+    void EndComposition(Duration now);
+
+    /// Returns the time at which the next composition should begin.
+    [[nodiscard]] Duration NextCompositionTime(Duration frame_period);
+
+    /// Returns the time at which the vsync of the last composition should be signalled. Only
+    /// valid after NextCompositionTime.
+    [[nodiscard]] Duration VSyncTime() const {
+        return vsync_time;
+    }
+
+    /// Returns the expected duration of the next composition.
+    [[nodiscard]] Duration PredictedDuration() const;
+
+    /// Returns the statistics collected since the last call and resets them.
+    Statistics GetAndResetStatistics();
+
+private:
+    /// Number of composition durations used to predict the next one.
+    static constexpr std::size_t HISTORY_SIZE = 16;
+
+    /// Extra time reserved on top of the predicted composition duration.
+    static constexpr Duration SAFETY_MARGIN = std::chrono::microseconds{500};
+
+    /// Shortest frame period allowed when the frame rate is unlocked.
+    static constexpr Duration MIN_UNLOCKED_PERIOD = std::chrono::milliseconds{1};
+
+    Duration target_latency;
+    bool unlocked;
+
+    std::array<Duration, HISTORY_SIZE> durations{};
+    std::size_t num_durations = 0;
+    std::size_t duration_index = 0;
+
+    Duration composition_begin{};
+    Duration scheduled_time{};
+    Duration next_deadline{};
+    Duration vsync_time{};
+    bool has_schedule = false;
+
+    /// Running average of how late the host woke up compared to the scheduled time.
+    Duration wakeup_latency{};
+
+    Statistics statistics{};
+};
+
+} // namespace Service::NVFlinger
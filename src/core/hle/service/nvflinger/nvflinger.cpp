@@ -44,20 +44,54 @@ void NVFlinger::SplitVSync() {
 
     Common::SetCurrentThreadName(name.c_str());
     Common::SetCurrentThreadPriority(Common::ThreadPriority::High);
-    s64 delay = 0;
+    const auto wait_until = [this](std::chrono::nanoseconds time) {
+        const auto wait_time = time - system.CoreTiming().GetGlobalTimeNs();
+        if (wait_time > std::chrono::nanoseconds::zero()) {
+            wait_event->WaitFor(wait_time);
+        }
+    };
     while (is_running) {
         guard->lock();
-        const s64 time_start = system.CoreTiming().GetGlobalTimeNs().count();
-        Compose();
-        const auto ticks = GetNextTicks();
-        const s64 time_end = system.CoreTiming().GetGlobalTimeNs().count();
-        const s64 time_passed = time_end - time_start;
-        const s64 next_time = std::max<s64>(0, ticks - time_passed - delay);
+        const auto times = ComposeAndSchedule();
         guard->unlock();
-        if (next_time > 0) {
-            wait_event->WaitFor(std::chrono::nanoseconds{next_time});
+
+        wait_until(times.vsync);
+        if (!is_running) {
+            break;
         }
-        delay = (system.CoreTiming().GetGlobalTimeNs().count() - time_end) - next_time;
+        guard->lock();
+        SignalVSync();
+        guard->unlock();
+
+        wait_until(times.next_composition);
+    }
+}
+
+NVFlinger::CompositionTimes NVFlinger::ComposeAndSchedule() {
+    composition_scheduler.SetTargetLatency(
+        std::chrono::microseconds{Settings::values.composition_target_latency_us});
+    composition_scheduler.SetUnlocked(Settings::values.unlock_framerate);
+
+    auto& core_timing = system.CoreTiming();
+    composition_scheduler.BeginComposition(core_timing.GetGlobalTimeNs());
+    Compose();
+    composition_scheduler.EndComposition(core_timing.GetGlobalTimeNs());
+
+    const auto next_time =
+        composition_scheduler.NextCompositionTime(std::chrono::nanoseconds{GetNextTicks()});
+
+    if (++composed_frames % 600 == 0) {
+        LogCompositionStatistics();
+    }
+    return {
+        .vsync = composition_scheduler.VSyncTime(),
+        .next_composition = next_time,
+    };
+}
+
+void NVFlinger::SignalVSync() {
+    for (auto& display : displays) {
+        display.SignalVSyncEvent();
     }
 }
 
@@ -71,15 +105,22 @@ NVFlinger::NVFlinger(Core::System& system) : system(system) {
 
     // Schedule the screen composition events
     composition_event = Core::Timing::CreateEvent(
-        "ScreenComposition", [this](std::uintptr_t, std::chrono::nanoseconds ns_late) {
+        "ScreenComposition", [this](std::uintptr_t, std::chrono::nanoseconds) {
             const auto guard = Lock();
-            Compose();
-
-            const auto ticks = std::chrono::nanoseconds{GetNextTicks()};
-            const auto ticks_delta = ticks - ns_late;
-            const auto future_ns = std::max(std::chrono::nanoseconds::zero(), ticks_delta);
-
-            this->system.CoreTiming().ScheduleEvent(future_ns, composition_event);
+            const auto times = ComposeAndSchedule();
+
+            // The scheduler already accounts for the event running late
+            auto& core_timing = this->system.CoreTiming();
+            const auto now = core_timing.GetGlobalTimeNs();
+            const auto zero = std::chrono::nanoseconds::zero();
+            core_timing.ScheduleEvent(std::max(zero, times.vsync - now), vsync_event);
+            core_timing.ScheduleEvent(std::max(zero, times.next_composition - now),
+                                      composition_event);
+        });
+    vsync_event = Core::Timing::CreateEvent(
+        "ScreenVSync", [this](std::uintptr_t, std::chrono::nanoseconds) {
+            const auto guard = Lock();
+            SignalVSync();
         });
 
     if (system.IsMulticore()) {
@@ -104,6 +145,7 @@ NVFlinger::~NVFlinger() {
         wait_event.reset();
     } else {
         system.CoreTiming().UnscheduleEvent(composition_event, 0);
+        system.CoreTiming().UnscheduleEvent(vsync_event, 0);
     }
 }
 
@@ -234,9 +276,6 @@ const VI::Layer* NVFlinger::FindLayer(u64 display_id, u64 layer_id) const {
 
 void NVFlinger::Compose() {
     for (auto& display : displays) {
-        // Trigger vsync for this display at the end of drawing
-        SCOPE_EXIT({ display.SignalVSyncEvent(); });
-
         // Don't do anything for displays without layers.
         if (!display.HasLayers())
             continue;
@@ -281,6 +320,49 @@ void NVFlinger::Compose() {
 
         swap_interval = buffer->get().swap_interval;
         buffer_queue.ReleaseBuffer(buffer->get().slot);
+        RecordFramePacing(buffer_queue);
+    }
+}
+
+void NVFlinger::RecordFramePacing(BufferQueue& buffer_queue) {
+    for (const FramePacingRecord& record : buffer_queue.PopFramePacingRecords()) {
+        LOG_TRACE(Service,
+                  "Frame {} in queue {} slot {}: dequeue={} queue={} acquire={} present={} ns",
+                  record.frame_number, buffer_queue.GetId(), record.slot, record.dequeue_ns,
+                  record.queue_ns, record.acquire_ns, record.present_ns);
+
+        const s64 latency_ns = record.present_ns - record.queue_ns;
+        ++frame_pacing.frames;
+        frame_pacing.total_render_ns += record.queue_ns - record.dequeue_ns;
+        frame_pacing.total_latency_ns += latency_ns;
+        frame_pacing.max_latency_ns = std::max(frame_pacing.max_latency_ns, latency_ns);
+    }
+}
+
+void NVFlinger::LogCompositionStatistics() {
+    const auto stats = composition_scheduler.GetAndResetStatistics();
+    if (stats.frames == 0) {
+        return;
+    }
+    const auto to_us = [](std::chrono::nanoseconds ns) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(ns).count();
+    };
+    LOG_DEBUG(Service,
+              "Composed {} frames: mean jitter={} us, max jitter={} us, predicted duration={} us, "
+              "missed deadlines={}",
+              stats.frames, to_us(stats.total_jitter) / static_cast<s64>(stats.frames),
+              to_us(stats.max_jitter), to_us(composition_scheduler.PredictedDuration()),
+              stats.missed_deadlines);
+
+    if (frame_pacing.frames != 0) {
+        const auto frames = static_cast<s64>(frame_pacing.frames);
+        LOG_DEBUG(Service,
+                  "Presented {} frames: mean render={} us, mean queue to present={} us, max "
+                  "queue to present={} us",
+                  frame_pacing.frames, frame_pacing.total_render_ns / frames / 1000,
+                  frame_pacing.total_latency_ns / frames / 1000,
+                  frame_pacing.max_latency_ns / 1000);
+        frame_pacing = {};
     }
 }
 
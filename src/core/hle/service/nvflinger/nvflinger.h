@@ -5,6 +5,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -15,6 +16,7 @@
 
 #include "common/common_types.h"
 #include "core/hle/kernel/object.h"
+#include "core/hle/service/nvflinger/composition_scheduler.h"
 
 namespace Common {
 class Event;
@@ -77,8 +79,8 @@ public:
     /// Obtains a buffer queue identified by the ID.
     [[nodiscard]] BufferQueue* FindBufferQueue(u32 id);
 
-    /// Performs a composition request to the emulated nvidia GPU and triggers the vsync events when
-    /// finished.
+    /// Performs a composition request to the emulated nvidia GPU. The vsync events are signalled
+    /// separately, at the time chosen by the composition scheduler.
     void Compose();
 
     [[nodiscard]] s64 GetNextTicks() const;
@@ -100,6 +102,25 @@ private:
     /// Finds the layer identified by the specified ID in the desired display.
     [[nodiscard]] const VI::Layer* FindLayer(u64 display_id, u64 layer_id) const;
 
+    /// Global times at which the vsync of a composition and the next composition are due.
+    struct CompositionTimes {
+        std::chrono::nanoseconds vsync;
+        std::chrono::nanoseconds next_composition;
+    };
+
+    /// Composes the displays and returns when its vsync should be signalled and when the next
+    /// composition should begin. The guard must be held by the caller.
+    CompositionTimes ComposeAndSchedule();
+
+    /// Signals the vsync event of every display. The guard must be held by the caller.
+    void SignalVSync();
+
+    /// Logs the composition jitter and frame pacing accumulated since the last call.
+    void LogCompositionStatistics();
+
+    /// Consumes the pacing records of the frames presented through a buffer queue.
+    void RecordFramePacing(BufferQueue& buffer_queue);
+
     static void VSyncThread(NVFlinger& nv_flinger);
 
     void SplitVSync();
@@ -117,8 +138,22 @@ private:
 
     u32 swap_interval = 1;
 
+    CompositionScheduler composition_scheduler;
+    u64 composed_frames = 0;
+
+    /// Frame pacing of the presented frames, accumulated until the next statistics log.
+    struct FramePacingStatistics {
+        u64 frames = 0;
+        s64 total_render_ns = 0;  ///< From dequeue to queue, the time the guest took to render
+        s64 total_latency_ns = 0; ///< From queue to present
+        s64 max_latency_ns = 0;
+    };
+    FramePacingStatistics frame_pacing{};
+
     /// Event that handles screen composition.
     std::shared_ptr<Core::Timing::EventType> composition_event;
+    /// Event that signals vsync after a composition, on single core.
+    std::shared_ptr<Core::Timing::EventType> vsync_event;
 
     std::shared_ptr<std::mutex> guard;
 
@@ -0,0 +1,81 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <thread>
+#include <vector>
+
+#include "common/assert.h"
+#include "common/common_types.h"
+#include "common/logging/log.h"
+#include "common/thread.h"
+#include "core/hardware_properties.h"
+#include "core/host_affinity.h"
+#include "core/settings.h"
+
+namespace Core {
+namespace {
+
+struct AffinityLayout {
+    bool is_valid{};
+    std::array<u64, Hardware::NUM_CPU_CORES> cpu_cores{};
+    u64 gpu{};
+    u64 service{};
+};
+
+AffinityLayout MakeAffinityLayout() {
+    const std::vector<u32> cpus = Common::GetPhysicalCoreCPUs();
+    // Leave at least one physical core for the threads that aren't pinned to a core of their own
+    if (cpus.size() < Hardware::NUM_CPU_CORES + 2) {
+        LOG_WARNING(Core, "Not enough host cores to pin threads, {} physical cores available",
+                    cpus.size());
+        return {};
+    }
+    AffinityLayout layout{.is_valid = true};
+    for (std::size_t core = 0; core < Hardware::NUM_CPU_CORES; ++core) {
+        layout.cpu_cores[core] = 1ULL << cpus[core];
+    }
+    layout.gpu = 1ULL << cpus[Hardware::NUM_CPU_CORES];
+
+    const u32 num_logical_cpus = std::min(std::thread::hardware_concurrency(), 64U);
+    const u64 all_cpus = num_logical_cpus == 64 ? ~0ULL : (1ULL << num_logical_cpus) - 1;
+    layout.service = all_cpus & ~layout.gpu;
+    for (const u64 mask : layout.cpu_cores) {
+        layout.service &= ~mask;
+    }
+    LOG_INFO(Core, "Pinning host threads, cores={:#x} {:#x} {:#x} {:#x} gpu={:#x} service={:#x}",
+             layout.cpu_cores[0], layout.cpu_cores[1], layout.cpu_cores[2], layout.cpu_cores[3],
+             layout.gpu, layout.service);
+    return layout;
+}
+
+} // Anonymous namespace
+
+void PinCurrentThread(HostThreadType type, std::size_t core) {
+    if (!Settings::values.pin_host_threads) {
+        return;
+    }
+    static const AffinityLayout layout = MakeAffinityLayout();
+    if (!layout.is_valid) {
+        return;
+    }
+    u64 mask = 0;
+    switch (type) {
+    case HostThreadType::CPUCore:
+        ASSERT(core < Hardware::NUM_CPU_CORES);
+        mask = layout.cpu_cores[core];
+        break;
+    case HostThreadType::GPU:
+        mask = layout.gpu;
+        break;
+    case HostThreadType::Service:
+        mask = layout.service;
+        break;
+    }
+    if (!Common::SetCurrentThreadAffinity(mask)) {
+        LOG_WARNING(Core, "Failed to set the affinity of the current thread to {:#x}", mask);
+    }
+}
+
+} // namespace Core
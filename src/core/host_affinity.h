@@ -0,0 +1,25 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+
+namespace Core {
+
+enum class HostThreadType {
+    CPUCore, ///< Host thread running an emulated core
+    GPU,     ///< GPU command processing thread
+    Service, ///< HLE service threads and other helpers
+};
+
+/**
+ * Restricts the current host thread to its share of the host CPUs when pin_host_threads is set.
+ * Each emulated core and the GPU thread get a physical host core of their own, skipping SMT
+ * siblings where the topology is known, and service threads share the remaining logical CPUs.
+ * Nothing is pinned when the host doesn't have a spare core left for the rest of the threads.
+ */
+void PinCurrentThread(HostThreadType type, std::size_t core = 0);
+
+} // namespace Core
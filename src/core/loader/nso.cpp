@@ -2,16 +2,24 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cinttypes>
 #include <cstring>
+#include <span>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include "common/common_funcs.h"
+#include "common/common_paths.h"
 #include "common/file_util.h"
 #include "common/hex_util.h"
 #include "common/logging/log.h"
 #include "common/lz4_compression.h"
 #include "common/swap.h"
+#include "common/thread_worker.h"
 #include "core/core.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/hle/kernel/code_set.h"
@@ -35,15 +43,96 @@ struct MODHeader {
 };
 static_assert(sizeof(MODHeader) == 0x1c, "MODHeader has incorrect size.");
 
-std::vector<u8> DecompressSegment(const std::vector<u8>& compressed_data,
-                                  const NSOSegmentHeader& header) {
-    std::vector<u8> uncompressed_data =
-        Common::Compression::DecompressDataLZ4(compressed_data, header.size);
+constexpr u32 PATCHED_MODULE_MAGIC = Common::MakeMagic('Y', 'P', 'M', 'C');
+constexpr u32 PATCHED_MODULE_VERSION = 1;
 
-    ASSERT_MSG(uncompressed_data.size() == header.size, "{} != {}", header.size,
-               uncompressed_data.size());
+struct PatchedModuleHeader {
+    u32 magic;
+    u32 version;
+    u64 patch_hash;
+    u64 image_size;
+};
+static_assert(sizeof(PatchedModuleHeader) == 0x18, "PatchedModuleHeader has incorrect size.");
+
+Common::ThreadWorker& DecompressionWorkers() {
+    static Common::ThreadWorker workers(
+        std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, 3), "yuzu:NsoDecompress");
+    return workers;
+}
+
+/// Reads the segments of an NSO into the program image, decompressing them in parallel
+bool ReadSegments(const FileSys::VfsFile& file, const NSOHeader& nso_header,
+                  Kernel::PhysicalMemory& program_image) {
+    std::array<std::vector<u8>, 3> compressed_data;
+    std::array<bool, 3> is_decompressed{};
+    Common::ThreadWorker& workers = DecompressionWorkers();
+    for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
+        const NSOSegmentHeader& segment = nso_header.segments[i];
+        u8* const destination = program_image.data() + segment.location;
+        if (!nso_header.IsSegmentCompressed(i)) {
+            file.Read(destination, nso_header.segments_compressed_size[i], segment.offset);
+            is_decompressed[i] = true;
+            continue;
+        }
+        // File reads are not thread safe, only decompression runs on the workers
+        compressed_data[i] = file.ReadBytes(nso_header.segments_compressed_size[i], segment.offset);
+        workers.QueueWork([&compressed_data, &is_decompressed, destination, &segment, i] {
+            is_decompressed[i] = Common::Compression::DecompressDataLZ4(
+                compressed_data[i], std::span<u8>(destination, segment.size));
+        });
+    }
+    workers.WaitForRequests();
+
+    for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
+        if (!is_decompressed[i]) {
+            LOG_ERROR(Loader, "Failed to decompress segment {} of {}", i, file.GetName());
+            return false;
+        }
+    }
+    return true;
+}
 
-    return uncompressed_data;
+std::string GetPatchedModulePath(const std::array<u8, 0x20>& build_id) {
+    return Common::FS::SanitizePath(Common::FS::GetUserPath(Common::FS::UserPath::CacheDir) +
+                                    DIR_SEP "modules" DIR_SEP + Common::HexToString(build_id) +
+                                    ".bin");
+}
+
+/// Loads a patched program image cached by a previous boot, if its patches have not changed
+bool LoadCachedModule(const std::array<u8, 0x20>& build_id, u64 patch_hash,
+                      Kernel::PhysicalMemory& program_image) {
+    const std::string path = GetPatchedModulePath(build_id);
+    if (!Common::FS::Exists(path)) {
+        return false;
+    }
+    Common::FS::IOFile file(path, "rb");
+    PatchedModuleHeader header{};
+    if (!file.IsOpen() || file.ReadArray(&header, 1) != 1 ||
+        header.magic != PATCHED_MODULE_MAGIC || header.version != PATCHED_MODULE_VERSION ||
+        header.patch_hash != patch_hash || header.image_size != program_image.size()) {
+        return false;
+    }
+    return file.ReadBytes(program_image.data(), program_image.size()) == program_image.size();
+}
+
+void SaveCachedModule(const std::array<u8, 0x20>& build_id, u64 patch_hash,
+                      const Kernel::PhysicalMemory& program_image) {
+    const std::string path = GetPatchedModulePath(build_id);
+    if (!Common::FS::CreateFullPath(path)) {
+        LOG_ERROR(Loader, "Failed to create patched module cache directory for path={}", path);
+        return;
+    }
+    Common::FS::IOFile file(path, "wb");
+    const PatchedModuleHeader header{
+        .magic = PATCHED_MODULE_MAGIC,
+        .version = PATCHED_MODULE_VERSION,
+        .patch_hash = patch_hash,
+        .image_size = program_image.size(),
+    };
+    if (!file.IsOpen() || file.WriteObject(header) != 1 ||
+        file.WriteBytes(program_image.data(), program_image.size()) != program_image.size()) {
+        LOG_ERROR(Loader, "Failed to write patched module cache in path={}", path);
+    }
 }
 
 constexpr u32 PageAlignSize(u32 size) {
@@ -88,62 +177,99 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::Process& process, Core::S
         return std::nullopt;
     }
 
-    // Build program image
+    // Compute the program image layout, it only depends on the header
     Kernel::CodeSet codeset;
-    Kernel::PhysicalMemory program_image;
+    u32 image_data_size = 0;
     for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
-        std::vector<u8> data =
-            file.ReadBytes(nso_header.segments_compressed_size[i], nso_header.segments[i].offset);
-        if (nso_header.IsSegmentCompressed(i)) {
-            data = DecompressSegment(data, nso_header.segments[i]);
-        }
-        program_image.resize(nso_header.segments[i].location + static_cast<u32>(data.size()));
-        std::memcpy(program_image.data() + nso_header.segments[i].location, data.data(),
-                    data.size());
+        const u32 data_size = nso_header.IsSegmentCompressed(i)
+                                  ? nso_header.segments[i].size
+                                  : nso_header.segments_compressed_size[i];
+        const u32 segment_end = nso_header.segments[i].location + data_size;
+        image_data_size = std::max(image_data_size, segment_end);
         codeset.segments[i].addr = nso_header.segments[i].location;
         codeset.segments[i].offset = nso_header.segments[i].location;
         codeset.segments[i].size = nso_header.segments[i].size;
     }
 
-    if (should_pass_arguments && !Settings::values.program_args.empty()) {
-        const auto arg_data{Settings::values.program_args};
-
+    const u32 arguments_offset = image_data_size;
+    const bool pass_arguments = should_pass_arguments && !Settings::values.program_args.empty();
+    if (pass_arguments) {
         codeset.DataSegment().size += NSO_ARGUMENT_DATA_ALLOCATION_SIZE;
-        NSOArgumentHeader args_header{
-            NSO_ARGUMENT_DATA_ALLOCATION_SIZE, static_cast<u32_le>(arg_data.size()), {}};
-        const auto end_offset = program_image.size();
-        program_image.resize(static_cast<u32>(program_image.size()) +
-                             NSO_ARGUMENT_DATA_ALLOCATION_SIZE);
-        std::memcpy(program_image.data() + end_offset, &args_header, sizeof(NSOArgumentHeader));
-        std::memcpy(program_image.data() + end_offset + sizeof(NSOArgumentHeader), arg_data.data(),
-                    arg_data.size());
+        image_data_size += NSO_ARGUMENT_DATA_ALLOCATION_SIZE;
     }
 
     codeset.DataSegment().size += nso_header.segments[2].bss_size;
-    const u32 image_size{
-        PageAlignSize(static_cast<u32>(program_image.size()) + nso_header.segments[2].bss_size)};
-    program_image.resize(image_size);
+    const u32 image_size{PageAlignSize(image_data_size + nso_header.segments[2].bss_size)};
 
     for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
         codeset.segments[i].size = PageAlignSize(codeset.segments[i].size);
     }
 
-    // Apply patches if necessary
-    if (pm && (pm->HasNSOPatch(nso_header.build_id) || Settings::values.dump_nso)) {
-        std::vector<u8> pi_header;
-        pi_header.insert(pi_header.begin(), reinterpret_cast<u8*>(&nso_header),
-                         reinterpret_cast<u8*>(&nso_header) + sizeof(NSOHeader));
-        pi_header.insert(pi_header.begin() + sizeof(NSOHeader), program_image.data(),
-                         program_image.data() + program_image.size());
+    // If we aren't actually loading (i.e. just computing the process code layout), we are done
+    if (!load_into_process) {
+        return load_base + image_size;
+    }
 
-        pi_header = pm->PatchNSO(pi_header, file.GetName());
+    const auto start_time = std::chrono::steady_clock::now();
+    Kernel::PhysicalMemory program_image(image_size);
+
+    const bool has_patches = pm && pm->HasNSOPatch(nso_header.build_id);
+    const bool use_cache = has_patches && Settings::values.use_patched_module_cache &&
+                           !Settings::values.dump_nso && !pass_arguments;
+    const u64 patch_hash = use_cache ? pm->GetNSOPatchHash(nso_header.build_id) : 0;
+    const bool is_cached =
+        use_cache && LoadCachedModule(nso_header.build_id, patch_hash, program_image);
+
+    std::chrono::microseconds decompress_time{};
+    std::chrono::microseconds patch_time{};
+    if (!is_cached) {
+        // Build program image
+        if (!ReadSegments(file, nso_header, program_image)) {
+            return std::nullopt;
+        }
+        const auto decompress_end = std::chrono::steady_clock::now();
+        decompress_time =
+            std::chrono::duration_cast<std::chrono::microseconds>(decompress_end - start_time);
+
+        if (pass_arguments) {
+            const auto arg_data{Settings::values.program_args};
+            NSOArgumentHeader args_header{
+                NSO_ARGUMENT_DATA_ALLOCATION_SIZE, static_cast<u32_le>(arg_data.size()), {}};
+            std::memcpy(program_image.data() + arguments_offset, &args_header,
+                        sizeof(NSOArgumentHeader));
+            std::memcpy(program_image.data() + arguments_offset + sizeof(NSOArgumentHeader),
+                        arg_data.data(), arg_data.size());
+        }
+
+        // Apply patches if necessary
+        if (pm && (has_patches || Settings::values.dump_nso)) {
+            std::vector<u8> pi_header;
+            pi_header.reserve(sizeof(NSOHeader) + program_image.size());
+            pi_header.insert(pi_header.end(), reinterpret_cast<u8*>(&nso_header),
+                             reinterpret_cast<u8*>(&nso_header) + sizeof(NSOHeader));
+            pi_header.insert(pi_header.end(), program_image.data(),
+                             program_image.data() + program_image.size());
+
+            pi_header = pm->PatchNSO(pi_header, file.GetName());
+
+            std::copy(pi_header.begin() + sizeof(NSOHeader), pi_header.end(), program_image.data());
 
-        std::copy(pi_header.begin() + sizeof(NSOHeader), pi_header.end(), program_image.data());
+            if (use_cache) {
+                SaveCachedModule(nso_header.build_id, patch_hash, program_image);
+            }
+        }
+        patch_time = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - decompress_end);
     }
 
-    // If we aren't actually loading (i.e. just computing the process code layout), we are done
-    if (!load_into_process) {
-        return load_base + image_size;
+    const auto load_time = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start_time);
+    if (is_cached) {
+        LOG_INFO(Loader, "Loaded module {} from the patched module cache in {} us",
+                 file.GetName(), load_time.count());
+    } else {
+        LOG_INFO(Loader, "Loaded module {} in {} us ({} us reading, {} us patching)",
+                 file.GetName(), load_time.count(), decompress_time.count(), patch_time.count());
     }
 
     // Apply cheats if they exist and the program has a valid title ID
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <optional>
 #include <utility>
@@ -13,6 +14,7 @@
 #include "common/logging/log.h"
 #include "common/page_table.h"
 #include "common/swap.h"
+#include "common/write_watcher.h"
 #include "core/arm/arm_interface.h"
 #include "core/core.h"
 #include "core/device_memory.h"
@@ -31,7 +33,11 @@ struct Memory::Impl {
     explicit Impl(Core::System& system_) : system{system_} {}
 
     void SetCurrentPageTable(Kernel::Process& process, u32 core_id) {
-        current_page_table = &process.PageTable().PageTableImpl();
+        Common::PageTable* const page_table = &process.PageTable().PageTableImpl();
+        if (current_page_table != page_table) {
+            current_page_table = page_table;
+            ++mapping_generation;
+        }
 
         const std::size_t address_space_width = process.PageTable().GetAddressSpaceWidth();
 
@@ -489,6 +495,11 @@ struct Memory::Impl {
                     // space, for example, a system module need not have a VRAM mapping.
                     break;
                 case Common::PageType::Memory:
+                    if (write_watcher &&
+                        write_watcher->Watch(HostPage(vaddr), vaddr & ~PAGE_MASK)) {
+                        // Keep the pointer, the host catches the first write to the page
+                        break;
+                    }
                     current_page_table->pointers[vaddr >> PAGE_BITS].Store(
                         nullptr, Common::PageType::RasterizerCachedMemory);
                     break;
@@ -509,6 +520,9 @@ struct Memory::Impl {
                 case Common::PageType::Memory:
                     // There can be more than one GPU region mapped per CPU region, so it's common
                     // that this area is already unmarked as cached.
+                    if (write_watcher) {
+                        write_watcher->Unwatch(HostPage(vaddr), vaddr & ~PAGE_MASK);
+                    }
                     break;
                 case Common::PageType::RasterizerCachedMemory: {
                     u8* const pointer{GetPointerFromRasterizerCachedMemory(vaddr & ~PAGE_MASK)};
@@ -531,6 +545,47 @@ struct Memory::Impl {
         }
     }
 
+    void SetHostWriteTracking(bool enabled) {
+        write_watcher.reset();
+        if (!enabled) {
+            return;
+        }
+        write_watcher = Common::WriteWatcher::Create(
+            system.DeviceMemory().GetPointer(DramMemoryMap::Base), DramMemoryMap::Size);
+        if (!write_watcher) {
+            LOG_WARNING(HW_Memory, "Host write tracking is not supported on this host");
+        }
+    }
+
+    std::size_t CollectHostWrites(std::vector<VAddr>& pages) {
+        if (!write_watcher) {
+            return 0;
+        }
+        return write_watcher->CollectWrites(pages);
+    }
+
+    std::span<u8> GetHostSpan(VAddr vaddr, std::size_t size) const {
+        const auto& backing_addr = current_page_table->backing_addr;
+        const PAddr backing = backing_addr[vaddr >> PAGE_BITS];
+        if (!backing) {
+            return {};
+        }
+        // Pages contiguous in host memory share the same backing address, as it is stored
+        // relative to the virtual address of each page
+        const VAddr end = vaddr + size;
+        VAddr page = (vaddr & ~PAGE_MASK) + PAGE_SIZE;
+        while (page < end && backing_addr[page >> PAGE_BITS] == backing) {
+            page += PAGE_SIZE;
+        }
+        return {system.DeviceMemory().GetPointer(backing) + vaddr, std::min(page, end) - vaddr};
+    }
+
+    /// Returns the host pointer to the start of a page mapped as memory in the current page table
+    u8* HostPage(VAddr vaddr) const {
+        const VAddr page_base = vaddr & ~PAGE_MASK;
+        return current_page_table->pointers[vaddr >> PAGE_BITS].Pointer() + page_base;
+    }
+
     /**
      * Maps a region of pages as a specific type.
      *
@@ -550,8 +605,15 @@ struct Memory::Impl {
             auto& gpu = system.GPU();
             for (u64 i = 0; i < size; i++) {
                 const auto page = base + i;
-                if (page_table.pointers[page].Type() == Common::PageType::RasterizerCachedMemory) {
+                const auto [pointer, page_type] = page_table.pointers[page].PointerType();
+                if (page_type == Common::PageType::RasterizerCachedMemory) {
                     gpu.FlushAndInvalidateRegion(page << PAGE_BITS, PAGE_SIZE);
+                } else if (write_watcher && page_type == Common::PageType::Memory) {
+                    u8* const host_page = pointer + (page << PAGE_BITS);
+                    if (write_watcher->IsWatched(host_page, page << PAGE_BITS)) {
+                        gpu.FlushAndInvalidateRegion(page << PAGE_BITS, PAGE_SIZE);
+                        write_watcher->Unwatch(host_page, page << PAGE_BITS);
+                    }
                 }
             }
         }
@@ -583,6 +645,7 @@ struct Memory::Impl {
                 target += PAGE_SIZE;
             }
         }
+        ++mapping_generation;
     }
 
     /**
@@ -719,6 +782,8 @@ struct Memory::Impl {
     }
 
     Common::PageTable* current_page_table = nullptr;
+    std::unique_ptr<Common::WriteWatcher> write_watcher;
+    std::atomic<u64> mapping_generation{};
     Core::System& system;
 };
 
@@ -867,6 +932,22 @@ void Memory::RasterizerMarkRegionCached(VAddr vaddr, u64 size, bool cached) {
     impl->RasterizerMarkRegionCached(vaddr, size, cached);
 }
 
+void Memory::SetHostWriteTracking(bool enabled) {
+    impl->SetHostWriteTracking(enabled);
+}
+
+std::size_t Memory::CollectHostWrites(std::vector<VAddr>& pages) {
+    return impl->CollectHostWrites(pages);
+}
+
+std::span<u8> Memory::GetHostSpan(VAddr vaddr, std::size_t size) const {
+    return impl->GetHostSpan(vaddr, size);
+}
+
+u64 Memory::GetMappingGeneration() const {
+    return impl->mapping_generation.load(std::memory_order_acquire);
+}
+
 bool IsKernelVirtualAddress(const VAddr vaddr) {
     return KERNEL_REGION_VADDR <= vaddr && vaddr < KERNEL_REGION_END;
 }
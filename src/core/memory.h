@@ -6,7 +6,9 @@
 
 #include <cstddef>
 #include <memory>
+#include <span>
 #include <string>
+#include <vector>
 #include "common/common_types.h"
 
 namespace Common {
@@ -513,6 +515,43 @@ public:
      */
     void RasterizerMarkRegionCached(VAddr vaddr, u64 size, bool cached);
 
+    /**
+     * Enables or disables detecting CPU writes to rasterizer cached pages by write protecting
+     * them on the host. Cached pages then keep their pointer, so reading them stays on the fast
+     * path. Must only be called while no pages are marked as cached.
+     *
+     * @param enabled Whether or not host write tracking should be used.
+     */
+    void SetHostWriteTracking(bool enabled);
+
+    /**
+     * Appends the rasterizer cached pages written by the CPU since the last call and tracks them
+     * again. Only used when host write tracking is enabled.
+     *
+     * @param pages Receives the virtual address of each written page.
+     *
+     * @returns The number of pages appended.
+     */
+    std::size_t CollectHostWrites(std::vector<VAddr>& pages);
+
+    /**
+     * Gets the host memory backing a region of the current process' address space. Rasterizer
+     * cached pages are included and are not flushed.
+     *
+     * @param vaddr The virtual address of the region.
+     * @param size  The size of the region in bytes.
+     *
+     * @returns The leading part of the region that is contiguous in host memory, or an empty span
+     *          if vaddr is not mapped.
+     */
+    std::span<u8> GetHostSpan(VAddr vaddr, std::size_t size) const;
+
+    /**
+     * Returns a counter incremented whenever a mapping of the current page table changes, so host
+     * memory obtained with GetHostSpan can be cached while the counter stays the same.
+     */
+    u64 GetMappingGeneration() const;
+
 private:
     struct Impl;
     std::unique_ptr<Impl> impl;
@@ -33,6 +33,7 @@ public:
     u64 HidKeysDown() override;
     void DebugLog(u8 id, u64 value) override;
     void CommandLog(std::string_view data) override;
+    bool IsCommandLogEnabled() override;
 
 private:
     VAddr SanitizeAddress(VAddr address) const;
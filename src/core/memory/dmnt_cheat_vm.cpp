@@ -641,13 +641,47 @@ bool DmntCheatVm::DecodeNextOpcode(CheatVmOpcode& out) {
     return valid;
 }
 
+void DmntCheatVm::DecodeProgram() {
+    decoded_program.clear();
+    decoded_indices.fill(NotDecoded);
+
+    // Execution only ever resumes at the start of the program, after a decoded opcode or at a
+    // loop top, which is itself after a decoded opcode. Decoding linearly from the start until
+    // the first invalid opcode therefore covers every instruction pointer the VM can reach.
+    instruction_ptr = 0;
+    decode_success = true;
+    std::size_t opcode_start = instruction_ptr;
+    CheatVmOpcode opcode{};
+    while (DecodeNextOpcode(opcode)) {
+        decoded_indices[opcode_start] = static_cast<u16>(decoded_program.size());
+        decoded_program.push_back({
+            .opcode = opcode,
+            .next_instruction = instruction_ptr,
+        });
+        opcode_start = instruction_ptr;
+    }
+    ResetState();
+}
+
+const CheatVmOpcode* DmntCheatVm::FetchNextOpcode() {
+    // Fetching fails from the first opcode that could not be decoded onwards, like decoding would.
+    if (!decode_success || instruction_ptr >= num_opcodes ||
+        decoded_indices[instruction_ptr] == NotDecoded) {
+        decode_success = false;
+        return nullptr;
+    }
+    const DecodedOpcode& decoded = decoded_program[decoded_indices[instruction_ptr]];
+    instruction_ptr = decoded.next_instruction;
+    return &decoded.opcode;
+}
+
 void DmntCheatVm::SkipConditionalBlock() {
     if (condition_depth > 0) {
         // We want to continue until we're out of the current block.
         const std::size_t desired_depth = condition_depth - 1;
 
-        CheatVmOpcode skip_opcode{};
-        while (condition_depth > desired_depth && DecodeNextOpcode(skip_opcode)) {
+        const CheatVmOpcode* skip_opcode{};
+        while (condition_depth > desired_depth && (skip_opcode = FetchNextOpcode()) != nullptr) {
             // Decode instructions until we see end of the current conditional block.
             // NOTE: This is broken in gateway's implementation.
             // Gateway currently checks for "0x2" instead of "0x20000000"
@@ -655,9 +689,9 @@ void DmntCheatVm::SkipConditionalBlock() {
             // This causes issues if "0x2" appears as an immediate in the conditional block...
 
             // We also support nesting of conditional blocks, and Gateway does not.
-            if (skip_opcode.begin_conditional_block) {
+            if (skip_opcode->begin_conditional_block) {
                 condition_depth++;
-            } else if (std::holds_alternative<EndConditionalOpcode>(skip_opcode.opcode)) {
+            } else if (std::holds_alternative<EndConditionalOpcode>(skip_opcode->opcode)) {
                 condition_depth--;
             }
         }
@@ -717,6 +751,7 @@ bool DmntCheatVm::LoadProgram(const std::vector<CheatEntry>& entries) {
             // Bounds check.
             if (entries[i].definition.num_opcodes + num_opcodes > MaximumProgramOpcodeCount) {
                 num_opcodes = 0;
+                DecodeProgram();
                 return false;
             }
 
@@ -726,36 +761,45 @@ bool DmntCheatVm::LoadProgram(const std::vector<CheatEntry>& entries) {
         }
     }
 
+    // Decode once here instead of on every execution.
+    DecodeProgram();
     return true;
 }
 
 void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
-    CheatVmOpcode cur_opcode{};
-
     // Get Keys down.
     u64 kDown = callbacks->HidKeysDown();
 
-    callbacks->CommandLog("Started VM execution.");
-    callbacks->CommandLog(fmt::format("Main NSO:  {:012X}", metadata.main_nso_extents.base));
-    callbacks->CommandLog(fmt::format("Heap:      {:012X}", metadata.main_nso_extents.base));
-    callbacks->CommandLog(fmt::format("Keys Down: {:08X}", static_cast<u32>(kDown & 0x0FFFFFFF)));
+    // Formatting the trace dominates execution time, only do it when someone is listening.
+    const bool log_commands = callbacks->IsCommandLogEnabled();
+    if (log_commands) {
+        callbacks->CommandLog("Started VM execution.");
+        callbacks->CommandLog(fmt::format("Main NSO:  {:012X}", metadata.main_nso_extents.base));
+        callbacks->CommandLog(fmt::format("Heap:      {:012X}", metadata.main_nso_extents.base));
+        callbacks->CommandLog(
+            fmt::format("Keys Down: {:08X}", static_cast<u32>(kDown & 0x0FFFFFFF)));
+    }
 
     // Clear VM state.
     ResetState();
 
     // Loop until program finishes.
-    while (DecodeNextOpcode(cur_opcode)) {
-        callbacks->CommandLog(
-            fmt::format("Instruction Ptr: {:04X}", static_cast<u32>(instruction_ptr)));
+    while (const CheatVmOpcode* const next_opcode = FetchNextOpcode()) {
+        const CheatVmOpcode& cur_opcode = *next_opcode;
+        if (log_commands) {
+            callbacks->CommandLog(
+                fmt::format("Instruction Ptr: {:04X}", static_cast<u32>(instruction_ptr)));
 
-        for (std::size_t i = 0; i < NumRegisters; i++) {
-            callbacks->CommandLog(fmt::format("Registers[{:02X}]: {:016X}", i, registers[i]));
-        }
+            for (std::size_t i = 0; i < NumRegisters; i++) {
+                callbacks->CommandLog(fmt::format("Registers[{:02X}]: {:016X}", i, registers[i]));
+            }
 
-        for (std::size_t i = 0; i < NumRegisters; i++) {
-            callbacks->CommandLog(fmt::format("SavedRegs[{:02X}]: {:016X}", i, saved_values[i]));
+            for (std::size_t i = 0; i < NumRegisters; i++) {
+                callbacks->CommandLog(
+                    fmt::format("SavedRegs[{:02X}]: {:016X}", i, saved_values[i]));
+            }
+            LogOpcode(cur_opcode);
         }
-        LogOpcode(cur_opcode);
 
         // Increment conditional depth, if relevant.
         if (cur_opcode.begin_conditional_block) {
@@ -781,7 +825,7 @@ void DmntCheatVm::Execute(const CheatProcessMetadata& metadata) {
             u64 src_address =
                 GetCheatProcessAddress(metadata, begin_cond->mem_type, begin_cond->rel_address);
             u64 src_value = 0;
-            switch (store_static->bit_width) {
+            switch (begin_cond->bit_width) {
             case 1:
             case 2:
             case 4:
@@ -284,6 +284,9 @@ public:
 
         virtual void DebugLog(u8 id, u64 value) = 0;
         virtual void CommandLog(std::string_view data) = 0;
+
+        /// Returns true if CommandLog output is consumed, so the VM can skip formatting it.
+        virtual bool IsCommandLogEnabled() = 0;
     };
 
     static constexpr std::size_t MaximumProgramOpcodeCount = 0x400;
@@ -304,6 +307,14 @@ public:
     void Execute(const CheatProcessMetadata& metadata);
 
 private:
+    /// Opcode decoded ahead of time by LoadProgram.
+    struct DecodedOpcode {
+        CheatVmOpcode opcode;
+        std::size_t next_instruction;
+    };
+
+    static constexpr u16 NotDecoded = 0xFFFF;
+
     std::unique_ptr<Callbacks> callbacks;
 
     std::size_t num_opcodes = 0;
@@ -316,7 +327,14 @@ private:
     std::array<u64, NumStaticRegisters> static_registers{};
     std::array<std::size_t, NumRegisters> loop_tops{};
 
+    /// Opcodes of the loaded program in program order.
+    std::vector<DecodedOpcode> decoded_program;
+    /// Index in decoded_program of the opcode starting at each program dword, or NotDecoded.
+    std::array<u16, MaximumProgramOpcodeCount> decoded_indices{};
+
     bool DecodeNextOpcode(CheatVmOpcode& out);
+    void DecodeProgram();
+    const CheatVmOpcode* FetchNextOpcode();
     void SkipConditionalBlock();
     void ResetState();
 
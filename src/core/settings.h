@@ -31,12 +31,22 @@ enum class GPUAccuracy : u32 {
     Extreme = 2,
 };
 
+enum class QueryResolution : u32 {
+    Accurate = 0,     ///< Reading a pending query waits for the host GPU
+    Conservative = 1, ///< Reading a pending query returns its last result or reports it visible
+};
+
 enum class CPUAccuracy {
     Accurate = 0,
     Unsafe = 1,
     DebugMode = 2,
 };
 
+enum class CPUIdlePolicy : u32 {
+    Park = 0,     ///< Idle cores block until they are interrupted
+    Adaptive = 1, ///< Idle cores spin for about as long as recent wake ups took before blocking
+};
+
 template <typename Type>
 class Setting final {
 public:
@@ -116,6 +126,11 @@ struct Values {
 
     // Core
     Setting<bool> use_multi_core;
+    CPUIdlePolicy cpu_idle_policy;
+    // Pins emulated cores and the GPU thread to their own physical host cores
+    bool pin_host_threads;
+    // Caches patched NSO modules on disk to skip decompression and patching on the next boot
+    bool use_patched_module_cache;
 
     // Cpu
     CPUAccuracy cpu_accuracy;
@@ -146,12 +161,21 @@ struct Values {
     Setting<bool> use_disk_shader_cache;
     Setting<GPUAccuracy> gpu_accuracy;
     Setting<bool> use_asynchronous_gpu_emulation;
+    Setting<QueryResolution> query_resolution;
     Setting<bool> use_nvdec_emulation;
     Setting<bool> use_vsync;
     Setting<bool> use_assembly_shaders;
     Setting<bool> use_asynchronous_shaders;
     Setting<bool> use_fast_gpu_time;
 
+    // Time before each vsync at which the screen composition begins, 0 composes at frame start
+    u16 composition_target_latency_us;
+    bool unlock_framerate;
+    // Stores ASTC textures as BC7 when the host doesn't support ASTC, instead of RGBA8
+    bool transcode_astc_to_bc7;
+    // Hashes guest texture contents to skip uploads of contents already present on the host
+    bool deduplicate_texture_uploads;
+
     Setting<float> bg_red;
     Setting<float> bg_green;
     Setting<float> bg_blue;
@@ -220,6 +244,10 @@ struct Values {
     bool reporting_services;
     bool quest_flag;
     bool disable_macro_jit;
+    bool use_host_write_tracking;
+    bool enable_jit_perf_map;
+    bool enable_guest_profiler;
+    bool enable_jit_block_profile;
     bool extended_logging;
 
     // Miscellaneous
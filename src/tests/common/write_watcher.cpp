@@ -0,0 +1,101 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/virtual_buffer.h"
+#include "common/write_watcher.h"
+
+namespace Common {
+
+namespace {
+constexpr std::size_t NUM_PAGES = 16;
+constexpr u64 TAG_BASE = 0x10000;
+
+u64 Tag(std::size_t page) {
+    return TAG_BASE + page * WriteWatcher::PAGE_SIZE;
+}
+} // Anonymous namespace
+
+TEST_CASE("WriteWatcher: Reports the first write to each page", "[common]") {
+    VirtualBuffer<u8> buffer(NUM_PAGES * WriteWatcher::PAGE_SIZE);
+    const auto watcher = WriteWatcher::Create(buffer.data(), buffer.size());
+    if (!watcher) {
+        // Unsupported host
+        return;
+    }
+    const auto page = [&](std::size_t index) {
+        return buffer.data() + index * WriteWatcher::PAGE_SIZE;
+    };
+
+    REQUIRE(watcher->Watch(page(1), Tag(1)));
+    REQUIRE(watcher->Watch(page(3), Tag(3)));
+    REQUIRE(watcher->Watch(page(3), Tag(3)));
+    REQUIRE(!watcher->Watch(page(3), Tag(4)));
+    REQUIRE(watcher->IsWatched(page(1), Tag(1)));
+    REQUIRE(!watcher->IsWatched(page(2), Tag(2)));
+
+    // Reads do not fault
+    REQUIRE(page(1)[0] == 0);
+
+    std::vector<u64> tags;
+    REQUIRE(watcher->CollectWrites(tags) == 0);
+
+    page(1)[0] = 1;
+    page(1)[8] = 2;
+    page(2)[0] = 3;
+    REQUIRE(watcher->CollectWrites(tags) == 1);
+    REQUIRE(tags == std::vector<u64>{Tag(1)});
+
+    // Collecting protects the page again
+    tags.clear();
+    page(1)[16] = 4;
+    page(3)[16] = 5;
+    REQUIRE(watcher->CollectWrites(tags) == 2);
+    std::sort(tags.begin(), tags.end());
+    REQUIRE(tags == std::vector<u64>{Tag(1), Tag(3)});
+    REQUIRE(page(1)[0] == 1);
+    REQUIRE(page(1)[16] == 4);
+
+    // Unwatched pages are writable and not reported
+    tags.clear();
+    watcher->Unwatch(page(1), Tag(1));
+    page(1)[0] = 6;
+    REQUIRE(!watcher->IsWatched(page(1), Tag(1)));
+    REQUIRE(watcher->CollectWrites(tags) == 0);
+}
+
+TEST_CASE("WriteWatcher: Concurrent writers", "[common]") {
+    VirtualBuffer<u8> buffer(NUM_PAGES * WriteWatcher::PAGE_SIZE);
+    const auto watcher = WriteWatcher::Create(buffer.data(), buffer.size());
+    if (!watcher) {
+        return;
+    }
+    for (std::size_t i = 0; i < NUM_PAGES; ++i) {
+        REQUIRE(watcher->Watch(buffer.data() + i * WriteWatcher::PAGE_SIZE, Tag(i)));
+    }
+
+    std::vector<std::thread> threads;
+    for (std::size_t thread = 0; thread < 4; ++thread) {
+        threads.emplace_back([&, thread] {
+            for (std::size_t i = 0; i < buffer.size(); i += 64) {
+                buffer[i + thread] = static_cast<u8>(i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<u64> tags;
+    REQUIRE(watcher->CollectWrites(tags) == NUM_PAGES);
+    std::sort(tags.begin(), tags.end());
+    for (std::size_t i = 0; i < NUM_PAGES; ++i) {
+        REQUIRE(tags[i] == Tag(i));
+    }
+}
+
+} // namespace Common
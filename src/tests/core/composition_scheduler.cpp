@@ -0,0 +1,107 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <catch2/catch.hpp>
+#include "core/hle/service/nvflinger/composition_scheduler.h"
+
+namespace Service::NVFlinger {
+
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr std::chrono::nanoseconds FRAME_PERIOD = 16ms;
+
+/// Composes once at the given time with the given duration and returns the next scheduled time.
+std::chrono::nanoseconds Compose(CompositionScheduler& scheduler, std::chrono::nanoseconds time,
+                                 std::chrono::nanoseconds duration) {
+    scheduler.BeginComposition(time);
+    scheduler.EndComposition(time + duration);
+    return scheduler.NextCompositionTime(FRAME_PERIOD);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("CompositionScheduler: Fixed rate", "[core]") {
+    CompositionScheduler scheduler;
+
+    // The first composition anchors the vsync grid, following ones begin once per period and
+    // signal vsync as soon as they finish
+    auto time = Compose(scheduler, 0ms, 1ms);
+    REQUIRE(time == FRAME_PERIOD);
+    REQUIRE(scheduler.VSyncTime() == 1ms);
+    for (int frame = 1; frame < 10; ++frame) {
+        const auto next_time = Compose(scheduler, time, 1ms);
+        REQUIRE(next_time - time == FRAME_PERIOD);
+        REQUIRE(scheduler.VSyncTime() == time + 1ms);
+        time = next_time;
+    }
+
+    const auto stats = scheduler.GetAndResetStatistics();
+    REQUIRE(stats.frames == 9);
+    REQUIRE(stats.missed_deadlines == 0);
+    REQUIRE(stats.max_jitter == 0ms);
+}
+
+TEST_CASE("CompositionScheduler: Target latency", "[core]") {
+    CompositionScheduler scheduler{4ms};
+
+    // Deadlines are at 4ms, 20ms, 36ms... and compositions should begin 4ms before them, while
+    // vsync is only signalled at the deadline
+    auto time = Compose(scheduler, 0ms, 1ms);
+    REQUIRE(time == 16ms);
+    REQUIRE(scheduler.VSyncTime() == 4ms);
+    time = Compose(scheduler, time, 1ms);
+    REQUIRE(time == 32ms);
+    REQUIRE(scheduler.VSyncTime() == 20ms);
+
+    // Compositions slower than the target latency are started earlier, and their vsync is
+    // signalled once they finish
+    time = Compose(scheduler, time, 6ms);
+    REQUIRE(time == 52ms - 6ms - 500us);
+    REQUIRE(scheduler.VSyncTime() == 38ms);
+}
+
+TEST_CASE("CompositionScheduler: Missed deadlines", "[core]") {
+    CompositionScheduler scheduler{4ms};
+
+    auto time = Compose(scheduler, 0ms, 1ms);
+    REQUIRE(time == 16ms);
+
+    // A composition overrunning several frames skips the missed vsyncs instead of catching up
+    time = Compose(scheduler, time, 40ms);
+    REQUIRE(time == 56ms);
+    REQUIRE(scheduler.VSyncTime() == 56ms);
+    REQUIRE(scheduler.GetAndResetStatistics().missed_deadlines == 1);
+}
+
+TEST_CASE("CompositionScheduler: Late wakeups", "[core]") {
+    CompositionScheduler scheduler;
+
+    auto time = Compose(scheduler, 0ms, 0ms);
+    for (int frame = 0; frame < 32; ++frame) {
+        // Consistently wake up 1ms later than requested
+        time = Compose(scheduler, time + 1ms, 0ms);
+    }
+
+    // The scheduler compensates by asking to be woken up earlier
+    const auto next_time = Compose(scheduler, time + 1ms, 0ms);
+    REQUIRE(next_time - (time + 1ms) < FRAME_PERIOD);
+    REQUIRE(scheduler.GetAndResetStatistics().max_jitter == 1ms);
+}
+
+TEST_CASE("CompositionScheduler: Unlocked", "[core]") {
+    CompositionScheduler scheduler{0ms, true};
+
+    // Compositions are paced by their own duration instead of the frame period
+    auto time = Compose(scheduler, 0ms, 5ms);
+    for (int frame = 0; frame < 4; ++frame) {
+        const auto next_time = Compose(scheduler, time, 5ms);
+        REQUIRE(next_time - time == 5ms + 500us);
+        time = next_time;
+    }
+}
+
+} // namespace Service::NVFlinger
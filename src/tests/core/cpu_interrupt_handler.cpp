@@ -0,0 +1,92 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/arm/cpu_interrupt_handler.h"
+#include "core/settings.h"
+
+namespace {
+
+using Settings::CPUIdlePolicy;
+
+constexpr std::array POLICIES{CPUIdlePolicy::Park, CPUIdlePolicy::Adaptive};
+
+const char* PolicyName(CPUIdlePolicy policy) {
+    return policy == CPUIdlePolicy::Park ? "park" : "adaptive";
+}
+
+/**
+ * Bounces an interrupt between two handlers, like two emulated cores waking each other up.
+ * Returns the average time between raising an interrupt and the waiting thread resuming.
+ */
+std::chrono::nanoseconds PingPong(CPUIdlePolicy policy, u32 num_round_trips) {
+    Core::CPUInterruptHandler ping;
+    Core::CPUInterruptHandler pong;
+    ping.SetIdlePolicy(policy);
+    pong.SetIdlePolicy(policy);
+
+    std::atomic<u32> num_pongs{};
+    std::thread thread([&] {
+        for (u32 i = 0; i < num_round_trips; ++i) {
+            while (!pong.IsInterrupted()) {
+                pong.AwaitInterrupt();
+            }
+            pong.SetInterrupt(false);
+            ++num_pongs;
+            ping.SetInterrupt(true);
+        }
+    });
+    const auto start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < num_round_trips; ++i) {
+        pong.SetInterrupt(true);
+        while (!ping.IsInterrupted()) {
+            ping.AwaitInterrupt();
+        }
+        ping.SetInterrupt(false);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    thread.join();
+    REQUIRE(num_pongs == num_round_trips);
+    // Each round trip wakes up a waiting thread twice
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed) / (num_round_trips * 2);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("CPUInterruptHandler: Pending interrupts are not lost", "[core]") {
+    for (const CPUIdlePolicy policy : POLICIES) {
+        Core::CPUInterruptHandler handler;
+        handler.SetIdlePolicy(policy);
+        // Raised before waiting, must return without blocking
+        handler.SetInterrupt(true);
+        handler.AwaitInterrupt();
+        REQUIRE(handler.IsInterrupted());
+        handler.SetInterrupt(false);
+        REQUIRE(!handler.IsInterrupted());
+    }
+}
+
+TEST_CASE("CPUInterruptHandler: Waiters wake up", "[core]") {
+    for (const CPUIdlePolicy policy : POLICIES) {
+        INFO("Policy " << PolicyName(policy));
+        PingPong(policy, 1000);
+    }
+}
+
+TEST_CASE("CPUInterruptHandler: Wake up latency", "[.][core][benchmark]") {
+    constexpr u32 num_round_trips = 100000;
+    for (const CPUIdlePolicy policy : POLICIES) {
+        const auto latency = PingPong(policy, num_round_trips);
+        WARN("Policy " << PolicyName(policy) << ": " << latency.count()
+                       << " ns per wake up, " << 1e9 / static_cast<double>(latency.count())
+                       << " wake ups/s");
+    }
+}
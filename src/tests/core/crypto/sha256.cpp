@@ -0,0 +1,47 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <string_view>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/hex_util.h"
+#include "core/crypto/sha256.h"
+
+namespace Core::Crypto {
+
+TEST_CASE("SHA256Hasher: Known digests", "[core]") {
+    SHA256Hasher hasher;
+    REQUIRE(Common::HexToString(hasher.Finish(), false) ==
+            "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+
+    constexpr std::string_view abc = "abc";
+    hasher.Update(std::span{reinterpret_cast<const u8*>(abc.data()), abc.size()});
+    REQUIRE(Common::HexToString(hasher.Finish(), false) ==
+            "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+}
+
+TEST_CASE("SHA256Hasher: Chunked updates", "[core]") {
+    std::vector<u8> data(1000);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<u8>(i * 7);
+    }
+    constexpr std::string_view expected =
+        "89f4ff56a25dd1db06a4ce6033603775d705fb96f30f8693733fef602a1ca532";
+
+    // Chunk sizes that are smaller than, equal to and not aligned with the block size
+    for (const std::size_t chunk_size : {std::size_t{1}, std::size_t{63}, std::size_t{64},
+                                         std::size_t{100}, data.size()}) {
+        SHA256Hasher hasher;
+        for (std::size_t offset = 0; offset < data.size(); offset += chunk_size) {
+            const std::size_t size = std::min(chunk_size, data.size() - offset);
+            hasher.Update(std::span{data}.subspan(offset, size));
+        }
+        REQUIRE(Common::HexToString(hasher.Finish(), false) == expected);
+    }
+}
+
+} // namespace Core::Crypto
@@ -0,0 +1,154 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/file_sys/layered_fs_index.h"
+#include "core/file_sys/mode.h"
+#include "core/file_sys/romfs.h"
+#include "core/file_sys/vfs_layered.h"
+#include "core/file_sys/vfs_real.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace {
+
+using namespace FileSys;
+
+VirtualFile MakeFile(std::string name, std::size_t size, u8 value) {
+    return std::make_shared<VectorVfsFile>(std::vector<u8>(size, value), std::move(name));
+}
+
+void WriteHostFile(const std::filesystem::path& path, const std::string& contents) {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream file(path, std::ios::binary);
+    file << contents;
+}
+
+/// Moves the modification time of every directory to the past, so they are not considered unstable
+void AgeDirectories(const std::filesystem::path& root, std::chrono::hours age) {
+    const auto time = std::filesystem::file_time_type::clock::now() - age;
+    std::filesystem::last_write_time(root, time);
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root)) {
+        if (entry.is_directory()) {
+            std::filesystem::last_write_time(entry.path(), time);
+        }
+    }
+}
+
+class LayeredFSFixture {
+public:
+    LayeredFSFixture() {
+        root = std::filesystem::temp_directory_path() / "yuzu_layered_fs_index";
+        std::filesystem::remove_all(root);
+
+        const auto data = std::make_shared<VectorVfsDirectory>(
+            std::vector<VirtualFile>{MakeFile("c.bin", 300, 3)}, std::vector<VirtualDir>{},
+            "data");
+        const auto hidden = std::make_shared<VectorVfsDirectory>(
+            std::vector<VirtualFile>{MakeFile("d.bin", 400, 4)}, std::vector<VirtualDir>{},
+            "hidden");
+        const auto base_dir = std::make_shared<VectorVfsDirectory>(
+            std::vector<VirtualFile>{MakeFile("a.bin", 100, 1), MakeFile("b.bin", 200, 2)},
+            std::vector<VirtualDir>{data, hidden}, "romfs");
+        romfs = CreateRomFS(base_dir);
+        base = ExtractRomFS(romfs);
+
+        WriteHostFile(root / "mod1" / "romfs" / "a.bin", std::string(150, 'a'));
+        WriteHostFile(root / "mod1" / "romfs" / "data" / "e.bin", std::string(50, 'e'));
+        WriteHostFile(root / "mod2" / "romfs" / "a.bin", std::string(10, 'x'));
+        WriteHostFile(root / "mod2" / "romfs" / "b.bin", std::string(250, 'b'));
+        WriteHostFile(root / "mod1" / "romfs_ext" / "hidden.stub", "");
+        // IPS patch writing "zz" at offset 1 of data/c.bin
+        WriteHostFile(root / "mod1" / "romfs_ext" / "data" / "c.bin.ips",
+                      std::string("PATCH\0\0\x01\0\x02zzEOF", 14));
+        AgeDirectories(root, std::chrono::hours{2});
+    }
+
+    ~LayeredFSFixture() {
+        std::filesystem::remove_all(root);
+    }
+
+    std::vector<VirtualDir> Layers(const char* name) {
+        return {filesystem.OpenDirectory((root / "mod1" / name).string(), Mode::Read),
+                filesystem.OpenDirectory((root / "mod2" / name).string(), Mode::Read)};
+    }
+
+    /// Builds the RomFS through the layered directories, as done without an index
+    std::vector<u8> BuildReference() {
+        auto layers = Layers("romfs");
+        layers.push_back(base);
+        const auto ext = filesystem.OpenDirectory((root / "mod1" / "romfs_ext").string(),
+                                                  Mode::Read);
+        return CreateRomFS(LayeredVfsDirectory::MakeLayeredDirectory(std::move(layers)), ext)
+            ->ReadAllBytes();
+    }
+
+    std::vector<u8> BuildIndexed(LayeredFSIndexStatistics& statistics) {
+        const std::vector<VirtualDir> ext_layers{
+            filesystem.OpenDirectory((root / "mod1" / "romfs_ext").string(), Mode::Read)};
+        const auto packed = CreateLayeredRomFS(romfs, base, Layers("romfs"), ext_layers,
+                                               (root / "index.bin").string(), &statistics);
+        REQUIRE(packed != nullptr);
+        return packed->ReadAllBytes();
+    }
+
+    std::filesystem::path root;
+    RealVfsFilesystem filesystem;
+    VirtualFile romfs;
+    VirtualDir base;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("LayeredFSIndex: Cold and warm builds match the layered directories", "[core]") {
+    LayeredFSFixture fixture;
+    const std::vector<u8> reference = fixture.BuildReference();
+
+    LayeredFSIndexStatistics statistics;
+    REQUIRE(fixture.BuildIndexed(statistics) == reference);
+    REQUIRE(!statistics.is_warm);
+    REQUIRE(statistics.num_listed_layers == 3);
+    REQUIRE(statistics.num_files == 4);
+
+    REQUIRE(fixture.BuildIndexed(statistics) == reference);
+    REQUIRE(statistics.is_warm);
+    REQUIRE(statistics.num_listed_layers == 0);
+}
+
+TEST_CASE("LayeredFSIndex: Only modified layers are listed again", "[core]") {
+    LayeredFSFixture fixture;
+    LayeredFSIndexStatistics statistics;
+    (void)fixture.BuildIndexed(statistics);
+
+    WriteHostFile(fixture.root / "mod2" / "romfs" / "data" / "f.bin", std::string(70, 'f'));
+    AgeDirectories(fixture.root / "mod2", std::chrono::hours{1});
+
+    REQUIRE(fixture.BuildIndexed(statistics) == fixture.BuildReference());
+    REQUIRE(!statistics.is_warm);
+    REQUIRE(statistics.num_listed_layers == 1);
+    REQUIRE(statistics.num_files == 5);
+}
+
+TEST_CASE("LayeredFSIndex: Files resized in place invalidate the layout", "[core]") {
+    LayeredFSFixture fixture;
+    LayeredFSIndexStatistics statistics;
+    (void)fixture.BuildIndexed(statistics);
+
+    // Rewriting a file does not change the modification time of its directory
+    const auto directory = fixture.root / "mod1" / "romfs";
+    const auto directory_time = std::filesystem::last_write_time(directory);
+    WriteHostFile(directory / "a.bin", std::string(500, 'a'));
+    std::filesystem::last_write_time(directory, directory_time);
+
+    REQUIRE(fixture.BuildIndexed(statistics) == fixture.BuildReference());
+    REQUIRE(!statistics.is_warm);
+    REQUIRE(statistics.num_listed_layers == 0);
+}
@@ -0,0 +1,90 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/hle/ipc.h"
+#include "core/hle/kernel/hle_ipc.h"
+
+namespace {
+
+using Kernel::HLERequestContext;
+
+/// Guest memory where every byte holds the low bits of its address
+class GuestMemory {
+public:
+    GuestMemory() {
+        std::iota(data.begin(), data.end(), u8{0});
+    }
+
+    void ReadBlock(VAddr address, void* dest_buffer, std::size_t size) {
+        std::memcpy(dest_buffer, data.data() + address, size);
+        ++num_reads;
+    }
+
+    std::array<u8, 0x100> data{};
+    int num_reads = 0;
+};
+
+IPC::BufferDescriptorABW MakeBufferA(VAddr address, u32 size) {
+    IPC::BufferDescriptorABW descriptor{};
+    descriptor.address_bits_0_31 = static_cast<u32>(address);
+    descriptor.size_bits_0_31 = size;
+    return descriptor;
+}
+
+IPC::BufferDescriptorX MakeBufferX(VAddr address, u32 size) {
+    IPC::BufferDescriptorX descriptor{};
+    descriptor.address_bits_0_31 = static_cast<u32>(address);
+    descriptor.size.Assign(size);
+    return descriptor;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("HLERequestContext: Buffers larger than the storage are truncated", "[core]") {
+    GuestMemory memory;
+    const std::vector buffers_a{MakeBufferA(0x10, 0x20)};
+    std::array<u8, 8> storage{};
+
+    REQUIRE(HLERequestContext::ReadDescriptorBuffer(memory, buffers_a, {}, storage, 0) == 8);
+    for (std::size_t i = 0; i < storage.size(); ++i) {
+        REQUIRE(storage[i] == 0x10 + i);
+    }
+}
+
+TEST_CASE("HLERequestContext: Buffers smaller than the storage are read whole", "[core]") {
+    GuestMemory memory;
+    const std::vector buffers_x{MakeBufferX(0x40, 4)};
+    std::array<u8, 8> storage{};
+    storage.fill(0xff);
+
+    REQUIRE(HLERequestContext::ReadDescriptorBuffer(memory, {}, buffers_x, storage, 0) == 4);
+    REQUIRE(storage[0] == 0x40);
+    REQUIRE(storage[3] == 0x43);
+    // The rest of the storage is left untouched
+    REQUIRE(storage[4] == 0xff);
+}
+
+TEST_CASE("HLERequestContext: Empty A buffers fall back to X buffers", "[core]") {
+    GuestMemory memory;
+    const std::vector buffers_a{MakeBufferA(0x10, 0x20), MakeBufferA(0, 0)};
+    const std::vector buffers_x{MakeBufferX(0x80, 2), MakeBufferX(0x90, 2)};
+    std::array<u8, 2> storage{};
+
+    REQUIRE(HLERequestContext::ReadDescriptorBuffer(memory, buffers_a, buffers_x, storage, 1) ==
+            2);
+    REQUIRE(storage[0] == 0x90);
+
+    // Missing buffers read nothing
+    REQUIRE(HLERequestContext::ReadDescriptorBuffer(memory, buffers_a, buffers_x, storage, 2) ==
+            0);
+    REQUIRE(memory.num_reads == 1);
+}
@@ -0,0 +1,58 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/hle/service/nvdrv/nvdrv.h"
+
+namespace {
+
+using namespace std::chrono_literals;
+using Service::Nvidia::Ioctl;
+using Service::Nvidia::IoctlStatisticsTable;
+
+Ioctl MakeIoctl(u32 raw) {
+    Ioctl ioctl{};
+    ioctl.raw = raw;
+    return ioctl;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("IoctlStatisticsTable: Calls are accounted per command", "[core]") {
+    IoctlStatisticsTable table;
+    REQUIRE(table.Snapshot().empty());
+
+    constexpr u32 SUBMIT_GPFIFO = 0xC0184808;
+    constexpr u32 SYNCPT_WAIT = 0xC00C0016;
+    table.Record(MakeIoctl(SUBMIT_GPFIFO), 300ns);
+    table.Record(MakeIoctl(SUBMIT_GPFIFO), 1200ns);
+    table.Record(MakeIoctl(SUBMIT_GPFIFO), 500ns);
+    table.Record(MakeIoctl(SYNCPT_WAIT), 40ns);
+
+    const auto statistics = table.Snapshot();
+    REQUIRE(statistics.size() == 2);
+
+    const auto& submit = statistics.at(SUBMIT_GPFIFO);
+    REQUIRE(submit.calls == 3);
+    REQUIRE(submit.total_time == 2000ns);
+    REQUIRE(submit.max_time == 1200ns);
+
+    const auto& wait = statistics.at(SYNCPT_WAIT);
+    REQUIRE(wait.calls == 1);
+    REQUIRE(wait.total_time == 40ns);
+    REQUIRE(wait.max_time == 40ns);
+}
+
+TEST_CASE("IoctlStatisticsTable: Snapshots are not affected by later calls", "[core]") {
+    IoctlStatisticsTable table;
+    table.Record(MakeIoctl(1), 10ns);
+    const auto snapshot = table.Snapshot();
+    table.Record(MakeIoctl(1), 10ns);
+    REQUIRE(snapshot.at(1).calls == 1);
+    REQUIRE(table.Snapshot().at(1).calls == 2);
+}
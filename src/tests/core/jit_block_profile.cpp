@@ -0,0 +1,46 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/arm/jit_block_profile.h"
+
+using Core::JitBlockProfile;
+
+TEST_CASE("JitBlockProfile: Re-translations are counted apart from distinct blocks", "[core]") {
+    JitBlockProfile profile;
+    profile.RecordBlock(0x8001000);
+    profile.RecordBlock(0x8001000);
+    profile.RecordBlock(0x8002000);
+
+    const auto stats = profile.GetStatistics();
+    REQUIRE(stats.num_translations == 3);
+    REQUIRE(stats.num_blocks == 2);
+    REQUIRE(stats.num_startup_translations == 3);
+}
+
+TEST_CASE("JitBlockProfile: Branches and exceptions end blocks", "[core]") {
+    constexpr u32 B = 0x14000000;
+    constexpr u32 BL = 0x94000000;
+    constexpr u32 B_EQ = 0x54000000;
+    constexpr u32 CBZ = 0xB4000000;
+    constexpr u32 TBNZ = 0x37000000;
+    constexpr u32 BR = 0xD61F0000;
+    constexpr u32 RET = 0xD65F03C0;
+    constexpr u32 SVC = 0xD4000001;
+    constexpr u32 BRK = 0xD4200000;
+    for (const u32 instruction : {B, BL, B_EQ, CBZ, TBNZ, BR, RET, SVC, BRK}) {
+        REQUIRE(JitBlockProfile::EndsBlock(instruction));
+    }
+
+    constexpr u32 NOP = 0xD503201F;
+    constexpr u32 ADD = 0x91000400;
+    constexpr u32 ADRP = 0x90000000;
+    constexpr u32 LDR = 0xF9400020;
+    constexpr u32 MOVZ = 0xD2800000;
+    for (const u32 instruction : {NOP, ADD, ADRP, LDR, MOVZ}) {
+        REQUIRE(!JitBlockProfile::EndsBlock(instruction));
+    }
+}
@@ -0,0 +1,189 @@
+// Copyright 2021 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "core/memory/dmnt_cheat_vm.h"
+
+namespace Core::Memory {
+
+namespace {
+
+constexpr VAddr MAIN_BASE = 0x1000;
+constexpr std::size_t MEMORY_SIZE = 0x1000;
+
+constexpr u32 END_CONDITIONAL = 0x20000000;
+constexpr u32 INVALID_OPCODE = 0xB0000000;
+
+struct TestMemory {
+    std::vector<u8> bytes = std::vector<u8>(MEMORY_SIZE);
+    std::size_t num_command_logs = 0;
+
+    u32 Read32(u64 rel_address) const {
+        u32 value;
+        std::memcpy(&value, bytes.data() + rel_address, sizeof(value));
+        return value;
+    }
+
+    void Write32(u64 rel_address, u32 value) {
+        std::memcpy(bytes.data() + rel_address, &value, sizeof(value));
+    }
+};
+
+class TestCallbacks final : public DmntCheatVm::Callbacks {
+public:
+    explicit TestCallbacks(TestMemory& memory_, bool log_enabled_)
+        : memory{memory_}, log_enabled{log_enabled_} {}
+
+    void MemoryRead(VAddr address, void* data, u64 size) override {
+        REQUIRE(address >= MAIN_BASE);
+        REQUIRE(address - MAIN_BASE + size <= MEMORY_SIZE);
+        std::memcpy(data, memory.bytes.data() + (address - MAIN_BASE), size);
+    }
+
+    void MemoryWrite(VAddr address, const void* data, u64 size) override {
+        REQUIRE(address >= MAIN_BASE);
+        REQUIRE(address - MAIN_BASE + size <= MEMORY_SIZE);
+        std::memcpy(memory.bytes.data() + (address - MAIN_BASE), data, size);
+    }
+
+    u64 HidKeysDown() override {
+        return 0;
+    }
+
+    void DebugLog(u8 id, u64 value) override {}
+
+    void CommandLog(std::string_view data) override {
+        ++memory.num_command_logs;
+    }
+
+    bool IsCommandLogEnabled() override {
+        return log_enabled;
+    }
+
+private:
+    TestMemory& memory;
+    bool log_enabled;
+};
+
+CheatEntry MakeCheat(std::initializer_list<u32> opcodes) {
+    CheatEntry entry{.enabled = true};
+    for (const u32 opcode : opcodes) {
+        entry.definition.opcodes[entry.definition.num_opcodes++] = opcode;
+    }
+    return entry;
+}
+
+TestMemory Run(const std::vector<CheatEntry>& cheats, const TestMemory& initial = {},
+               bool log_enabled = false, std::size_t num_executions = 1) {
+    TestMemory memory = initial;
+    DmntCheatVm vm{std::make_unique<TestCallbacks>(memory, log_enabled)};
+    REQUIRE(vm.LoadProgram(cheats));
+
+    CheatProcessMetadata metadata{};
+    metadata.main_nso_extents = {.base = MAIN_BASE, .size = MEMORY_SIZE};
+    for (std::size_t i = 0; i < num_executions; ++i) {
+        vm.Execute(metadata);
+    }
+    return memory;
+}
+
+// Nested conditionals, with a taken and a skipped outer block
+const CheatEntry CONDITIONAL_CHEAT = MakeCheat({
+    0x14050000, 0x20, 5,           // if [main+0x20] == 5
+    0x04000000, 0x30, 1,           //   [main+0x30] = 1
+    0x14050000, 0x20, 6,           //   if [main+0x20] == 6
+    0x04000000, 0x34, 2,           //     [main+0x34] = 2
+    END_CONDITIONAL,               //   endif
+    END_CONDITIONAL,               // endif
+    0x14050000, 0x20, 7,           // if [main+0x20] == 7
+    0x14050000, 0x20, 5,           //   if [main+0x20] == 5
+    0x04000000, 0x3C, 4,           //     [main+0x3C] = 4
+    END_CONDITIONAL,               //   endif
+    0x04000000, 0x40, 5,           //   [main+0x40] = 5
+    END_CONDITIONAL,               // endif
+    0x04000000, 0x38, 3,           // [main+0x38] = 3
+});
+
+// Stores to three consecutive words through an incremented address register
+const CheatEntry LOOP_CHEAT = MakeCheat({
+    0x74020000, MAIN_BASE + 0x100, // r2 += main+0x100
+    0x30100000, 3,                 // loop r1 = 3 times
+    0x64021000, 0xAB, 0xAB,        //   [r2] = 0xAB, r2 += 4
+    0x31100000,                    // endloop r1
+});
+
+} // Anonymous namespace
+
+TEST_CASE("DmntCheatVm: Conditional blocks", "[core]") {
+    TestMemory initial;
+    initial.Write32(0x20, 5);
+    const TestMemory memory = Run({CONDITIONAL_CHEAT}, initial);
+    REQUIRE(memory.Read32(0x30) == 1);
+    REQUIRE(memory.Read32(0x34) == 0);
+    REQUIRE(memory.Read32(0x38) == 3);
+    REQUIRE(memory.Read32(0x3C) == 0);
+    REQUIRE(memory.Read32(0x40) == 0);
+}
+
+TEST_CASE("DmntCheatVm: Loops", "[core]") {
+    const TestMemory memory = Run({LOOP_CHEAT});
+    REQUIRE(memory.Read32(0x100) == 0xAB);
+    REQUIRE(memory.Read32(0x104) == 0xAB);
+    REQUIRE(memory.Read32(0x108) == 0xAB);
+    REQUIRE(memory.Read32(0x10C) == 0);
+}
+
+TEST_CASE("DmntCheatVm: Execution stops at invalid opcodes", "[core]") {
+    const TestMemory memory = Run({
+        MakeCheat({0x04000000, 0x50, 1}),
+        MakeCheat({INVALID_OPCODE}),
+        MakeCheat({0x04000000, 0x54, 2}),
+    });
+    REQUIRE(memory.Read32(0x50) == 1);
+    REQUIRE(memory.Read32(0x54) == 0);
+
+    // A truncated opcode is invalid as well
+    const TestMemory truncated = Run({MakeCheat({0x04000000, 0x58, 3, 0x04000000, 0x5C})});
+    REQUIRE(truncated.Read32(0x58) == 3);
+    REQUIRE(truncated.Read32(0x5C) == 0);
+}
+
+TEST_CASE("DmntCheatVm: Repeated executions are identical", "[core]") {
+    TestMemory initial;
+    initial.Write32(0x20, 5);
+    const std::vector cheats{CONDITIONAL_CHEAT, LOOP_CHEAT};
+    const TestMemory once = Run(cheats, initial);
+    const TestMemory many = Run(cheats, initial, false, 10);
+    REQUIRE(once.bytes == many.bytes);
+}
+
+TEST_CASE("DmntCheatVm: Command logging does not change results", "[core]") {
+    TestMemory initial;
+    initial.Write32(0x20, 5);
+    const std::vector cheats{CONDITIONAL_CHEAT, LOOP_CHEAT};
+    const TestMemory silent = Run(cheats, initial, false);
+    const TestMemory logged = Run(cheats, initial, true);
+    REQUIRE(silent.bytes == logged.bytes);
+    REQUIRE(silent.num_command_logs == 0);
+    REQUIRE(logged.num_command_logs > 0);
+}
+
+TEST_CASE("DmntCheatVm: Oversized programs are rejected", "[core]") {
+    TestMemory memory;
+    DmntCheatVm vm{std::make_unique<TestCallbacks>(memory, false)};
+    CheatEntry large = MakeCheat({});
+    large.definition.num_opcodes = static_cast<u32>(large.definition.opcodes.size());
+    REQUIRE(vm.LoadProgram({large, large, large, large}));
+    REQUIRE(vm.GetProgramSize() == DmntCheatVm::MaximumProgramOpcodeCount);
+    REQUIRE(!vm.LoadProgram({large, large, large, large, large}));
+    REQUIRE(vm.GetProgramSize() == 0);
+}
+
+} // namespace Core::Memory
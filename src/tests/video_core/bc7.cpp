@@ -0,0 +1,155 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "video_core/textures/bc7.h"
+
+namespace {
+
+using namespace Tegra::Texture;
+
+constexpr std::array<u32, 16> WEIGHTS{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+u32 ReadBits(const u8* block, u32& position, u32 num_bits) {
+    u32 value = 0;
+    for (u32 i = 0; i < num_bits; ++i, ++position) {
+        value |= ((block[position / 8] >> (position % 8)) & 1U) << i;
+    }
+    return value;
+}
+
+/// Reference decoder for the mode 6 blocks produced by the encoder
+void DecodeBlock(const u8* block, u8* pixels) {
+    u32 position = 0;
+    REQUIRE(ReadBits(block, position, 7) == 1U << 6);
+    std::array<std::array<u32, 2>, 4> endpoints;
+    for (auto& channel : endpoints) {
+        channel[0] = ReadBits(block, position, 7) << 1;
+        channel[1] = ReadBits(block, position, 7) << 1;
+    }
+    const u32 first_pbit = ReadBits(block, position, 1);
+    const u32 second_pbit = ReadBits(block, position, 1);
+    for (auto& channel : endpoints) {
+        channel[0] |= first_pbit;
+        channel[1] |= second_pbit;
+    }
+    for (u32 pixel = 0; pixel < 16; ++pixel) {
+        const u32 weight = WEIGHTS[ReadBits(block, position, pixel == 0 ? 3 : 4)];
+        for (u32 c = 0; c < 4; ++c) {
+            pixels[pixel * 4 + c] = static_cast<u8>(
+                ((64 - weight) * endpoints[c][0] + weight * endpoints[c][1] + 32) >> 6);
+        }
+    }
+}
+
+std::vector<u8> Decode(const std::vector<u8>& blocks, u32 width, u32 height) {
+    std::vector<u8> image(width * height * 4);
+    std::array<u8, 64> pixels;
+    std::size_t block_offset = 0;
+    for (u32 block_y = 0; block_y < height; block_y += 4) {
+        for (u32 block_x = 0; block_x < width; block_x += 4) {
+            DecodeBlock(&blocks[block_offset], pixels.data());
+            block_offset += BC7::BLOCK_SIZE;
+            for (u32 y = 0; y < 4 && block_y + y < height; ++y) {
+                for (u32 x = 0; x < 4 && block_x + x < width; ++x) {
+                    for (u32 c = 0; c < 4; ++c) {
+                        image[((block_y + y) * width + block_x + x) * 4 + c] =
+                            pixels[(y * 4 + x) * 4 + c];
+                    }
+                }
+            }
+        }
+    }
+    return image;
+}
+
+double PSNR(const std::vector<u8>& lhs, const std::vector<u8>& rhs) {
+    double error = 0.0;
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        const double diff = static_cast<double>(lhs[i]) - static_cast<double>(rhs[i]);
+        error += diff * diff;
+    }
+    if (error == 0.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return 10.0 * std::log10(255.0 * 255.0 / (error / static_cast<double>(lhs.size())));
+}
+
+/// Smooth gradients with a translucent disc and some noise, similar to game textures
+std::vector<u8> MakeImage(u32 width, u32 height) {
+    std::mt19937 random{1234};
+    std::uniform_int_distribution<int> noise{-6, 6};
+    std::vector<u8> image(width * height * 4);
+    for (u32 y = 0; y < height; ++y) {
+        for (u32 x = 0; x < width; ++x) {
+            const double dx = static_cast<double>(x) - width / 2.0;
+            const double dy = static_cast<double>(y) - height / 2.0;
+            const bool inside = dx * dx + dy * dy < (width / 3.0) * (width / 3.0);
+            const std::array<int, 4> color{
+                static_cast<int>(x * 255 / width) + noise(random),
+                static_cast<int>(y * 255 / height) + noise(random),
+                inside ? 200 : 40,
+                inside ? 128 : 255,
+            };
+            for (u32 c = 0; c < 4; ++c) {
+                image[(y * width + x) * 4 + c] = static_cast<u8>(std::clamp(color[c], 0, 255));
+            }
+        }
+    }
+    return image;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("BC7: Solid blocks are exact when representable", "[video_core]") {
+    std::array<u8, 64> pixels;
+    for (std::size_t i = 0; i < 16; ++i) {
+        pixels[i * 4 + 0] = 10;
+        pixels[i * 4 + 1] = 128;
+        pixels[i * 4 + 2] = 254;
+        pixels[i * 4 + 3] = 0;
+    }
+    std::array<u8, BC7::BLOCK_SIZE> block;
+    BC7::EncodeBlock(pixels, block);
+
+    std::array<u8, 64> decoded;
+    DecodeBlock(block.data(), decoded.data());
+    REQUIRE(decoded == pixels);
+}
+
+TEST_CASE("BC7: Encoding quality", "[video_core]") {
+    constexpr u32 width = 61;
+    constexpr u32 height = 35;
+    const std::vector<u8> image = MakeImage(width, height);
+
+    std::vector<u8> blocks(BC7::EncodedSize(width, height));
+    BC7::Encode(image, width, height, blocks);
+
+    const double psnr = PSNR(image, Decode(blocks, width, height));
+    INFO("PSNR " << psnr << " dB");
+    REQUIRE(psnr > 38.0);
+}
+
+TEST_CASE("BC7: Encoding throughput", "[.][video_core][benchmark]") {
+    constexpr u32 width = 1024;
+    constexpr u32 height = 1024;
+    const std::vector<u8> image = MakeImage(width, height);
+    std::vector<u8> blocks(BC7::EncodedSize(width, height));
+
+    const auto start = std::chrono::steady_clock::now();
+    BC7::Encode(image, width, height, blocks);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    WARN("Encoded " << width << "x" << height << " in " << elapsed.count() * 1000.0 << " ms, "
+                    << (width * height) / elapsed.count() / 1e6 << " Mpixels/s, PSNR "
+                    << PSNR(image, Decode(blocks, width, height)) << " dB");
+}
@@ -0,0 +1,167 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "video_core/host_page_cache.h"
+
+namespace {
+using Cache = Tegra::HostPageCache<16>;
+using Range = std::tuple<std::size_t, bool, std::size_t>;
+
+constexpr u64 GPU_PAGE = Cache::page_size;
+constexpr u64 CPU_PAGE = 0x1000;
+constexpr u64 CPU_PAGES_PER_GPU_PAGE = GPU_PAGE / CPU_PAGE;
+
+/// Two level page table translating gpu pages to cpu pages and cpu pages to host memory
+class PageTables {
+public:
+    explicit PageTables(std::size_t num_gpu_pages)
+        : memory(num_gpu_pages * GPU_PAGE), gpu_pages(num_gpu_pages),
+          cpu_pages(num_gpu_pages * CPU_PAGES_PER_GPU_PAGE) {
+        for (std::size_t page = 0; page < gpu_pages.size(); ++page) {
+            gpu_pages[page] = page * CPU_PAGES_PER_GPU_PAGE;
+        }
+        for (std::size_t page = 0; page < cpu_pages.size(); ++page) {
+            cpu_pages[page] = memory.data() + page * CPU_PAGE;
+        }
+    }
+
+    /// Same as the lookup done by the memory manager on a cache miss
+    std::span<u8> Translate(u64 gpu_addr) const {
+        const std::optional<std::size_t> cpu_page = gpu_pages[gpu_addr / GPU_PAGE];
+        if (!cpu_page) {
+            return {};
+        }
+        u8* const host_ptr = cpu_pages[*cpu_page];
+        std::size_t size = CPU_PAGE;
+        while (size < GPU_PAGE && cpu_pages[*cpu_page + size / CPU_PAGE] == host_ptr + size) {
+            size += CPU_PAGE;
+        }
+        return {host_ptr, size};
+    }
+
+    /// Copies translating every gpu page and then every cpu page, without caching
+    void ReadUncached(u64 gpu_addr, u8* dest, std::size_t size) const {
+        while (size > 0) {
+            const std::size_t gpu_offset = gpu_addr % GPU_PAGE;
+            const std::size_t gpu_amount = std::min(GPU_PAGE - gpu_offset, size);
+            const std::size_t cpu_addr = *gpu_pages[gpu_addr / GPU_PAGE] * CPU_PAGE + gpu_offset;
+            for (std::size_t done = 0; done < gpu_amount;) {
+                const std::size_t cpu_offset = (cpu_addr + done) % CPU_PAGE;
+                const std::size_t amount = std::min(CPU_PAGE - cpu_offset, gpu_amount - done);
+                std::memcpy(dest + done, cpu_pages[(cpu_addr + done) / CPU_PAGE] + cpu_offset,
+                            amount);
+                done += amount;
+            }
+            gpu_addr += gpu_amount;
+            dest += gpu_amount;
+            size -= gpu_amount;
+        }
+    }
+
+    std::vector<u8> memory;
+    std::vector<std::optional<std::size_t>> gpu_pages;
+    std::vector<u8*> cpu_pages;
+};
+
+std::vector<Range> Ranges(Cache& cache, const PageTables& tables, u64 gpu_addr, std::size_t size,
+                          u64 generation = 0) {
+    std::vector<Range> ranges;
+    cache.ForEachHostRange(
+        gpu_addr, size, generation, [&](u64 addr) { return tables.Translate(addr); },
+        [&](std::size_t offset, u8* host_ptr, std::size_t range_size) {
+            ranges.emplace_back(offset, host_ptr != nullptr, range_size);
+        });
+    return ranges;
+}
+} // Anonymous namespace
+
+TEST_CASE("HostPageCache: Contiguous pages are merged", "[video_core]") {
+    Cache cache;
+    const PageTables tables(8);
+    REQUIRE(Ranges(cache, tables, 0x1234, 5 * GPU_PAGE) ==
+            std::vector<Range>{{0, true, 5 * GPU_PAGE}});
+    REQUIRE(cache.NumMisses() == 6);
+}
+
+TEST_CASE("HostPageCache: Discontiguous pages split ranges", "[video_core]") {
+    Cache cache;
+    PageTables tables(8);
+    std::swap(tables.gpu_pages[2], tables.gpu_pages[3]);
+    tables.gpu_pages[5] = std::nullopt;
+    REQUIRE(Ranges(cache, tables, 0, 8 * GPU_PAGE) ==
+            std::vector<Range>{{0, true, 2 * GPU_PAGE},
+                               {2 * GPU_PAGE, true, GPU_PAGE},
+                               {3 * GPU_PAGE, true, GPU_PAGE},
+                               {4 * GPU_PAGE, true, GPU_PAGE},
+                               {5 * GPU_PAGE, false, GPU_PAGE},
+                               {6 * GPU_PAGE, true, 2 * GPU_PAGE}});
+}
+
+TEST_CASE("HostPageCache: Partially contiguous pages", "[video_core]") {
+    Cache cache;
+    PageTables tables(4);
+    // The cpu pages of the second gpu page are only contiguous up to 0x3000
+    std::swap(tables.cpu_pages[CPU_PAGES_PER_GPU_PAGE + 3], tables.cpu_pages[0]);
+    REQUIRE(Ranges(cache, tables, GPU_PAGE, 0x3000) == std::vector<Range>{{0, true, 0x3000}});
+    REQUIRE(Ranges(cache, tables, 0, 3 * GPU_PAGE) ==
+            std::vector<Range>{{0, false, 2 * GPU_PAGE}, {2 * GPU_PAGE, true, GPU_PAGE}});
+}
+
+TEST_CASE("HostPageCache: Generations invalidate translations", "[video_core]") {
+    Cache cache;
+    PageTables tables(4);
+    (void)Ranges(cache, tables, 0, 4 * GPU_PAGE, 1);
+    (void)Ranges(cache, tables, 0, 4 * GPU_PAGE, 1);
+    REQUIRE(cache.NumMisses() == 4);
+
+    tables.gpu_pages[1] = std::nullopt;
+    REQUIRE(Ranges(cache, tables, 0, 2 * GPU_PAGE, 1) ==
+            std::vector<Range>{{0, true, 2 * GPU_PAGE}});
+    REQUIRE(Ranges(cache, tables, 0, 2 * GPU_PAGE, 2) ==
+            std::vector<Range>{{0, true, GPU_PAGE}, {GPU_PAGE, false, GPU_PAGE}});
+    REQUIRE(cache.NumMisses() == 6);
+}
+
+TEST_CASE("HostPageCache: Upload throughput", "[.][video_core][benchmark]") {
+    constexpr std::size_t num_gpu_pages = 1024;
+    constexpr std::size_t total_size = 1ULL << 30;
+    const PageTables tables(num_gpu_pages);
+    Cache cache;
+    std::vector<u8> buffer(4 << 20);
+
+    const auto measure = [&](std::size_t size, auto&& read) {
+        const auto start = std::chrono::steady_clock::now();
+        u64 gpu_addr = 0;
+        for (std::size_t done = 0; done < total_size; done += size) {
+            read(gpu_addr, size);
+            gpu_addr = (gpu_addr + size + 0x100) % (num_gpu_pages * GPU_PAGE - size);
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<double>(total_size) / elapsed.count() / 1e9;
+    };
+    for (const std::size_t size : {0x100, 0x1000, 0x10000, 0x40000, 0x100000, 0x400000}) {
+        const double uncached = measure(size, [&](u64 gpu_addr, std::size_t read_size) {
+            tables.ReadUncached(gpu_addr, buffer.data(), read_size);
+        });
+        const double cached = measure(size, [&](u64 gpu_addr, std::size_t read_size) {
+            cache.ForEachHostRange(
+                gpu_addr, read_size, 0, [&](u64 addr) { return tables.Translate(addr); },
+                [&](std::size_t offset, u8* host_ptr, std::size_t range_size) {
+                    std::memcpy(buffer.data() + offset, host_ptr, range_size);
+                });
+        });
+        WARN("Uploads of " << size << " bytes: " << uncached << " GB/s translating every page, "
+                           << cached << " GB/s with cached host ranges");
+    }
+}
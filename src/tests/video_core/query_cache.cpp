@@ -0,0 +1,210 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <optional>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "core/settings.h"
+#include "video_core/query_cache.h"
+
+namespace {
+using VideoCore::QueryType;
+
+constexpr GPUVAddr GPU_ADDR = 0x100000;
+constexpr VAddr CPU_ADDR = 0x2000;
+constexpr u64 COUNTER_VALUE = 7;
+
+class Cache;
+
+/// Host counter whose result is known but only available once marked as ready
+class HostCounter final : public VideoCommon::HostCounterBase<Cache, HostCounter> {
+public:
+    explicit HostCounter(std::shared_ptr<HostCounter> dependency_, u64 value_)
+        : HostCounterBase{std::move(dependency_)}, value{value_} {}
+
+    explicit HostCounter(Cache& cache_, std::shared_ptr<HostCounter> dependency_, QueryType)
+        : HostCounterBase{std::move(dependency_)}, value{COUNTER_VALUE}, cache{&cache_} {}
+
+    void EndQuery() {}
+
+    bool is_ready = false;
+    mutable int num_blocking_queries = 0;
+
+private:
+    u64 BlockingQuery() const override {
+        ++num_blocking_queries;
+        return value;
+    }
+
+    std::optional<u64> NonBlockingQuery() const override;
+
+    u64 value;
+    const Cache* cache = nullptr;
+};
+
+class CachedQuery : public VideoCommon::CachedQueryBase<HostCounter> {
+public:
+    explicit CachedQuery(u8* host_ptr_) : CachedQueryBase{0, host_ptr_} {}
+
+    explicit CachedQuery(Cache&, QueryType, VAddr cpu_addr_, u8* host_ptr_)
+        : CachedQueryBase{cpu_addr_, host_ptr_} {}
+};
+
+class CounterStream : public VideoCommon::CounterStreamBase<Cache, HostCounter> {
+public:
+    explicit CounterStream(Cache& cache_, QueryType type_) : CounterStreamBase{cache_, type_} {}
+};
+
+class Rasterizer {
+public:
+    void UpdatePagesCachedCount(VAddr, u64, int delta) {
+        num_cached_queries += delta;
+    }
+
+    int num_cached_queries = 0;
+};
+
+struct Maxwell3D {
+    struct {
+        bool samplecnt_enable = false;
+    } regs;
+};
+
+/// Maps GPU_ADDR to CPU_ADDR, backed by a small host buffer
+class GpuMemory {
+public:
+    std::optional<VAddr> GpuToCpuAddress(GPUVAddr gpu_addr) const {
+        return gpu_addr - GPU_ADDR + CPU_ADDR;
+    }
+
+    u8* GetPointer(GPUVAddr gpu_addr) {
+        return memory.data() + (gpu_addr - GPU_ADDR);
+    }
+
+    std::array<u8, 16> memory{};
+};
+
+class Cache final : public VideoCommon::QueryCacheBase<Cache, CachedQuery, CounterStream,
+                                                       HostCounter, Rasterizer, Maxwell3D,
+                                                       GpuMemory> {
+public:
+    explicit Cache(Rasterizer& rasterizer_, Maxwell3D& maxwell3d_, GpuMemory& gpu_memory_)
+        : QueryCacheBase{rasterizer_, maxwell3d_, gpu_memory_} {}
+
+    /// When set, every counter created by the cache has its result available
+    bool are_counters_ready = false;
+};
+
+std::optional<u64> HostCounter::NonBlockingQuery() const {
+    if (!is_ready && !(cache && cache->are_counters_ready)) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+u64 ReadResult(const std::array<u8, 16>& memory) {
+    u64 value;
+    std::memcpy(&value, memory.data(), sizeof(value));
+    return value;
+}
+} // Anonymous namespace
+
+TEST_CASE("QueryCache: Results are only available when the whole chain is", "[video_core]") {
+    const auto first = std::make_shared<HostCounter>(nullptr, 3);
+    const auto second = std::make_shared<HostCounter>(first, 5);
+
+    REQUIRE(!second->TryQuery());
+    second->is_ready = true;
+    REQUIRE(!second->TryQuery());
+    first->is_ready = true;
+    REQUIRE(second->TryQuery() == 8);
+
+    // The result is kept after resolving it
+    second->is_ready = false;
+    REQUIRE(second->TryQuery() == 8);
+    REQUIRE(second->Query() == 8);
+    REQUIRE(second->num_blocking_queries == 0);
+}
+
+TEST_CASE("QueryCache: Conservative results are replaced by exact ones", "[video_core]") {
+    std::array<u8, 16> memory{};
+    CachedQuery query{memory.data()};
+    const auto counter = std::make_shared<HostCounter>(nullptr, 42);
+    query.BindCounter(counter, std::nullopt);
+
+    REQUIRE(!query.TryFlush());
+    query.FlushConservative(1);
+    REQUIRE(ReadResult(memory) == 1);
+
+    counter->is_ready = true;
+    REQUIRE(query.TryFlush());
+    REQUIRE(ReadResult(memory) == 42);
+    REQUIRE(query.GetWrittenValue() == 42);
+    REQUIRE(counter->num_blocking_queries == 0);
+}
+
+TEST_CASE("QueryCache: Reset queries flush zero without waiting", "[video_core]") {
+    std::array<u8, 16> memory{};
+    memory.fill(0xff);
+    CachedQuery query{memory.data()};
+    query.BindCounter(nullptr, std::nullopt);
+    REQUIRE(query.TryFlush());
+    REQUIRE(ReadResult(memory) == 0);
+}
+
+TEST_CASE("QueryCache: Deferred reads are written back once the result is ready", "[video_core]") {
+    const auto previous_resolution = Settings::values.query_resolution.GetValue();
+    const bool previous_async = Settings::values.use_asynchronous_gpu_emulation.GetValue();
+    Settings::values.query_resolution.SetValue(Settings::QueryResolution::Conservative);
+    Settings::values.use_asynchronous_gpu_emulation.SetValue(true);
+
+    Rasterizer rasterizer;
+    Maxwell3D maxwell3d;
+    GpuMemory gpu_memory;
+    Cache cache{rasterizer, maxwell3d, gpu_memory};
+
+    maxwell3d.regs.samplecnt_enable = true;
+    cache.UpdateCounters();
+    cache.Query(GPU_ADDR, QueryType::SamplesPassed, std::nullopt);
+    REQUIRE(rasterizer.num_cached_queries == 1);
+
+    // Conservative reads never wait for the host GPU
+    cache.CommitAsyncFlushes();
+    REQUIRE(!cache.ShouldWaitAsyncFlushes());
+    Settings::values.query_resolution.SetValue(Settings::QueryResolution::Accurate);
+    REQUIRE(cache.ShouldWaitAsyncFlushes());
+    Settings::values.query_resolution.SetValue(Settings::QueryResolution::Conservative);
+
+    // The early read is answered as visible and the query stays cached
+    cache.FlushRegion(CPU_ADDR, 8);
+    REQUIRE(ReadResult(gpu_memory.memory) == 1);
+    REQUIRE(rasterizer.num_cached_queries == 1);
+
+    // The exact result is written once it's available
+    cache.are_counters_ready = true;
+    cache.PopAsyncFlushes();
+    REQUIRE(ReadResult(gpu_memory.memory) == COUNTER_VALUE);
+    REQUIRE(rasterizer.num_cached_queries == 0);
+
+    // Later early reads of the same address are answered with the last exact result
+    cache.are_counters_ready = false;
+    cache.Query(GPU_ADDR, QueryType::SamplesPassed, std::nullopt);
+    gpu_memory.memory.fill(0);
+    cache.FlushRegion(CPU_ADDR, 8);
+    REQUIRE(ReadResult(gpu_memory.memory) == COUNTER_VALUE);
+
+    const VideoCommon::QueryCacheStatistics stats = cache.GetStatistics();
+    REQUIRE(stats.num_ready_flushes == 1);
+    REQUIRE(stats.num_blocking_flushes == 0);
+    REQUIRE(stats.num_stalls_avoided == 2);
+    REQUIRE(stats.num_late_results == 1);
+
+    Settings::values.query_resolution.SetValue(previous_resolution);
+    Settings::values.use_asynchronous_gpu_emulation.SetValue(previous_async);
+}
@@ -0,0 +1,68 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "video_core/texture_cache/upload_deduplicator.h"
+
+namespace {
+using VideoCommon::ImageId;
+using VideoCommon::ImageInfo;
+using VideoCommon::UploadDeduplicator;
+
+ImageInfo MakeInfo(u32 width, u32 height) {
+    ImageInfo info;
+    info.format = VideoCore::Surface::PixelFormat::A8B8G8R8_UNORM;
+    info.type = VideoCommon::ImageType::e2D;
+    info.resources.levels = 1;
+    info.resources.layers = 1;
+    info.size = {width, height, 1};
+    return info;
+}
+} // Anonymous namespace
+
+TEST_CASE("UploadDeduplicator: Hashes include the image parameters", "[video_core]") {
+    UploadDeduplicator deduplicator(1 << 20);
+    const std::vector<u8> data(64 * 64 * 4, 0x5a);
+    const u64 hash = deduplicator.Hash(MakeInfo(64, 64), data);
+    REQUIRE(deduplicator.Hash(MakeInfo(64, 64), data) == hash);
+    REQUIRE(deduplicator.Hash(MakeInfo(128, 32), data) != hash);
+
+    std::vector<u8> modified = data;
+    modified.back() = 0;
+    REQUIRE(deduplicator.Hash(MakeInfo(64, 64), modified) != hash);
+    REQUIRE(deduplicator.Statistics().hashed_bytes == 4 * data.size());
+}
+
+TEST_CASE("UploadDeduplicator: Images are found by hash until erased", "[video_core]") {
+    UploadDeduplicator deduplicator(1 << 20);
+    REQUIRE(!deduplicator.Find(1));
+
+    deduplicator.Insert(1, ImageId{3});
+    deduplicator.Insert(2, ImageId{4});
+    REQUIRE(deduplicator.Find(1) == ImageId{3});
+
+    // Later images holding the same contents replace the previous one
+    deduplicator.Insert(1, ImageId{5});
+    REQUIRE(deduplicator.Find(1) == ImageId{5});
+
+    deduplicator.Erase(1);
+    REQUIRE(!deduplicator.Find(1));
+    REQUIRE(deduplicator.Find(2) == ImageId{4});
+}
+
+TEST_CASE("UploadDeduplicator: Hashing is bounded per frame", "[video_core]") {
+    UploadDeduplicator deduplicator(1000);
+    REQUIRE(deduplicator.ConsumeBudget(600));
+    REQUIRE(!deduplicator.ConsumeBudget(600));
+    REQUIRE(deduplicator.ConsumeBudget(400));
+    REQUIRE(!deduplicator.ConsumeBudget(1));
+    REQUIRE(deduplicator.Statistics().num_over_budget == 2);
+
+    deduplicator.TickFrame();
+    REQUIRE(deduplicator.ConsumeBudget(1000));
+}
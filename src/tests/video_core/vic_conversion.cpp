@@ -0,0 +1,77 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "common/common_types.h"
+#include "video_core/command_classes/vic_conversion.h"
+
+namespace {
+
+std::vector<u8> MakePlane(std::size_t size, u8 seed) {
+    std::vector<u8> plane(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        plane[i] = static_cast<u8>(i * 31 + seed);
+    }
+    return plane;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("VicConversion: CopyPlane matches per byte copy", "[video_core]") {
+    for (const std::size_t width : {1, 15, 16, 17, 64, 100, 1280}) {
+        for (const std::size_t extra_stride : {0, 3, 32}) {
+            const std::size_t height = 9;
+            const std::size_t src_stride = width + extra_stride;
+            const std::size_t dst_stride = (width + 0xff) & ~0xff;
+            const auto src = MakePlane(src_stride * height, 7);
+
+            std::vector<u8> expected(dst_stride * height);
+            for (std::size_t y = 0; y < height; ++y) {
+                for (std::size_t x = 0; x < width; ++x) {
+                    expected[y * dst_stride + x] = src[y * src_stride + x];
+                }
+            }
+            std::vector<u8> result(dst_stride * height);
+            Tegra::VicConversion::CopyPlane(result.data(), dst_stride, src.data(), src_stride,
+                                            width, height);
+            REQUIRE(result == expected);
+
+            std::vector<u8> packed(width * height);
+            Tegra::VicConversion::CopyPlane(packed.data(), width, src.data(), src_stride, width,
+                                            height);
+            for (std::size_t y = 0; y < height; ++y) {
+                for (std::size_t x = 0; x < width; ++x) {
+                    REQUIRE(packed[y * width + x] == src[y * src_stride + x]);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("VicConversion: InterleaveChroma matches scalar interleave", "[video_core]") {
+    for (const std::size_t width : {1, 8, 15, 16, 17, 31, 32, 33, 640, 641}) {
+        for (const std::size_t extra_stride : {0, 5, 64}) {
+            const std::size_t height = 7;
+            const std::size_t src_stride = width + extra_stride;
+            const std::size_t dst_stride = ((width * 2) + 0xff) & ~0xff;
+            const auto src_u = MakePlane(src_stride * height, 3);
+            const auto src_v = MakePlane(src_stride * height, 101);
+
+            std::vector<u8> expected(dst_stride * height, 0xcd);
+            for (std::size_t y = 0; y < height; ++y) {
+                for (std::size_t x = 0; x < width; ++x) {
+                    expected[y * dst_stride + x * 2] = src_u[y * src_stride + x];
+                    expected[y * dst_stride + x * 2 + 1] = src_v[y * src_stride + x];
+                }
+            }
+            std::vector<u8> result(dst_stride * height, 0xcd);
+            Tegra::VicConversion::InterleaveChroma(result.data(), dst_stride, src_u.data(),
+                                                   src_v.data(), src_stride, width, height);
+            REQUIRE(result == expected);
+        }
+    }
+}
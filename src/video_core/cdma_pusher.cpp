@@ -35,7 +35,11 @@ CDmaPusher::CDmaPusher(GPU& gpu_)
       host1x_processor(std::make_unique<Host1x>(gpu)),
       sync_manager(std::make_unique<SyncptIncrManager>(gpu)) {}
 
-CDmaPusher::~CDmaPusher() = default;
+CDmaPusher::~CDmaPusher() {
+    // The decoder thread may still signal syncpoints through the sync manager, stop it first
+    vic_processor.reset();
+    nvdec_processor.reset();
+}
 
 void CDmaPusher::Push(ChCommandHeaderList&& entries) {
     cdma_queue.push(std::move(entries));
@@ -111,8 +115,11 @@ void CDmaPusher::ExecuteCommand(u32 state_offset, u32 data) {
             if (cond == 0) {
                 sync_manager->Increment(syncpoint_id);
             } else {
-                sync_manager->SignalDone(
-                    sync_manager->IncrementWhenDone(static_cast<u32>(current_class), syncpoint_id));
+                // Decoding happens asynchronously, signal once the pending frames are decoded
+                const u32 handle =
+                    sync_manager->IncrementWhenDone(static_cast<u32>(current_class), syncpoint_id);
+                nvdec_processor->OnDecodesDone(
+                    [this, handle] { sync_manager->SignalDone(handle); });
             }
             break;
         }
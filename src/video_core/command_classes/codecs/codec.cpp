@@ -2,10 +2,13 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
+#include <thread>
 #include <vector>
 #include "common/assert.h"
+#include "common/logging/log.h"
 #include "video_core/command_classes/codecs/codec.h"
 #include "video_core/command_classes/codecs/h264.h"
 #include "video_core/command_classes/codecs/vp9.h"
@@ -23,6 +26,14 @@ void AVFrameDeleter(AVFrame* ptr) {
     av_free(ptr);
 }
 
+namespace {
+/// Maximum number of threads used by libavcodec to decode the slices of a frame.
+constexpr int MAX_DECODER_THREADS = 4;
+
+/// Maximum number of decoded frames waiting to be consumed by VIC.
+constexpr std::size_t MAX_QUEUED_FRAMES = 10;
+} // Anonymous namespace
+
 Codec::Codec(GPU& gpu_)
     : gpu(gpu_), h264_decoder(std::make_unique<Decoder::H264>(gpu)),
       vp9_decoder(std::make_unique<Decoder::VP9>(gpu)) {}
@@ -31,6 +42,8 @@ Codec::~Codec() {
     if (!initialized) {
         return;
     }
+    decode_worker.WaitForRequests();
+
     // Free libav memory
     AVFrame* av_frame{nullptr};
     avcodec_send_packet(av_codec_ctx, nullptr);
@@ -53,66 +66,109 @@ void Codec::StateWrite(u32 offset, u64 arguments) {
     std::memcpy(state_offset, &arguments, sizeof(u64));
 }
 
-void Codec::Decode() {
-    bool is_first_frame = false;
+void Codec::InitializeAvCodec() {
+    if (current_codec == NvdecCommon::VideoCodec::H264) {
+        av_codec = avcodec_find_decoder(AV_CODEC_ID_H264);
+    } else if (current_codec == NvdecCommon::VideoCodec::Vp9) {
+        av_codec = avcodec_find_decoder(AV_CODEC_ID_VP9);
+    } else {
+        LOG_ERROR(Service_NVDRV, "Unknown video codec {}", current_codec);
+        return;
+    }
 
-    if (!initialized) {
-        if (current_codec == NvdecCommon::VideoCodec::H264) {
-            av_codec = avcodec_find_decoder(AV_CODEC_ID_H264);
-        } else if (current_codec == NvdecCommon::VideoCodec::Vp9) {
-            av_codec = avcodec_find_decoder(AV_CODEC_ID_VP9);
-        } else {
-            LOG_ERROR(Service_NVDRV, "Unknown video codec {}", current_codec);
-            return;
-        }
+    av_codec_ctx = avcodec_alloc_context3(av_codec);
+    av_opt_set(av_codec_ctx->priv_data, "tune", "zerolatency", 0);
+
+    // Decode slices in parallel. Frame threading is not used, it delays the output of each frame
+    // by one packet per thread, while VIC expects the frame of a packet as soon as it is decoded.
+    const int num_threads = static_cast<int>(std::thread::hardware_concurrency());
+    av_codec_ctx->thread_count = std::clamp(num_threads, 1, MAX_DECODER_THREADS);
+    av_codec_ctx->thread_type = FF_THREAD_SLICE;
 
-        av_codec_ctx = avcodec_alloc_context3(av_codec);
-        av_opt_set(av_codec_ctx->priv_data, "tune", "zerolatency", 0);
+    // TODO(ameerj): libavcodec gpu hw acceleration
 
-        // TODO(ameerj): libavcodec gpu hw acceleration
+    const auto av_error = avcodec_open2(av_codec_ctx, av_codec, nullptr);
+    if (av_error < 0) {
+        LOG_ERROR(Service_NVDRV, "avcodec_open2() Failed.");
+        avcodec_close(av_codec_ctx);
+        return;
+    }
+    initialized = true;
+}
 
-        const auto av_error = avcodec_open2(av_codec_ctx, av_codec, nullptr);
-        if (av_error < 0) {
-            LOG_ERROR(Service_NVDRV, "avcodec_open2() Failed.");
-            avcodec_close(av_codec_ctx);
+void Codec::Decode() {
+    const bool is_first_frame = !initialized;
+    if (!initialized) {
+        InitializeAvCodec();
+        if (!initialized) {
             return;
         }
-        initialized = true;
-        is_first_frame = true;
     }
-    bool vp9_hidden_frame = false;
 
-    AVPacket packet{};
-    av_init_packet(&packet);
+    // The headers and bitstream are read from guest memory here, on the GPU thread, so they are
+    // consistent with the command stream. Only the decode itself is deferred.
     std::vector<u8> frame_data;
-
     if (current_codec == NvdecCommon::VideoCodec::H264) {
         frame_data = h264_decoder->ComposeFrameHeader(state, is_first_frame);
     } else if (current_codec == NvdecCommon::VideoCodec::Vp9) {
         frame_data = vp9_decoder->ComposeFrameHeader(state);
-        vp9_hidden_frame = vp9_decoder->WasFrameHidden();
     }
 
-    packet.data = frame_data.data();
+    decode_worker.QueueWork(
+        [this, frame_data = std::move(frame_data)] { DecodeFrame(frame_data); });
+}
+
+void Codec::DecodeFrame(const std::vector<u8>& frame_data) {
+    const auto decode_start = std::chrono::steady_clock::now();
+
+    AVPacket packet{};
+    av_init_packet(&packet);
+    packet.data = const_cast<u8*>(frame_data.data());
     packet.size = static_cast<int>(frame_data.size());
 
     avcodec_send_packet(av_codec_ctx, &packet);
 
-    if (!vp9_hidden_frame) {
-        // Only receive/store visible frames
-        AVFramePtr frame = AVFramePtr{av_frame_alloc(), AVFrameDeleter};
-        avcodec_receive_frame(av_codec_ctx, frame.get());
+    // Receive every frame that is ready, hidden VP9 frames produce no output.
+    while (true) {
+        AVFramePtr frame = AllocateFrame();
+        if (avcodec_receive_frame(av_codec_ctx, frame.get()) < 0) {
+            RecycleFrame(std::move(frame));
+            break;
+        }
+        ++decoded_frames;
+
+        std::scoped_lock lock{frames_mutex};
         av_frames.push(std::move(frame));
-        // Limit queue to 10 frames. Workaround for ZLA decode and queue spam
-        if (av_frames.size() > 10) {
+        // Workaround for ZLA decode and queue spam
+        if (av_frames.size() > MAX_QUEUED_FRAMES) {
+            AVFramePtr dropped = std::move(av_frames.front());
             av_frames.pop();
+            av_frame_unref(dropped.get());
+            frame_pool.push_back(std::move(dropped));
         }
     }
+
+    decode_time += std::chrono::steady_clock::now() - decode_start;
+    if (decoded_frames >= 300) {
+        const double seconds = std::chrono::duration<double>(decode_time).count();
+        LOG_DEBUG(Service_NVDRV, "Decoded {} frames at {:.1f} fps with {} threads", decoded_frames,
+                  seconds > 0.0 ? static_cast<double>(decoded_frames) / seconds : 0.0,
+                  av_codec_ctx->thread_count);
+        decoded_frames = 0;
+        decode_time = {};
+    }
+}
+
+void Codec::OnDecodesDone(std::function<void()>&& callback) {
+    decode_worker.QueueWork(std::move(callback));
 }
 
 AVFramePtr Codec::GetCurrentFrame() {
+    decode_worker.WaitForRequests();
+
     // Sometimes VIC will request more frames than have been decoded.
     // in this case, return a nullptr and don't overwrite previous frame data
+    std::scoped_lock lock{frames_mutex};
     if (av_frames.empty()) {
         return AVFramePtr{nullptr, AVFrameDeleter};
     }
@@ -122,6 +178,27 @@ AVFramePtr Codec::GetCurrentFrame() {
     return frame;
 }
 
+void Codec::RecycleFrame(AVFramePtr&& frame) {
+    if (!frame) {
+        return;
+    }
+    av_frame_unref(frame.get());
+    std::scoped_lock lock{frames_mutex};
+    frame_pool.push_back(std::move(frame));
+}
+
+AVFramePtr Codec::AllocateFrame() {
+    {
+        std::scoped_lock lock{frames_mutex};
+        if (!frame_pool.empty()) {
+            AVFramePtr frame = std::move(frame_pool.back());
+            frame_pool.pop_back();
+            return frame;
+        }
+    }
+    return AVFramePtr{av_frame_alloc(), AVFrameDeleter};
+}
+
 NvdecCommon::VideoCodec Codec::GetCurrentCodec() const {
     return current_codec;
 }
@@ -4,9 +4,14 @@
 
 #pragma once
 
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <queue>
+#include <vector>
 #include "common/common_types.h"
+#include "common/thread_worker.h"
 #include "video_core/command_classes/nvdec_common.h"
 
 extern "C" {
@@ -43,16 +48,32 @@ public:
     /// Populate NvdecRegisters state with argument value at the provided offset
     void StateWrite(u32 offset, u64 arguments);
 
-    /// Call decoders to construct headers, decode AVFrame with ffmpeg
+    /// Call decoders to construct headers and queue the frame to be decoded with ffmpeg on the
+    /// decoder thread
     void Decode();
 
-    /// Returns next decoded frame
+    /// Queues a callback to be called on the decoder thread once all previous frames are decoded
+    void OnDecodesDone(std::function<void()>&& callback);
+
+    /// Returns next decoded frame, waiting for any pending decode
     [[nodiscard]] AVFramePtr GetCurrentFrame();
 
+    /// Returns a frame obtained from GetCurrentFrame to the pool so its allocation can be reused
+    void RecycleFrame(AVFramePtr&& frame);
+
     /// Returns the value of current_codec
     [[nodiscard]] NvdecCommon::VideoCodec GetCurrentCodec() const;
 
 private:
+    /// Opens the libavcodec decoder for the current codec
+    void InitializeAvCodec();
+
+    /// Decodes a composed frame, runs on the decoder thread
+    void DecodeFrame(const std::vector<u8>& frame_data);
+
+    /// Takes a frame from the pool or allocates a new one
+    AVFramePtr AllocateFrame();
+
     bool initialized{};
     NvdecCommon::VideoCodec current_codec{NvdecCommon::VideoCodec::None};
 
@@ -64,7 +85,16 @@ private:
     std::unique_ptr<Decoder::VP9> vp9_decoder;
 
     NvdecCommon::NvdecRegisters state{};
+
+    std::mutex frames_mutex;
     std::queue<AVFramePtr> av_frames{};
+    std::vector<AVFramePtr> frame_pool;
+
+    u64 decoded_frames{};
+    std::chrono::nanoseconds decode_time{};
+
+    /// Runs the libavcodec calls in order, off the GPU thread
+    Common::ThreadWorker decode_worker{1, "yuzu:NvdecDecoder"};
 };
 
 } // namespace Tegra
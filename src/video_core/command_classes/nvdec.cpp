@@ -33,6 +33,14 @@ AVFramePtr Nvdec::GetFrame() {
     return codec->GetCurrentFrame();
 }
 
+void Nvdec::RecycleFrame(AVFramePtr&& frame) {
+    codec->RecycleFrame(std::move(frame));
+}
+
+void Nvdec::OnDecodesDone(std::function<void()>&& callback) {
+    codec->OnDecodesDone(std::move(callback));
+}
+
 void Nvdec::Execute() {
     switch (codec->GetCurrentCodec()) {
     case NvdecCommon::VideoCodec::H264:
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <vector>
 #include "common/common_types.h"
@@ -28,6 +29,12 @@ public:
     /// Return most recently decoded frame
     [[nodiscard]] AVFramePtr GetFrame();
 
+    /// Return a frame obtained from GetFrame once it is no longer needed
+    void RecycleFrame(AVFramePtr&& frame);
+
+    /// Call the callback from the decoder thread once all frames executed so far are decoded
+    void OnDecodesDone(std::function<void()>&& callback);
+
 private:
     /// Invoke codec to decode a frame
     void Execute();
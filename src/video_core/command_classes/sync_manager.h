@@ -54,6 +54,8 @@ public:
     void IncrementAllDone();
 
 private:
+    void IncrementAllDoneLocked();
+
     std::vector<SyncptIncr> increments;
     std::mutex increment_lock;
     u32 current_id{};
@@ -3,9 +3,13 @@
 // Refer to the license.txt file included.
 
 #include <array>
+#include <chrono>
 #include "common/assert.h"
+#include "common/microprofile.h"
+#include "common/scope_exit.h"
 #include "video_core/command_classes/nvdec.h"
 #include "video_core/command_classes/vic.h"
+#include "video_core/command_classes/vic_conversion.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/gpu.h"
 #include "video_core/memory_manager.h"
@@ -15,11 +19,17 @@ extern "C" {
 #include <libswscale/swscale.h>
 }
 
+MICROPROFILE_DEFINE(GPU_VicConversion, "GPU", "VIC frame conversion", MP_RGB(128, 192, 128));
+
 namespace Tegra {
 
 Vic::Vic(GPU& gpu_, std::shared_ptr<Nvdec> nvdec_processor_)
     : gpu(gpu_), nvdec_processor(std::move(nvdec_processor_)) {}
-Vic::~Vic() = default;
+
+Vic::~Vic() {
+    sws_freeContext(scaler_ctx);
+    av_free(converted_frame_buffer);
+}
 
 void Vic::VicStateWrite(u32 offset, u32 arguments) {
     u8* const state_offset = reinterpret_cast<u8*>(&vic_state) + offset * sizeof(u32);
@@ -58,118 +68,144 @@ void Vic::Execute() {
         return;
     }
     const VicConfig config{gpu.MemoryManager().Read<u64>(config_struct_address + 0x20)};
-    const AVFramePtr frame_ptr = nvdec_processor->GetFrame();
+    AVFramePtr frame_ptr = nvdec_processor->GetFrame();
+    SCOPE_EXIT({ nvdec_processor->RecycleFrame(std::move(frame_ptr)); });
     const auto* frame = frame_ptr.get();
     if (!frame || frame->width == 0 || frame->height == 0) {
         return;
     }
     const VideoPixelFormat pixel_format =
         static_cast<VideoPixelFormat>(config.pixel_format.Value());
+
+    MICROPROFILE_SCOPE(GPU_VicConversion);
+    const auto conversion_start = std::chrono::steady_clock::now();
     switch (pixel_format) {
     case VideoPixelFormat::BGRA8:
-    case VideoPixelFormat::RGBA8: {
-        LOG_TRACE(Service_NVDRV, "Writing RGB Frame");
-
-        if (scaler_ctx == nullptr || frame->width != scaler_width ||
-            frame->height != scaler_height) {
-            const AVPixelFormat target_format =
-                (pixel_format == VideoPixelFormat::RGBA8) ? AV_PIX_FMT_RGBA : AV_PIX_FMT_BGRA;
-
-            sws_freeContext(scaler_ctx);
-            scaler_ctx = nullptr;
+    case VideoPixelFormat::RGBA8:
+        WriteRgbFrame(*frame, config, pixel_format);
+        break;
+    case VideoPixelFormat::Yuv420:
+        WriteYuvFrame(*frame, config);
+        break;
+    default:
+        UNIMPLEMENTED_MSG("Unknown video pixel format {}", config.pixel_format.Value());
+        return;
+    }
+    LOG_TRACE(Service_NVDRV, "Converted {}x{} frame in {} us", frame->width, frame->height,
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::steady_clock::now() - conversion_start)
+                  .count());
+}
 
-            // FFmpeg returns all frames in YUV420, convert it into expected format
-            scaler_ctx =
-                sws_getContext(frame->width, frame->height, AV_PIX_FMT_YUV420P, frame->width,
-                               frame->height, target_format, 0, nullptr, nullptr, nullptr);
+void Vic::WriteRgbFrame(const AVFrame& frame, const VicConfig& config,
+                        VideoPixelFormat pixel_format) {
+    LOG_TRACE(Service_NVDRV, "Writing RGB Frame");
+
+    if (scaler_ctx == nullptr || frame.width != scaler_width || frame.height != scaler_height ||
+        pixel_format != scaler_format) {
+        sws_freeContext(scaler_ctx);
+        scaler_ctx = nullptr;
+
+        // FFmpeg returns all frames in YUV420, convert it into expected format. swscale already
+        // has vectorized paths for this conversion.
+        const AVPixelFormat target_format =
+            (pixel_format == VideoPixelFormat::RGBA8) ? AV_PIX_FMT_RGBA : AV_PIX_FMT_BGRA;
+        scaler_ctx = sws_getContext(frame.width, frame.height, AV_PIX_FMT_YUV420P, frame.width,
+                                    frame.height, target_format, 0, nullptr, nullptr, nullptr);
+
+        scaler_width = frame.width;
+        scaler_height = frame.height;
+        scaler_format = pixel_format;
+    }
 
-            scaler_width = frame->width;
-            scaler_height = frame->height;
+    const std::size_t linear_size = frame.width * frame.height * 4;
+    const int converted_stride{frame.width * 4};
+    const auto convert = [&](u8* destination) {
+        sws_scale(scaler_ctx, frame.data, frame.linesize, 0, frame.height, &destination,
+                  &converted_stride);
+    };
+    const auto converted_frame = [&] {
+        if (converted_frame_buffer_size < linear_size) {
+            av_free(converted_frame_buffer);
+            converted_frame_buffer = static_cast<u8*>(av_malloc(linear_size));
+            converted_frame_buffer_size = linear_size;
         }
-        // Get Converted frame
-        const std::size_t linear_size = frame->width * frame->height * 4;
-
-        using AVMallocPtr = std::unique_ptr<u8, decltype(&av_free)>;
-        AVMallocPtr converted_frame_buffer{static_cast<u8*>(av_malloc(linear_size)), av_free};
-
-        const int converted_stride{frame->width * 4};
-        u8* const converted_frame_buf_addr{converted_frame_buffer.get()};
-
-        sws_scale(scaler_ctx, frame->data, frame->linesize, 0, frame->height,
-                  &converted_frame_buf_addr, &converted_stride);
-
-        const u32 blk_kind = static_cast<u32>(config.block_linear_kind);
-        if (blk_kind != 0) {
-            // swizzle pitch linear to block linear
-            const u32 block_height = static_cast<u32>(config.block_linear_height_log2);
-            const auto size = Tegra::Texture::CalculateSize(true, 4, frame->width, frame->height, 1,
-                                                            block_height, 0);
-            std::vector<u8> swizzled_data(size);
-            Tegra::Texture::SwizzleSubrect(frame->width, frame->height, frame->width * 4,
-                                           frame->width, 4, swizzled_data.data(),
-                                           converted_frame_buffer.get(), block_height, 0, 0);
-
-            gpu.MemoryManager().WriteBlock(output_surface_luma_address, swizzled_data.data(), size);
-            gpu.Maxwell3D().OnMemoryWrite();
+        convert(converted_frame_buffer);
+        return converted_frame_buffer;
+    };
+
+    auto& memory_manager = gpu.MemoryManager();
+    const u32 blk_kind = static_cast<u32>(config.block_linear_kind);
+    if (blk_kind != 0) {
+        // swizzle pitch linear to block linear
+        const u32 block_height = static_cast<u32>(config.block_linear_height_log2);
+        const auto size = Tegra::Texture::CalculateSize(true, 4, frame.width, frame.height, 1,
+                                                        block_height, 0);
+        const u8* const source = converted_frame();
+        if (u8* const output = memory_manager.GetWritePointer(output_surface_luma_address, size)) {
+            Tegra::Texture::SwizzleSubrect(frame.width, frame.height, frame.width * 4, frame.width,
+                                           4, output, source, block_height, 0, 0);
         } else {
-            // send pitch linear frame
-            gpu.MemoryManager().WriteBlock(output_surface_luma_address, converted_frame_buf_addr,
-                                           linear_size);
-            gpu.Maxwell3D().OnMemoryWrite();
+            swizzled_data.resize(size);
+            Tegra::Texture::SwizzleSubrect(frame.width, frame.height, frame.width * 4, frame.width,
+                                           4, swizzled_data.data(), source, block_height, 0, 0);
+            memory_manager.WriteBlock(output_surface_luma_address, swizzled_data.data(), size);
         }
-        break;
+    } else if (u8* const output =
+                   memory_manager.GetWritePointer(output_surface_luma_address, linear_size)) {
+        // convert straight into the pitch linear surface
+        convert(output);
+    } else {
+        // send pitch linear frame
+        memory_manager.WriteBlock(output_surface_luma_address, converted_frame(), linear_size);
     }
-    case VideoPixelFormat::Yuv420: {
-        LOG_TRACE(Service_NVDRV, "Writing YUV420 Frame");
-
-        const std::size_t surface_width = config.surface_width_minus1 + 1;
-        const std::size_t surface_height = config.surface_height_minus1 + 1;
-        const std::size_t half_width = surface_width / 2;
-        const std::size_t half_height = config.surface_height_minus1 / 2;
-        const std::size_t aligned_width = (surface_width + 0xff) & ~0xff;
-
-        const auto* luma_ptr = frame->data[0];
-        const auto* chroma_b_ptr = frame->data[1];
-        const auto* chroma_r_ptr = frame->data[2];
-        const auto stride = frame->linesize[0];
-        const auto half_stride = frame->linesize[1];
-
-        std::vector<u8> luma_buffer(aligned_width * surface_height);
-        std::vector<u8> chroma_buffer(aligned_width * half_height);
-
-        // Populate luma buffer
-        for (std::size_t y = 0; y < surface_height - 1; ++y) {
-            std::size_t src = y * stride;
-            std::size_t dst = y * aligned_width;
-
-            std::size_t size = surface_width;
-
-            for (std::size_t offset = 0; offset < size; ++offset) {
-                luma_buffer[dst + offset] = luma_ptr[src + offset];
-            }
-        }
-        gpu.MemoryManager().WriteBlock(output_surface_luma_address, luma_buffer.data(),
-                                       luma_buffer.size());
-
-        // Populate chroma buffer from both channels with interleaving.
-        for (std::size_t y = 0; y < half_height; ++y) {
-            std::size_t src = y * half_stride;
-            std::size_t dst = y * aligned_width;
-
-            for (std::size_t x = 0; x < half_width; ++x) {
-                chroma_buffer[dst + x * 2] = chroma_b_ptr[src + x];
-                chroma_buffer[dst + x * 2 + 1] = chroma_r_ptr[src + x];
-            }
-        }
-        gpu.MemoryManager().WriteBlock(output_surface_chroma_u_address, chroma_buffer.data(),
-                                       chroma_buffer.size());
-        gpu.Maxwell3D().OnMemoryWrite();
-        break;
+    gpu.Maxwell3D().OnMemoryWrite();
+}
+
+void Vic::WriteYuvFrame(const AVFrame& frame, const VicConfig& config) {
+    LOG_TRACE(Service_NVDRV, "Writing YUV420 Frame");
+
+    const std::size_t surface_width = config.surface_width_minus1 + 1;
+    const std::size_t surface_height = config.surface_height_minus1 + 1;
+    const std::size_t half_width = surface_width / 2;
+    const std::size_t half_height = config.surface_height_minus1 / 2;
+    const std::size_t aligned_width = (surface_width + 0xff) & ~0xff;
+
+    const auto stride = static_cast<std::size_t>(frame.linesize[0]);
+    const auto half_stride = static_cast<std::size_t>(frame.linesize[1]);
+
+    auto& memory_manager = gpu.MemoryManager();
+
+    // Populate luma surface
+    const std::size_t luma_size = aligned_width * surface_height;
+    const auto write_luma = [&](u8* destination) {
+        VicConversion::CopyPlane(destination, aligned_width, frame.data[0], stride, surface_width,
+                                 surface_height - 1);
+    };
+    if (u8* const output = memory_manager.GetWritePointer(output_surface_luma_address, luma_size)) {
+        write_luma(output);
+    } else {
+        luma_buffer.resize(luma_size);
+        write_luma(luma_buffer.data());
+        memory_manager.WriteBlock(output_surface_luma_address, luma_buffer.data(), luma_size);
     }
-    default:
-        UNIMPLEMENTED_MSG("Unknown video pixel format {}", config.pixel_format.Value());
-        break;
+
+    // Populate chroma surface from both channels with interleaving.
+    const std::size_t chroma_size = aligned_width * half_height;
+    const auto write_chroma = [&](u8* destination) {
+        VicConversion::InterleaveChroma(destination, aligned_width, frame.data[1], frame.data[2],
+                                        half_stride, half_width, half_height);
+    };
+    if (u8* const output =
+            memory_manager.GetWritePointer(output_surface_chroma_u_address, chroma_size)) {
+        write_chroma(output);
+    } else {
+        chroma_buffer.resize(chroma_size);
+        write_chroma(chroma_buffer.data());
+        memory_manager.WriteBlock(output_surface_chroma_u_address, chroma_buffer.data(),
+                                  chroma_size);
     }
+    gpu.Maxwell3D().OnMemoryWrite();
 }
 
 } // namespace Tegra
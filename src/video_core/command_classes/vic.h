@@ -9,6 +9,7 @@
 #include "common/bit_field.h"
 #include "common/common_types.h"
 
+struct AVFrame;
 struct SwsContext;
 
 namespace Tegra {
@@ -70,11 +71,6 @@ public:
     void ProcessMethod(Method method, const std::vector<u32>& arguments);
 
 private:
-    void Execute();
-
-    void VicStateWrite(u32 offset, u32 arguments);
-    VicRegisters vic_state{};
-
     enum class VideoPixelFormat : u64_le {
         RGBA8 = 0x1f,
         BGRA8 = 0x20,
@@ -94,6 +90,18 @@ private:
         BitField<46, 14, u64_le> surface_height_minus1;
     };
 
+    void Execute();
+
+    /// Converts the frame to RGBA or BGRA and writes it to the output surface.
+    void WriteRgbFrame(const AVFrame& frame, const VicConfig& config,
+                       VideoPixelFormat pixel_format);
+
+    /// Writes the frame to the output surface as NV12 luma and interleaved chroma planes.
+    void WriteYuvFrame(const AVFrame& frame, const VicConfig& config);
+
+    void VicStateWrite(u32 offset, u32 arguments);
+    VicRegisters vic_state{};
+
     GPU& gpu;
     std::shared_ptr<Tegra::Nvdec> nvdec_processor;
 
@@ -105,6 +113,14 @@ private:
     SwsContext* scaler_ctx{};
     s32 scaler_width{};
     s32 scaler_height{};
+    VideoPixelFormat scaler_format{};
+
+    /// Conversion buffers, reused between frames
+    u8* converted_frame_buffer{};
+    std::size_t converted_frame_buffer_size{};
+    std::vector<u8> swizzled_data;
+    std::vector<u8> luma_buffer;
+    std::vector<u8> chroma_buffer;
 };
 
 } // namespace Tegra
@@ -0,0 +1,51 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+
+#ifdef ARCHITECTURE_x86_64
+#include <emmintrin.h>
+#endif
+
+#include "video_core/command_classes/vic_conversion.h"
+
+namespace Tegra::VicConversion {
+
+void CopyPlane(u8* dst, std::size_t dst_stride, const u8* src, std::size_t src_stride,
+               std::size_t width, std::size_t height) {
+    if (dst_stride == width && src_stride == width) {
+        std::memcpy(dst, src, width * height);
+        return;
+    }
+    for (std::size_t y = 0; y < height; ++y) {
+        std::memcpy(dst + y * dst_stride, src + y * src_stride, width);
+    }
+}
+
+void InterleaveChroma(u8* dst, std::size_t dst_stride, const u8* src_u, const u8* src_v,
+                      std::size_t src_stride, std::size_t width, std::size_t height) {
+    for (std::size_t y = 0; y < height; ++y) {
+        const u8* const row_u = src_u + y * src_stride;
+        const u8* const row_v = src_v + y * src_stride;
+        u8* const row_dst = dst + y * dst_stride;
+
+        std::size_t x = 0;
+#ifdef ARCHITECTURE_x86_64
+        // SSE2 is always available on x86_64, interleave 16 pairs at a time
+        for (; x + 16 <= width; x += 16) {
+            const __m128i u = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row_u + x));
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row_v + x));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row_dst + x * 2), _mm_unpacklo_epi8(u, v));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(row_dst + x * 2 + 16),
+                             _mm_unpackhi_epi8(u, v));
+        }
+#endif
+        for (; x < width; ++x) {
+            row_dst[x * 2] = row_u[x];
+            row_dst[x * 2 + 1] = row_v[x];
+        }
+    }
+}
+
+} // namespace Tegra::VicConversion
@@ -0,0 +1,24 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include "common/common_types.h"
+
+namespace Tegra::VicConversion {
+
+/// Copies width bytes from each of the height rows of a plane into a destination with a
+/// different stride.
+void CopyPlane(u8* dst, std::size_t dst_stride, const u8* src, std::size_t src_stride,
+               std::size_t width, std::size_t height);
+
+/**
+ * Interleaves the U and V planes of a YUV420 frame into a single UV plane, as used by NV12.
+ * @param width Number of UV pairs written per row
+ */
+void InterleaveChroma(u8* dst, std::size_t dst_stride, const u8* src_u, const u8* src_v,
+                      std::size_t src_stride, std::size_t width, std::size_t height);
+
+} // namespace Tegra::VicConversion
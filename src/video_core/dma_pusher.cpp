@@ -95,6 +95,18 @@ bool DmaPusher::Step() {
                 dma_state.is_last_call = true;
                 index += max_write;
                 continue;
+            } else if (!dma_increment_once && dma_state.method >= non_puller_methods) {
+                // Data words of an incrementing command are handed to the engine as a whole, so it
+                // can store contiguous plain registers in bulk
+                const u32 max_write = static_cast<u32>(
+                    std::min<std::size_t>(index + dma_state.method_count, command_headers.size()) -
+                    index);
+                CallMethodRange(&command_header.argument, max_write);
+                dma_state.method += max_write;
+                dma_state.method_count -= max_write;
+                dma_state.is_last_call = true;
+                index += max_write;
+                continue;
             } else {
                 dma_state.is_last_call = dma_state.method_count <= 1;
                 CallMethod(command_header.argument);
@@ -164,6 +176,11 @@ void DmaPusher::CallMethod(u32 argument) const {
     }
 }
 
+void DmaPusher::CallMethodRange(const u32* base_start, u32 num_methods) const {
+    subchannels[dma_state.subchannel]->CallMethodRange(dma_state.method, base_start, num_methods,
+                                                       dma_state.method_count);
+}
+
 void DmaPusher::CallMultiMethod(const u32* base_start, u32 num_methods) const {
     if (dma_state.method < non_puller_methods) {
         gpu.CallMultiMethod(dma_state.method, dma_state.subchannel, base_start, num_methods,
@@ -2,6 +2,8 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <optional>
 #include "common/assert.h"
@@ -21,6 +23,53 @@ using VideoCore::QueryType;
 /// First register id that is actually a Macro call.
 constexpr u32 MacroRegistersStart = 0xE00;
 
+namespace {
+
+using Regs = Maxwell3D::Regs;
+
+/// Registers whose writes are handled by ProcessMethodCall. Keep in sync with its switch.
+constexpr std::array<bool, Regs::NUM_REGS> SIDE_EFFECT_REGISTERS = [] {
+    std::array<bool, Regs::NUM_REGS> table{};
+    const auto mark = [&table](std::size_t first, std::size_t count = 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            table[first + i] = true;
+        }
+    };
+    mark(MAXWELL3D_REG_INDEX(wait_for_idle));
+    mark(MAXWELL3D_REG_INDEX(shadow_ram_control));
+    mark(MAXWELL3D_REG_INDEX(macros.data));
+    mark(MAXWELL3D_REG_INDEX(macros.bind));
+    mark(MAXWELL3D_REG_INDEX(firmware[4]));
+    mark(MAXWELL3D_REG_INDEX(const_buffer.cb_data), Regs::NumCBData);
+    for (std::size_t stage = 0; stage < Regs::MaxShaderStage; ++stage) {
+        mark(MAXWELL3D_REG_INDEX(cb_bind) + stage * sizeof(Regs::cb_bind[0]) / sizeof(u32));
+    }
+    mark(MAXWELL3D_REG_INDEX(draw.vertex_end_gl));
+    mark(MAXWELL3D_REG_INDEX(clear_buffers));
+    mark(MAXWELL3D_REG_INDEX(query.query_get));
+    mark(MAXWELL3D_REG_INDEX(condition.mode));
+    mark(MAXWELL3D_REG_INDEX(counter_reset));
+    mark(MAXWELL3D_REG_INDEX(sync_info));
+    mark(MAXWELL3D_REG_INDEX(exec_upload));
+    mark(MAXWELL3D_REG_INDEX(data_upload));
+    mark(MAXWELL3D_REG_INDEX(fragment_barrier));
+    mark(MAXWELL3D_REG_INDEX(tiled_cache_barrier));
+    return table;
+}();
+
+/// Number of consecutive registers starting at each index that only store their value.
+constexpr std::array<u16, Regs::NUM_REGS> PLAIN_RUN_LENGTHS = [] {
+    std::array<u16, Regs::NUM_REGS> table{};
+    u16 run = 0;
+    for (std::size_t i = Regs::NUM_REGS; i-- > 0;) {
+        run = SIDE_EFFECT_REGISTERS[i] ? 0 : static_cast<u16>(run + 1);
+        table[i] = run;
+    }
+    return table;
+}();
+
+} // Anonymous namespace
+
 Maxwell3D::Maxwell3D(Core::System& system_, MemoryManager& memory_manager_)
     : system{system_}, memory_manager{memory_manager_}, macro_engine{GetMacroEngine(*this)},
       upload_state{memory_manager, regs.upload} {
@@ -167,6 +216,9 @@ void Maxwell3D::ProcessDirtyRegisters(u32 method, u32 argument) {
 
 void Maxwell3D::ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument,
                                   bool is_last_call) {
+    if (!SIDE_EFFECT_REGISTERS[method]) {
+        return;
+    }
     switch (method) {
     case MAXWELL3D_REG_INDEX(wait_for_idle):
         return rasterizer->WaitForIdle();
@@ -313,6 +365,54 @@ void Maxwell3D::CallMultiMethod(u32 method, const u32* base_start, u32 amount,
     }
 }
 
+void Maxwell3D::CallMethodRange(u32 method, const u32* base_start, u32 amount,
+                                u32 methods_pending) {
+    u32 offset = 0;
+    while (offset < amount) {
+        const u32 current = method + offset;
+        const u32 run = PlainStoreLength(current, amount - offset);
+        if (run == 0) {
+            CallMethod(current, base_start[offset], methods_pending - offset <= 1);
+            ++offset;
+            continue;
+        }
+        StoreRegisters(current, base_start + offset, run);
+        offset += run;
+    }
+}
+
+u32 Maxwell3D::PlainStoreLength(u32 method, u32 amount) const {
+    if (method >= MacroRegistersStart || executing_macro != 0 ||
+        cb_data_state.current != null_cb_data ||
+        shadow_state.shadow_ram_control == Regs::ShadowRamControl::Replay) {
+        return 0;
+    }
+    return std::min<u32>(amount, PLAIN_RUN_LENGTHS[method]);
+}
+
+void Maxwell3D::StoreRegisters(u32 method, const u32* values, u32 amount) {
+    const std::size_t size = amount * sizeof(u32);
+    const auto control = shadow_state.shadow_ram_control;
+    if (control == Regs::ShadowRamControl::Track ||
+        control == Regs::ShadowRamControl::TrackWithFilter) {
+        std::memcpy(&shadow_state.reg_array[method], values, size);
+    }
+
+    u32* const registers = &regs.reg_array[method];
+    if (std::memcmp(registers, values, size) == 0) {
+        return;
+    }
+    for (u32 i = 0; i < amount; ++i) {
+        if (registers[i] == values[i]) {
+            continue;
+        }
+        for (const auto& table : dirty.tables) {
+            dirty.flags[table[method + i]] = true;
+        }
+    }
+    std::memcpy(registers, values, size);
+}
+
 void Maxwell3D::StepInstance(const MMEDrawMode expected_mode, const u32 count) {
     if (mme_draw.current_mode == MMEDrawMode::Undefined) {
         if (mme_draw.gl_begin_consume) {
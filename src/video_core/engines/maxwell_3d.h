@@ -1418,6 +1418,10 @@ public:
     void CallMultiMethod(u32 method, const u32* base_start, u32 amount,
                          u32 methods_pending) override;
 
+    /// Write multiple values to consecutive registers, storing runs without side effects in bulk.
+    void CallMethodRange(u32 method, const u32* base_start, u32 amount,
+                         u32 methods_pending) override;
+
     /// Write the value to the register identified by method.
     void CallMethodFromMME(u32 method, u32 method_argument);
 
@@ -1491,6 +1495,12 @@ private:
 
     void ProcessDirtyRegisters(u32 method, u32 argument);
 
+    /// Returns how many of the amount registers starting at method can be stored in bulk.
+    u32 PlainStoreLength(u32 method, u32 amount) const;
+
+    /// Stores registers without side effects, marking the changed ones as dirty.
+    void StoreRegisters(u32 method, const u32* values, u32 amount);
+
     void ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument, bool is_last_call);
 
     /// Retrieves information about a specific TIC entry from the TIC buffer.
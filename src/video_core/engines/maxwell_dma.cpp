@@ -2,8 +2,13 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <cstring>
+#include <thread>
 #include "common/assert.h"
+#include "common/div_ceil.h"
 #include "common/logging/log.h"
+#include "common/thread_worker.h"
 #include "core/core.h"
 #include "core/settings.h"
 #include "video_core/engines/maxwell_3d.h"
@@ -16,6 +21,25 @@ namespace Tegra::Engines {
 
 using namespace Texture;
 
+namespace {
+
+// Copies smaller than this are not worth waking up the copy workers for
+constexpr std::size_t PARALLEL_COPY_THRESHOLD = 4 * 1024 * 1024;
+// Linear copies are split in chunks of this size between the copy workers
+constexpr std::size_t LINEAR_CHUNK_SIZE = 64 * 1024;
+
+std::size_t NumCopyWorkers() {
+    static const std::size_t num_workers =
+        std::clamp<std::size_t>(std::thread::hardware_concurrency() / 2, 1, 4) - 1;
+    return num_workers;
+}
+
+bool Overlaps(const u8* a, std::size_t a_size, const u8* b, std::size_t b_size) {
+    return a < b + b_size && b < a + a_size;
+}
+
+} // Anonymous namespace
+
 MaxwellDMA::MaxwellDMA(Core::System& system_, MemoryManager& memory_manager_)
     : system{system_}, memory_manager{memory_manager_} {}
 
@@ -76,22 +100,83 @@ void MaxwellDMA::Launch() {
     }
 }
 
+template <typename Func>
+void MaxwellDMA::ForEachLineBand(u32 line_count, std::size_t num_bytes, Func&& func) {
+    const std::size_t num_workers = NumCopyWorkers();
+    if (num_bytes < PARALLEL_COPY_THRESHOLD || num_workers == 0 || line_count < 2) {
+        func(0, line_count);
+        return;
+    }
+    if (!copy_workers) {
+        copy_workers = std::make_unique<Common::ThreadWorker>(num_workers, "yuzu:DmaCopy");
+    }
+    const u32 num_bands = static_cast<u32>(std::min<std::size_t>(num_workers + 1, line_count));
+    const u32 band_lines = Common::DivCeil(line_count, num_bands);
+    for (u32 first_line = band_lines; first_line < line_count; first_line += band_lines) {
+        copy_workers->QueueWork([&func, first_line, band_lines, line_count] {
+            func(first_line, std::min(band_lines, line_count - first_line));
+        });
+    }
+    func(0, band_lines);
+    copy_workers->WaitForRequests();
+}
+
 void MaxwellDMA::CopyPitchToPitch() {
     // When `multi_line_enable` bit is disabled the copy is performed as if we were copying a 1D
     // buffer of length `line_length_in`.
     // Otherwise we copy a 2D image of dimensions (line_length_in, line_count).
-    if (!regs.launch_dma.multi_line_enable) {
-        memory_manager.CopyBlock(regs.offset_out, regs.offset_in, regs.line_length_in);
+    const bool is_multi_line = regs.launch_dma.multi_line_enable != 0;
+    const u32 line_count = is_multi_line ? regs.line_count : 1;
+    const std::size_t line_length = regs.line_length_in;
+    if (line_count == 0 || line_length == 0) {
+        return;
+    }
+    const std::size_t src_span = static_cast<std::size_t>(line_count - 1) * regs.pitch_in +
+                                 line_length;
+    const std::size_t dst_span = static_cast<std::size_t>(line_count - 1) * regs.pitch_out +
+                                 line_length;
+
+    // Flush and invalidate once for the whole operation instead of once per line.
+    memory_manager.FlushRegion(regs.offset_in, src_span);
+    memory_manager.InvalidateRegion(regs.offset_out, dst_span);
+
+    const u8* const src = memory_manager.GetPointerRange(regs.offset_in, src_span);
+    u8* const dst = memory_manager.GetPointerRange(regs.offset_out, dst_span);
+    if (src != nullptr && dst != nullptr) {
+        const auto copy_lines = [&](u32 first_line, u32 num_lines) {
+            for (u32 line = first_line; line < first_line + num_lines; ++line) {
+                std::memmove(dst + static_cast<std::size_t>(line) * regs.pitch_out,
+                             src + static_cast<std::size_t>(line) * regs.pitch_in, line_length);
+            }
+        };
+        if (Overlaps(src, src_span, dst, dst_span)) {
+            // Lines have to be copied in order to match the hardware
+            copy_lines(0, line_count);
+        } else if (line_count == 1) {
+            // Split large linear copies in chunks
+            const auto num_chunks =
+                static_cast<u32>(Common::DivCeil(line_length, LINEAR_CHUNK_SIZE));
+            ForEachLineBand(num_chunks, line_length, [&](u32 first_chunk, u32 count) {
+                const std::size_t offset = first_chunk * LINEAR_CHUNK_SIZE;
+                const std::size_t size = std::min(count * LINEAR_CHUNK_SIZE, line_length - offset);
+                std::memcpy(dst + offset, src + offset, size);
+            });
+        } else {
+            ForEachLineBand(line_count, line_length * line_count, copy_lines);
+        }
         return;
     }
 
-    // Perform a line-by-line copy.
+    // Perform a line-by-line copy through the staging buffer.
     // We're going to take a subrect of size (line_length_in, line_count) from the source rectangle.
-    // There is no need to manually flush/invalidate the regions because CopyBlock does that for us.
-    for (u32 line = 0; line < regs.line_count; ++line) {
+    if (read_buffer.size() < line_length) {
+        read_buffer.resize(line_length);
+    }
+    for (u32 line = 0; line < line_count; ++line) {
         const GPUVAddr source_line = regs.offset_in + static_cast<size_t>(line) * regs.pitch_in;
         const GPUVAddr dest_line = regs.offset_out + static_cast<size_t>(line) * regs.pitch_out;
-        memory_manager.CopyBlock(dest_line, source_line, regs.line_length_in);
+        memory_manager.ReadBlockUnsafe(source_line, read_buffer.data(), line_length);
+        memory_manager.WriteBlockUnsafe(dest_line, read_buffer.data(), line_length);
     }
 }
 
@@ -118,21 +203,39 @@ void MaxwellDMA::CopyBlockLinearToPitch() {
     const size_t src_size =
         CalculateSize(true, bytes_per_pixel, width, height, depth, block_height, block_depth);
 
-    if (read_buffer.size() < src_size) {
-        read_buffer.resize(src_size);
+    memory_manager.FlushRegion(regs.offset_in, src_size);
+    memory_manager.FlushRegion(regs.offset_out, dst_size);
+    memory_manager.InvalidateRegion(regs.offset_out, dst_size);
+
+    // Read and write guest memory in place when it is contiguous in host memory.
+    const u8* input = memory_manager.GetPointerRange(regs.offset_in, src_size);
+    if (input == nullptr) {
+        if (read_buffer.size() < src_size) {
+            read_buffer.resize(src_size);
+        }
+        memory_manager.ReadBlockUnsafe(regs.offset_in, read_buffer.data(), src_size);
+        input = read_buffer.data();
     }
-    if (write_buffer.size() < dst_size) {
-        write_buffer.resize(dst_size);
+    u8* output = memory_manager.GetPointerRange(regs.offset_out, dst_size);
+    const bool is_output_direct = output != nullptr && !Overlaps(input, src_size, output, dst_size);
+    if (!is_output_direct) {
+        if (write_buffer.size() < dst_size) {
+            write_buffer.resize(dst_size);
+        }
+        memory_manager.ReadBlockUnsafe(regs.offset_out, write_buffer.data(), dst_size);
+        output = write_buffer.data();
     }
 
-    memory_manager.ReadBlock(regs.offset_in, read_buffer.data(), src_size);
-    memory_manager.ReadBlock(regs.offset_out, write_buffer.data(), dst_size);
-
-    UnswizzleSubrect(regs.line_length_in, regs.line_count, regs.pitch_out, width, bytes_per_pixel,
-                     block_height, src_params.origin.x, src_params.origin.y, write_buffer.data(),
-                     read_buffer.data());
+    // Each line writes its own pitch linear row, so bands of lines can be unswizzled in parallel.
+    ForEachLineBand(regs.line_count, dst_size, [&](u32 first_line, u32 num_lines) {
+        UnswizzleSubrect(regs.line_length_in, num_lines, regs.pitch_out, width, bytes_per_pixel,
+                         block_height, src_params.origin.x, src_params.origin.y + first_line,
+                         output + static_cast<size_t>(first_line) * regs.pitch_out, input);
+    });
 
-    memory_manager.WriteBlock(regs.offset_out, write_buffer.data(), dst_size);
+    if (!is_output_direct) {
+        memory_manager.WriteBlockUnsafe(regs.offset_out, write_buffer.data(), dst_size);
+    }
 }
 
 void MaxwellDMA::CopyPitchToBlockLinear() {
@@ -152,19 +255,29 @@ void MaxwellDMA::CopyPitchToBlockLinear() {
 
     const size_t src_size = static_cast<size_t>(regs.pitch_in) * regs.line_count;
 
-    if (read_buffer.size() < src_size) {
-        read_buffer.resize(src_size);
-    }
-    if (write_buffer.size() < dst_size) {
-        write_buffer.resize(dst_size);
+    if (Settings::IsGPULevelExtreme()) {
+        memory_manager.FlushRegion(regs.offset_in, src_size);
+        memory_manager.FlushRegion(regs.offset_out, dst_size);
     }
+    memory_manager.InvalidateRegion(regs.offset_out, dst_size);
 
-    if (Settings::IsGPULevelExtreme()) {
-        memory_manager.ReadBlock(regs.offset_in, read_buffer.data(), src_size);
-        memory_manager.ReadBlock(regs.offset_out, write_buffer.data(), dst_size);
-    } else {
+    // Read and write guest memory in place when it is contiguous in host memory.
+    const u8* input = memory_manager.GetPointerRange(regs.offset_in, src_size);
+    if (input == nullptr) {
+        if (read_buffer.size() < src_size) {
+            read_buffer.resize(src_size);
+        }
         memory_manager.ReadBlockUnsafe(regs.offset_in, read_buffer.data(), src_size);
+        input = read_buffer.data();
+    }
+    u8* output = memory_manager.GetPointerRange(regs.offset_out, dst_size);
+    const bool is_output_direct = output != nullptr && !Overlaps(input, src_size, output, dst_size);
+    if (!is_output_direct) {
+        if (write_buffer.size() < dst_size) {
+            write_buffer.resize(dst_size);
+        }
         memory_manager.ReadBlockUnsafe(regs.offset_out, write_buffer.data(), dst_size);
+        output = write_buffer.data();
     }
 
     // If the input is linear and the output is tiled, swizzle the input and copy it over.
@@ -172,14 +285,20 @@ void MaxwellDMA::CopyPitchToBlockLinear() {
         ASSERT(dst_params.layer == 0);
         SwizzleSliceToVoxel(regs.line_length_in, regs.line_count, regs.pitch_in, width, height,
                             bytes_per_pixel, block_height, block_depth, dst_params.origin.x,
-                            dst_params.origin.y, write_buffer.data(), read_buffer.data());
+                            dst_params.origin.y, output, input);
     } else {
-        SwizzleSubrect(regs.line_length_in, regs.line_count, regs.pitch_in, width, bytes_per_pixel,
-                       write_buffer.data() + dst_layer_size * dst_params.layer, read_buffer.data(),
-                       block_height, dst_params.origin.x, dst_params.origin.y);
+        // Each line lands in its own tiled row, so bands of lines can be swizzled in parallel.
+        u8* const layer_output = output + dst_layer_size * dst_params.layer;
+        ForEachLineBand(regs.line_count, src_size, [&](u32 first_line, u32 num_lines) {
+            SwizzleSubrect(regs.line_length_in, num_lines, regs.pitch_in, width, bytes_per_pixel,
+                           layer_output, input + static_cast<size_t>(first_line) * regs.pitch_in,
+                           block_height, dst_params.origin.x, dst_params.origin.y + first_line);
+        });
     }
 
-    memory_manager.WriteBlock(regs.offset_out, write_buffer.data(), dst_size);
+    if (!is_output_direct) {
+        memory_manager.WriteBlockUnsafe(regs.offset_out, write_buffer.data(), dst_size);
+    }
 }
 
 void MaxwellDMA::FastCopyBlockLinearToPitch() {
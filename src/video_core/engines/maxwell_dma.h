@@ -6,6 +6,7 @@
 
 #include <array>
 #include <cstddef>
+#include <memory>
 #include <vector>
 #include "common/bit_field.h"
 #include "common/common_funcs.h"
@@ -13,6 +14,10 @@
 #include "video_core/engines/engine_interface.h"
 #include "video_core/gpu.h"
 
+namespace Common {
+class ThreadWorker;
+}
+
 namespace Core {
 class System;
 }
@@ -210,6 +215,11 @@ private:
 
     void FastCopyBlockLinearToPitch();
 
+    /// Calls func(first_line, num_lines) over bands covering [0, line_count). Copies of at least
+    /// num_bytes are split between the calling thread and the copy workers.
+    template <typename Func>
+    void ForEachLineBand(u32 line_count, std::size_t num_bytes, Func&& func);
+
     Core::System& system;
 
     MemoryManager& memory_manager;
@@ -217,6 +227,8 @@ private:
     std::vector<u8> read_buffer;
     std::vector<u8> write_buffer;
 
+    std::unique_ptr<Common::ThreadWorker> copy_workers;
+
     static constexpr std::size_t NUM_REGS = 0x800;
     struct Regs {
         union {
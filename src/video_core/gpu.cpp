@@ -197,6 +197,15 @@ void GPU::FlushCommands() {
 }
 
 void GPU::SyncGuestHost() {
+    // With host write tracking, CPU writes to cached pages are only detected and not invalidated
+    // when they happen, so invalidate them before synchronizing.
+    host_written_pages.clear();
+    if (system.Memory().CollectHostWrites(host_written_pages) != 0) {
+        host_write_faults += host_written_pages.size();
+        for (const VAddr page : host_written_pages) {
+            renderer->Rasterizer().OnCPUWrite(page, Core::Memory::PAGE_SIZE);
+        }
+    }
     renderer->Rasterizer().SyncGuestHost();
 }
 
@@ -499,6 +508,9 @@ void GPU::PushCommandBuffer(Tegra::ChCommandHeaderList& entries) {
 }
 
 void GPU::SwapBuffers(const Tegra::FramebufferConfig* framebuffer) {
+    if (const u64 num_faults = host_write_faults.exchange(0); num_faults != 0) {
+        LOG_TRACE(HW_GPU, "CPU wrote {} cached pages this frame", num_faults);
+    }
     gpu_thread.SwapBuffers(framebuffer);
 }
 
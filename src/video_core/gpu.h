@@ -10,6 +10,7 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <vector>
 #include "common/common_types.h"
 #include "core/hle/service/nvdrv/nvdata.h"
 #include "core/hle/service/nvflinger/buffer_queue.h"
@@ -406,6 +407,11 @@ private:
     u64 last_flush_fence{};
     std::mutex flush_request_mutex;
 
+    /// Cached pages written by the CPU, collected at each guest/host sync
+    std::vector<VAddr> host_written_pages;
+    /// Number of cached pages written by the CPU since the last frame
+    std::atomic<u64> host_write_faults{};
+
     const bool is_async;
 
     VideoCommon::GPUThread::ThreadManager gpu_thread;
@@ -8,6 +8,7 @@
 #include "common/thread.h"
 #include "core/core.h"
 #include "core/frontend/emu_window.h"
+#include "core/host_affinity.h"
 #include "core/settings.h"
 #include "video_core/dma_pusher.h"
 #include "video_core/gpu.h"
@@ -26,6 +27,7 @@ static void RunThread(Core::System& system, VideoCore::RendererBase& renderer,
 
     Common::SetCurrentThreadName(name.c_str());
     Common::SetCurrentThreadPriority(Common::ThreadPriority::High);
+    Core::PinCurrentThread(Core::HostThreadType::GPU);
     system.RegisterHostThread();
 
     // Wait for first GPU command before acquiring the window context
@@ -0,0 +1,118 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <span>
+
+#include "common/common_types.h"
+
+namespace Tegra {
+
+/**
+ * Direct mapped cache of the host memory backing gpu pages. Entries are tagged with a mapping
+ * generation, so changing the generation invalidates the whole cache at once.
+ *
+ * @tparam page_bits   Size in bits of a gpu page.
+ * @tparam num_entries Number of cached pages, must be a power of two.
+ */
+template <u64 page_bits, std::size_t num_entries = 1024>
+class HostPageCache {
+    static_assert((num_entries & (num_entries - 1)) == 0, "num_entries must be a power of two");
+
+public:
+    static constexpr u64 page_size = 1ULL << page_bits;
+    static constexpr u64 page_mask = page_size - 1;
+
+    /**
+     * Returns the host memory backing a gpu page, from the start of the page.
+     *
+     * @param gpu_addr   Page aligned gpu address.
+     * @param generation Current mapping generation.
+     * @param translate  Called on a miss with the gpu address, returns the host memory of the page
+     *                   that is contiguous from its start.
+     */
+    template <typename Translate>
+    [[nodiscard]] std::span<u8> GetPage(u64 gpu_addr, u64 generation, Translate&& translate) {
+        const u64 page = gpu_addr >> page_bits;
+        std::scoped_lock lock{mutex};
+        Entry& entry = entries[page & (num_entries - 1)];
+        if (entry.page == page && entry.generation == generation) {
+            return {entry.host_ptr, entry.host_size};
+        }
+        ++num_misses;
+        const std::span<u8> host_page = translate(gpu_addr);
+        entry = Entry{
+            .page = page,
+            .generation = generation,
+            .host_ptr = host_page.data(),
+            .host_size = host_page.size(),
+        };
+        return host_page;
+    }
+
+    /**
+     * Calls func(offset, host_ptr, size) for each run of a gpu region that is contiguous in host
+     * memory, where offset is relative to gpu_addr. Runs not backed by host memory as a whole are
+     * reported with a null host_ptr and have to be accessed page by page.
+     */
+    template <typename Translate, typename Func>
+    void ForEachHostRange(u64 gpu_addr, std::size_t size, u64 generation, Translate&& translate,
+                          Func&& func) {
+        std::size_t offset{};
+        std::size_t range_offset{};
+        std::size_t range_size{};
+        u8* range_ptr{};
+        while (offset < size) {
+            const u64 addr = gpu_addr + offset;
+            const std::size_t page_offset = static_cast<std::size_t>(addr & page_mask);
+            const std::size_t copy_amount =
+                std::min(static_cast<std::size_t>(page_size) - page_offset, size - offset);
+
+            const std::span<u8> host_page = GetPage(addr - page_offset, generation, translate);
+            u8* const host_ptr =
+                page_offset + copy_amount <= host_page.size() ? host_page.data() + page_offset
+                                                              : nullptr;
+            const bool is_contiguous =
+                host_ptr ? range_ptr && range_ptr + range_size == host_ptr : !range_ptr;
+            if (range_size != 0 && is_contiguous) {
+                range_size += copy_amount;
+            } else {
+                if (range_size != 0) {
+                    func(range_offset, range_ptr, range_size);
+                }
+                range_offset = offset;
+                range_ptr = host_ptr;
+                range_size = copy_amount;
+            }
+            offset += copy_amount;
+        }
+        if (range_size != 0) {
+            func(range_offset, range_ptr, range_size);
+        }
+    }
+
+    /// Returns the number of lookups that had to translate the page
+    [[nodiscard]] u64 NumMisses() const {
+        std::scoped_lock lock{mutex};
+        return num_misses;
+    }
+
+private:
+    struct Entry {
+        u64 page = ~0ULL;
+        u64 generation{};
+        u8* host_ptr{};
+        std::size_t host_size{};
+    };
+
+    mutable std::mutex mutex;
+    std::array<Entry, num_entries> entries{};
+    u64 num_misses{};
+};
+
+} // namespace Tegra
@@ -25,6 +25,7 @@ void MemoryManager::BindRasterizer(VideoCore::RasterizerInterface& rasterizer_)
 }
 
 GPUVAddr MemoryManager::UpdateRange(GPUVAddr gpu_addr, PageEntry page_entry, std::size_t size) {
+    ++map_generation;
     u64 remaining_size{size};
     for (u64 offset{}; offset < size; offset += page_size) {
         if (remaining_size < page_size) {
@@ -238,32 +239,45 @@ const u8* MemoryManager::GetPointer(GPUVAddr gpu_addr) const {
 }
 
 void MemoryManager::ReadBlock(GPUVAddr gpu_src_addr, void* dest_buffer, std::size_t size) const {
-    std::size_t remaining_size{size};
-    std::size_t page_index{gpu_src_addr >> page_bits};
-    std::size_t page_offset{gpu_src_addr & page_mask};
+    // Flush must happen on the rasterizer interface, such that memory is always synchronous
+    // when it is read (even when in asynchronous GPU mode). Fixes Dead Cells title menu.
+    FlushRegion(gpu_src_addr, size);
+    ReadBlockUnsafe(gpu_src_addr, dest_buffer, size);
+}
 
-    while (remaining_size > 0) {
-        const std::size_t copy_amount{
-            std::min(static_cast<std::size_t>(page_size) - page_offset, remaining_size)};
+void MemoryManager::ReadBlockUnsafe(GPUVAddr gpu_src_addr, void* dest_buffer,
+                                    const std::size_t size) const {
+    u8* const dest{static_cast<u8*>(dest_buffer)};
+    ForEachHostRange(gpu_src_addr, size, [&](std::size_t offset, u8* host_ptr, std::size_t range) {
+        if (host_ptr) {
+            std::memcpy(dest + offset, host_ptr, range);
+        } else {
+            ReadPagesUnsafe(gpu_src_addr + offset, dest + offset, range);
+        }
+    });
+}
 
-        if (const auto page_addr{GpuToCpuAddress(page_index << page_bits)}; page_addr) {
-            const auto src_addr{*page_addr + page_offset};
+void MemoryManager::WriteBlock(GPUVAddr gpu_dest_addr, const void* src_buffer, std::size_t size) {
+    // Invalidate must happen on the rasterizer interface, such that memory is always
+    // synchronous when it is written (even when in asynchronous GPU mode).
+    InvalidateRegion(gpu_dest_addr, size);
+    WriteBlockUnsafe(gpu_dest_addr, src_buffer, size);
+}
 
-            // Flush must happen on the rasterizer interface, such that memory is always synchronous
-            // when it is read (even when in asynchronous GPU mode). Fixes Dead Cells title menu.
-            rasterizer->FlushRegion(src_addr, copy_amount);
-            system.Memory().ReadBlockUnsafe(src_addr, dest_buffer, copy_amount);
+void MemoryManager::WriteBlockUnsafe(GPUVAddr gpu_dest_addr, const void* src_buffer,
+                                     std::size_t size) {
+    const u8* const src{static_cast<const u8*>(src_buffer)};
+    ForEachHostRange(gpu_dest_addr, size, [&](std::size_t offset, u8* host_ptr, std::size_t range) {
+        if (host_ptr) {
+            std::memcpy(host_ptr, src + offset, range);
+        } else {
+            WritePagesUnsafe(gpu_dest_addr + offset, src + offset, range);
         }
-
-        page_index++;
-        page_offset = 0;
-        dest_buffer = static_cast<u8*>(dest_buffer) + copy_amount;
-        remaining_size -= copy_amount;
-    }
+    });
 }
 
-void MemoryManager::ReadBlockUnsafe(GPUVAddr gpu_src_addr, void* dest_buffer,
-                                    const std::size_t size) const {
+void MemoryManager::ReadPagesUnsafe(GPUVAddr gpu_src_addr, void* dest_buffer,
+                                    std::size_t size) const {
     std::size_t remaining_size{size};
     std::size_t page_index{gpu_src_addr >> page_bits};
     std::size_t page_offset{gpu_src_addr & page_mask};
@@ -286,32 +300,7 @@ void MemoryManager::ReadBlockUnsafe(GPUVAddr gpu_src_addr, void* dest_buffer,
     }
 }
 
-void MemoryManager::WriteBlock(GPUVAddr gpu_dest_addr, const void* src_buffer, std::size_t size) {
-    std::size_t remaining_size{size};
-    std::size_t page_index{gpu_dest_addr >> page_bits};
-    std::size_t page_offset{gpu_dest_addr & page_mask};
-
-    while (remaining_size > 0) {
-        const std::size_t copy_amount{
-            std::min(static_cast<std::size_t>(page_size) - page_offset, remaining_size)};
-
-        if (const auto page_addr{GpuToCpuAddress(page_index << page_bits)}; page_addr) {
-            const auto dest_addr{*page_addr + page_offset};
-
-            // Invalidate must happen on the rasterizer interface, such that memory is always
-            // synchronous when it is written (even when in asynchronous GPU mode).
-            rasterizer->InvalidateRegion(dest_addr, copy_amount);
-            system.Memory().WriteBlockUnsafe(dest_addr, src_buffer, copy_amount);
-        }
-
-        page_index++;
-        page_offset = 0;
-        src_buffer = static_cast<const u8*>(src_buffer) + copy_amount;
-        remaining_size -= copy_amount;
-    }
-}
-
-void MemoryManager::WriteBlockUnsafe(GPUVAddr gpu_dest_addr, const void* src_buffer,
+void MemoryManager::WritePagesUnsafe(GPUVAddr gpu_dest_addr, const void* src_buffer,
                                      std::size_t size) {
     std::size_t remaining_size{size};
     std::size_t page_index{gpu_dest_addr >> page_bits};
@@ -355,4 +344,91 @@ bool MemoryManager::IsGranularRange(GPUVAddr gpu_addr, std::size_t size) const {
     return page <= Core::Memory::PAGE_SIZE;
 }
 
+u8* MemoryManager::GetWritePointer(GPUVAddr gpu_addr, std::size_t size) {
+    u8* const host_ptr{GetPointerRange(gpu_addr, size)};
+    if (host_ptr) {
+        InvalidateRegion(gpu_addr, size);
+    }
+    return host_ptr;
+}
+
+u8* MemoryManager::GetPointerRange(GPUVAddr gpu_addr, std::size_t size) {
+    u8* host_ptr{};
+    bool is_contiguous{true};
+    ForEachHostRange(gpu_addr, std::max<std::size_t>(size, 1),
+                     [&](std::size_t offset, u8* range_ptr, std::size_t) {
+                         if (offset != 0 || !range_ptr) {
+                             is_contiguous = false;
+                         }
+                         host_ptr = range_ptr;
+                     });
+    return is_contiguous ? host_ptr : nullptr;
+}
+
+std::span<u8> MemoryManager::TranslateHostPage(GPUVAddr gpu_addr) const {
+    const PageEntry page_entry{GetPageEntry(gpu_addr)};
+    if (!page_entry.IsValid()) {
+        return {};
+    }
+    return system.Memory().GetHostSpan(page_entry.ToAddress(), page_size);
+}
+
+template <typename Func>
+void MemoryManager::ForEachHostRange(GPUVAddr gpu_addr, std::size_t size, Func&& func) const {
+    // Translations are tagged with the generation read before doing them, so a page table change
+    // made by another thread while the range is walked only causes misses afterwards
+    const u64 generation{map_generation.load(std::memory_order_acquire) +
+                         system.Memory().GetMappingGeneration()};
+    host_page_cache.ForEachHostRange(
+        gpu_addr, size, generation,
+        [this](GPUVAddr page_addr) { return TranslateHostPage(page_addr); },
+        std::forward<Func>(func));
+}
+
+template <typename Func>
+void MemoryManager::ForEachCpuRange(GPUVAddr gpu_addr, std::size_t size, Func&& func) const {
+    std::size_t remaining_size{size};
+    std::size_t page_index{gpu_addr >> page_bits};
+    std::size_t page_offset{gpu_addr & page_mask};
+
+    VAddr range_addr{};
+    std::size_t range_size{};
+    while (remaining_size > 0) {
+        const std::size_t copy_amount{
+            std::min(static_cast<std::size_t>(page_size) - page_offset, remaining_size)};
+
+        if (const auto page_addr{GpuToCpuAddress(page_index << page_bits)}; page_addr) {
+            const VAddr cpu_addr{*page_addr + page_offset};
+            if (range_size != 0 && range_addr + range_size == cpu_addr) {
+                range_size += copy_amount;
+            } else {
+                if (range_size != 0) {
+                    func(range_addr, range_size);
+                }
+                range_addr = cpu_addr;
+                range_size = copy_amount;
+            }
+        }
+
+        page_index++;
+        page_offset = 0;
+        remaining_size -= copy_amount;
+    }
+    if (range_size != 0) {
+        func(range_addr, range_size);
+    }
+}
+
+void MemoryManager::FlushRegion(GPUVAddr gpu_addr, std::size_t size) const {
+    ForEachCpuRange(gpu_addr, size, [this](VAddr cpu_addr, std::size_t range_size) {
+        rasterizer->FlushRegion(cpu_addr, range_size);
+    });
+}
+
+void MemoryManager::InvalidateRegion(GPUVAddr gpu_addr, std::size_t size) {
+    ForEachCpuRange(gpu_addr, size, [this](VAddr cpu_addr, std::size_t range_size) {
+        rasterizer->InvalidateRegion(cpu_addr, range_size);
+    });
+}
+
 } // namespace Tegra
@@ -4,11 +4,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <optional>
+#include <span>
 #include <vector>
 
 #include "common/common_types.h"
+#include "video_core/host_page_cache.h"
 
 namespace VideoCore {
 class RasterizerInterface;
@@ -114,6 +117,28 @@ public:
      */
     [[nodiscard]] bool IsGranularRange(GPUVAddr gpu_addr, std::size_t size) const;
 
+    /**
+     * GetWritePointer returns a host pointer to write a whole gpu region directly, or nullptr if
+     * the region is not backed by contiguous host memory. The region is invalidated as WriteBlock
+     * would do, so it must be written before any other GPU work reads it.
+     */
+    [[nodiscard]] u8* GetWritePointer(GPUVAddr gpu_addr, std::size_t size);
+
+    /**
+     * GetPointerRange returns a host pointer to a whole gpu region, or nullptr if the region is
+     * not backed by contiguous host memory. Like the unsafe block functions, no flushing or
+     * invalidation is done.
+     */
+    [[nodiscard]] u8* GetPointerRange(GPUVAddr gpu_addr, std::size_t size);
+
+    /**
+     * FlushRegion and InvalidateRegion do the flush of ReadBlock and the invalidation of
+     * WriteBlock once for a whole gpu region, merging contiguous pages into a single rasterizer
+     * call. The region can then be accessed with the unsafe functions or GetPointerRange.
+     */
+    void FlushRegion(GPUVAddr gpu_addr, std::size_t size) const;
+    void InvalidateRegion(GPUVAddr gpu_addr, std::size_t size);
+
     [[nodiscard]] GPUVAddr Map(VAddr cpu_addr, GPUVAddr gpu_addr, std::size_t size);
     [[nodiscard]] GPUVAddr MapAllocate(VAddr cpu_addr, std::size_t size, std::size_t align);
     [[nodiscard]] GPUVAddr MapAllocate32(VAddr cpu_addr, std::size_t size);
@@ -139,6 +164,21 @@ private:
     void TryLockPage(PageEntry page_entry, std::size_t size);
     void TryUnlockPage(PageEntry page_entry, std::size_t size);
 
+    /// Calls func for each run of contiguous CPU addresses backing a gpu region.
+    template <typename Func>
+    void ForEachCpuRange(GPUVAddr gpu_addr, std::size_t size, Func&& func) const;
+
+    /// Calls func(offset, host_ptr, size) for each run of a gpu region contiguous in host memory,
+    /// with a null host_ptr for runs that have to be accessed page by page.
+    template <typename Func>
+    void ForEachHostRange(GPUVAddr gpu_addr, std::size_t size, Func&& func) const;
+
+    /// Returns the host memory backing a gpu page that is contiguous from its start.
+    [[nodiscard]] std::span<u8> TranslateHostPage(GPUVAddr gpu_addr) const;
+
+    void ReadPagesUnsafe(GPUVAddr gpu_src_addr, void* dest_buffer, std::size_t size) const;
+    void WritePagesUnsafe(GPUVAddr gpu_dest_addr, const void* src_buffer, std::size_t size);
+
     [[nodiscard]] static constexpr std::size_t PageEntryIndex(GPUVAddr gpu_addr) {
         return (gpu_addr >> page_bits) & page_table_mask;
     }
@@ -159,6 +199,10 @@ private:
 
     std::vector<PageEntry> page_table;
     std::vector<std::pair<VAddr, std::size_t>> cache_invalidate_queue;
+
+    /// Incremented whenever the page table changes, invalidating host_page_cache.
+    std::atomic<u64> map_generation{};
+    mutable HostPageCache<page_bits> host_page_cache;
 };
 
 } // namespace Tegra
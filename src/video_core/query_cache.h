@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "common/assert.h"
+#include "common/logging/log.h"
 #include "core/core.h"
 #include "core/settings.h"
 #include "video_core/engines/maxwell_3d.h"
@@ -25,6 +26,13 @@
 
 namespace VideoCommon {
 
+struct QueryCacheStatistics {
+    u64 num_ready_flushes = 0;    ///< Queries written to guest memory without waiting
+    u64 num_blocking_flushes = 0; ///< Queries written to guest memory waiting for the host GPU
+    u64 num_stalls_avoided = 0;   ///< Early reads answered with a conservative result
+    u64 num_late_results = 0;     ///< Exact results written after a conservative one
+};
+
 template <class QueryCache, class HostCounter>
 class CounterStreamBase {
 public:
@@ -91,12 +99,12 @@ private:
     std::shared_ptr<HostCounter> last;
 };
 
-template <class QueryCache, class CachedQuery, class CounterStream, class HostCounter>
+template <class QueryCache, class CachedQuery, class CounterStream, class HostCounter,
+          class Rasterizer = VideoCore::RasterizerInterface,
+          class Maxwell3D = Tegra::Engines::Maxwell3D, class GpuMemory = Tegra::MemoryManager>
 class QueryCacheBase {
 public:
-    explicit QueryCacheBase(VideoCore::RasterizerInterface& rasterizer_,
-                            Tegra::Engines::Maxwell3D& maxwell3d_,
-                            Tegra::MemoryManager& gpu_memory_)
+    explicit QueryCacheBase(Rasterizer& rasterizer_, Maxwell3D& maxwell3d_, GpuMemory& gpu_memory_)
         : rasterizer{rasterizer_}, maxwell3d{maxwell3d_},
           gpu_memory{gpu_memory_}, streams{{CounterStream{static_cast<QueryCache&>(*this),
                                                           VideoCore::QueryType::SamplesPassed}}} {}
@@ -108,7 +116,11 @@ public:
 
     void FlushRegion(VAddr addr, std::size_t size) {
         std::unique_lock lock{mutex};
-        FlushAndRemoveRegion(addr, size);
+        if (IsConservative()) {
+            FlushOrDeferRegion(addr, size);
+        } else {
+            FlushAndRemoveRegion(addr, size);
+        }
     }
 
     /**
@@ -184,13 +196,15 @@ public:
     }
 
     bool ShouldWaitAsyncFlushes() const {
-        if (committed_flushes.empty()) {
+        if (committed_flushes.empty() || IsConservative()) {
             return false;
         }
         return committed_flushes.front() != nullptr;
     }
 
     void PopAsyncFlushes() {
+        std::unique_lock lock{mutex};
+        ResolvePendingQueries();
         if (committed_flushes.empty()) {
             return;
         }
@@ -199,18 +213,124 @@ public:
             committed_flushes.pop_front();
             return;
         }
+        const bool is_conservative = IsConservative();
         for (VAddr query_address : *flush_list) {
-            FlushAndRemoveRegion(query_address, 4);
+            if (is_conservative) {
+                FlushOrDeferRegion(query_address, 4);
+            } else {
+                FlushAndRemoveRegion(query_address, 4);
+            }
         }
         committed_flushes.pop_front();
     }
 
+    /// Returns how queries have been written to guest memory so far.
+    QueryCacheStatistics GetStatistics() {
+        std::unique_lock lock{mutex};
+        return statistics;
+    }
+
+    /// Logs how queries have been written to guest memory so far.
+    void LogStatistics() {
+        const QueryCacheStatistics stats = GetStatistics();
+        LOG_INFO(HW_GPU,
+                 "Queries: {} ready flushes, {} blocking flushes, {} stalls avoided, "
+                 "{} late results",
+                 stats.num_ready_flushes, stats.num_blocking_flushes, stats.num_stalls_avoided,
+                 stats.num_late_results);
+    }
+
 private:
+    /// Returns true when guest reads of pending queries should not wait for the host GPU.
+    static bool IsConservative() {
+        return Settings::values.query_resolution.GetValue() ==
+               Settings::QueryResolution::Conservative;
+    }
+
+    /// Writes a query to guest memory, waiting for its result when it's not available yet.
+    void FlushQuery(CachedQuery& query) {
+        if (query.TryFlush()) {
+            ++statistics.num_ready_flushes;
+        } else {
+            ++statistics.num_blocking_flushes;
+            query.Flush();
+        }
+        RecordResult(query);
+    }
+
+    /// Remembers the last exact result of a query address to answer early reads of it.
+    void RecordResult(const CachedQuery& query) {
+        // Queries are usually recorded at the same addresses each frame, this only grows when a
+        // game keeps moving them around
+        constexpr std::size_t max_last_results = 0x10000;
+        if (last_results.size() >= max_last_results) {
+            last_results.clear();
+        }
+        last_results.insert_or_assign(query.GetCpuAddr(), query.GetWrittenValue());
+        pending_queries.erase(query.GetCpuAddr());
+    }
+
+    /**
+     * Writes the queries of a memory range to guest memory without waiting for the host GPU.
+     * Queries with an available result are removed from the cache, the rest are written with a
+     * conservative result and stay cached until ResolvePendingQueries writes their exact result.
+     */
+    void FlushOrDeferRegion(VAddr addr, std::size_t size) {
+        ForEachQueryInRegion(addr, size, [this](CachedQuery& query) {
+            if (TryFlushAndRemove(query)) {
+                return true;
+            }
+            // Report the query as visible when its result is unknown, hiding geometry that
+            // should be drawn is worse than drawing geometry that is occluded
+            const auto it = last_results.find(query.GetCpuAddr());
+            query.FlushConservative(std::max<u64>(it != last_results.end() ? it->second : 0, 1));
+            ++statistics.num_stalls_avoided;
+            pending_queries.insert(query.GetCpuAddr());
+            return false;
+        });
+    }
+
+    /// Writes the exact result of the queries that were answered conservatively, when available.
+    void ResolvePendingQueries() {
+        const std::vector<VAddr> addresses(pending_queries.begin(), pending_queries.end());
+        for (const VAddr address : addresses) {
+            if (!TryGet(address)) {
+                pending_queries.erase(address);
+                continue;
+            }
+            ForEachQueryInRegion(address, 4,
+                                 [this](CachedQuery& query) { return TryFlushAndRemove(query); });
+        }
+    }
+
+    /// Flushes a query if its result is available without waiting. Returns true when flushed.
+    bool TryFlushAndRemove(CachedQuery& query) {
+        const bool was_pending = pending_queries.contains(query.GetCpuAddr());
+        if (!query.TryFlush()) {
+            return false;
+        }
+        ++statistics.num_ready_flushes;
+        statistics.num_late_results += was_pending ? 1 : 0;
+        RecordResult(query);
+        rasterizer.UpdatePagesCachedCount(query.GetCpuAddr(), query.SizeInBytes(), -1);
+        return true;
+    }
+
     /// Flushes a memory range to guest memory and removes it from the cache.
     void FlushAndRemoveRegion(VAddr addr, std::size_t size) {
+        ForEachQueryInRegion(addr, size, [this](CachedQuery& query) {
+            rasterizer.UpdatePagesCachedCount(query.GetCpuAddr(), query.SizeInBytes(), -1);
+            FlushQuery(query);
+            return true;
+        });
+    }
+
+    /// Calls func for each query overlapping a memory range, removing it when func returns true.
+    template <typename Func>
+    void ForEachQueryInRegion(VAddr addr, std::size_t size, Func&& func) {
         const u64 addr_begin = static_cast<u64>(addr);
         const u64 addr_end = addr_begin + static_cast<u64>(size);
-        const auto in_range = [addr_begin, addr_end](CachedQuery& query) {
+        const auto in_range = [addr_begin, addr_end](const CachedQuery& query) {
             const u64 cache_begin = query.GetCpuAddr();
             const u64 cache_end = cache_begin + query.SizeInBytes();
             return cache_begin < addr_end && addr_begin < cache_end;
@@ -223,15 +343,17 @@ private:
                 continue;
             }
             auto& contents = it->second;
-            for (auto& query : contents) {
-                if (!in_range(query)) {
+            std::size_t num_kept = 0;
+            for (std::size_t index = 0; index < contents.size(); ++index) {
+                if (in_range(contents[index]) && func(contents[index])) {
                     continue;
                 }
-                rasterizer.UpdatePagesCachedCount(query.GetCpuAddr(), query.SizeInBytes(), -1);
-                query.Flush();
+                if (num_kept != index) {
+                    contents[num_kept] = std::move(contents[index]);
+                }
+                ++num_kept;
             }
-            contents.erase(std::remove_if(std::begin(contents), std::end(contents), in_range),
-                           std::end(contents));
+            contents.erase(std::begin(contents) + num_kept, std::end(contents));
         }
     }
 
@@ -266,9 +388,9 @@ private:
     static constexpr std::uintptr_t PAGE_SIZE = 4096;
     static constexpr unsigned PAGE_BITS = 12;
 
-    VideoCore::RasterizerInterface& rasterizer;
-    Tegra::Engines::Maxwell3D& maxwell3d;
-    Tegra::MemoryManager& gpu_memory;
+    Rasterizer& rasterizer;
+    Maxwell3D& maxwell3d;
+    GpuMemory& gpu_memory;
 
     std::recursive_mutex mutex;
 
@@ -278,6 +400,10 @@ private:
 
     std::shared_ptr<std::unordered_set<VAddr>> uncommitted_flushes{};
     std::list<std::shared_ptr<std::unordered_set<VAddr>>> committed_flushes;
+
+    std::unordered_set<VAddr> pending_queries; ///< Queries holding a conservative result.
+    std::unordered_map<VAddr, u64> last_results;
+    QueryCacheStatistics statistics;
 };
 
 template <class QueryCache, class HostCounter>
@@ -311,6 +437,27 @@ public:
         return *result;
     }
 
+    /// Returns the current value of the query if it's available without waiting.
+    std::optional<u64> TryQuery() {
+        if (result) {
+            return result;
+        }
+        std::optional<u64> dependency_value;
+        if (dependency) {
+            dependency_value = dependency->TryQuery();
+            if (!dependency_value) {
+                return std::nullopt;
+            }
+        }
+        const std::optional<u64> value = NonBlockingQuery();
+        if (!value) {
+            return std::nullopt;
+        }
+        result = *value + base_result + dependency_value.value_or(0);
+        dependency = nullptr;
+        return result;
+    }
+
     /// Returns true when flushing this query will potentially wait.
     bool WaitPending() const noexcept {
         return result.has_value();
@@ -324,6 +471,9 @@ protected:
     /// Returns the value of query from the backend API blocking as needed.
     virtual u64 BlockingQuery() const = 0;
 
+    /// Returns the value of query from the backend API if it's available without blocking.
+    virtual std::optional<u64> NonBlockingQuery() const = 0;
+
 private:
     std::shared_ptr<HostCounter> dependency; ///< Counter to add to this value.
     std::optional<u64> result;               ///< Filled with the already returned value.
@@ -348,12 +498,30 @@ public:
     virtual void Flush() {
         // When counter is nullptr it means that it's just been reseted. We are supposed to write a
         // zero in these cases.
-        const u64 value = counter ? counter->Query() : 0;
-        std::memcpy(host_ptr, &value, sizeof(u64));
+        Write(counter ? counter->Query() : 0);
+    }
 
-        if (timestamp) {
-            std::memcpy(host_ptr + TIMESTAMP_OFFSET, &*timestamp, sizeof(u64));
+    /**
+     * Flushes the query to guest memory if its result is available without waiting.
+     * @returns True when the query has been flushed.
+     */
+    bool TryFlush() {
+        const std::optional<u64> value = counter ? counter->TryQuery() : 0;
+        if (!value) {
+            return false;
         }
+        Write(*value);
+        return true;
+    }
+
+    /// Writes a result that may not be exact to guest memory, the query has to be flushed later.
+    void FlushConservative(u64 value) {
+        Write(value);
+    }
+
+    /// Returns the last value written to guest memory.
+    u64 GetWrittenValue() const noexcept {
+        return written_value;
     }
 
     /// Binds a counter to this query.
@@ -386,6 +554,15 @@ protected:
     }
 
 private:
+    void Write(u64 value) {
+        written_value = value;
+        std::memcpy(host_ptr, &value, sizeof(u64));
+
+        if (timestamp) {
+            std::memcpy(host_ptr + TIMESTAMP_OFFSET, &*timestamp, sizeof(u64));
+        }
+    }
+
     static constexpr std::size_t SMALL_QUERY_SIZE = 8;   // Query size without timestamp.
     static constexpr std::size_t LARGE_QUERY_SIZE = 16;  // Query size with timestamp.
     static constexpr std::intptr_t TIMESTAMP_OFFSET = 8; // Timestamp offset in a large query.
@@ -394,6 +571,7 @@ private:
     u8* host_ptr;                         ///< Writable host pointer.
     std::shared_ptr<HostCounter> counter; ///< Host counter to query, owns the dependency tree.
     std::optional<u64> timestamp;         ///< Timestamp to flush to guest memory.
+    u64 written_value = 0;                ///< Last value written to guest memory.
 };
 
 } // namespace VideoCommon
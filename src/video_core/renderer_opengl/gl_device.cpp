@@ -247,6 +247,9 @@ Device::Device()
 
     use_asynchronous_shaders = Settings::values.use_asynchronous_shaders.GetValue();
 
+    // BPTC is core since OpenGL 4.2
+    use_bc7_for_astc = !has_astc && Settings::values.transcode_astc_to_bc7;
+
     LOG_INFO(Render_OpenGL, "Renderer_VariableAOFFI: {}", has_variable_aoffi);
     LOG_INFO(Render_OpenGL, "Renderer_ComponentIndexingBug: {}", has_component_indexing_bug);
     LOG_INFO(Render_OpenGL, "Renderer_PreciseBug: {}", has_precise_bug);
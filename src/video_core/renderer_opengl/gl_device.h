@@ -120,6 +120,11 @@ public:
         return use_asynchronous_shaders;
     }
 
+    /// Returns true when ASTC textures are transcoded to BC7 instead of decoded to RGBA8
+    bool UseBC7ForASTC() const {
+        return use_bc7_for_astc;
+    }
+
 private:
     static bool TestVariableAoffi();
     static bool TestPreciseBug();
@@ -147,6 +152,7 @@ private:
     bool has_debugging_tool_attached{};
     bool use_assembly_shaders{};
     bool use_asynchronous_shaders{};
+    bool use_bc7_for_astc{};
 };
 
 } // namespace OpenGL
@@ -6,6 +6,7 @@
 
 #include <array>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "common/common_types.h"
@@ -54,6 +55,7 @@ public:
 
 private:
     u64 BlockingQuery() const override;
+    std::optional<u64> NonBlockingQuery() const override;
 
     QueryCache& cache;
     const VideoCore::QueryType type;
@@ -228,6 +228,7 @@ RasterizerOpenGL::RasterizerOpenGL(Core::Frontend::EmuWindow& emu_window_, Tegra
 }
 
 RasterizerOpenGL::~RasterizerOpenGL() {
+    query_cache.LogStatistics();
     if (device.UseAssemblyShaders()) {
         glDeleteBuffers(static_cast<GLsizei>(staging_cbufs.size()), staging_cbufs.data());
     }
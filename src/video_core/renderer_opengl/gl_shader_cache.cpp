@@ -325,7 +325,13 @@ ShaderCacheOpenGL::ShaderCacheOpenGL(RasterizerOpenGL& rasterizer_,
     : ShaderCache{rasterizer_}, emu_window{emu_window_}, gpu{gpu_}, gpu_memory{gpu_memory_},
       maxwell3d{maxwell3d_}, kepler_compute{kepler_compute_}, device{device_} {}
 
-ShaderCacheOpenGL::~ShaderCacheOpenGL() = default;
+ShaderCacheOpenGL::~ShaderCacheOpenGL() {
+    const u64 first_uses = precompiled_uses + runtime_builds;
+    if (first_uses != 0) {
+        LOG_INFO(Render_OpenGL, "{} of {} shader first uses were served by precompiled variants",
+                 precompiled_uses, first_uses);
+    }
+}
 
 void ShaderCacheOpenGL::LoadDiskCache(u64 title_id, const std::atomic_bool& stop_loading,
                                       const VideoCore::DiskResourceLoadCallback& callback) {
@@ -357,7 +363,7 @@ void ShaderCacheOpenGL::LoadDiskCache(u64 title_id, const std::atomic_bool& stop
 
     const auto find_precompiled = [&gl_cache](u64 id) {
         return std::find_if(gl_cache.begin(), gl_cache.end(),
-                            [id](const auto& entry) { return entry.unique_identifier == id; });
+                            [id](const auto& entry) { return entry.variant_identifier == id; });
     };
 
     const auto worker = [&](Core::Frontend::GraphicsContext* context, std::size_t begin,
@@ -370,7 +376,8 @@ void ShaderCacheOpenGL::LoadDiskCache(u64 title_id, const std::atomic_bool& stop
             }
             const auto& entry = (*transferable)[i];
             const u64 uid = entry.unique_identifier;
-            const auto it = find_precompiled(uid);
+            const u64 variant = entry.VariantIdentifier();
+            const auto it = find_precompiled(variant);
             const auto precompiled_entry = it != gl_cache.end() ? &*it : nullptr;
 
             const bool is_compute = entry.type == ShaderType::Compute;
@@ -392,6 +399,7 @@ void ShaderCacheOpenGL::LoadDiskCache(u64 title_id, const std::atomic_bool& stop
             }
 
             PrecompiledShader shader;
+            shader.variant_identifier = variant;
             shader.program = std::move(program);
             shader.registry = std::move(registry);
             shader.entries = MakeEntries(device, ir, entry.type);
@@ -401,7 +409,14 @@ void ShaderCacheOpenGL::LoadDiskCache(u64 title_id, const std::atomic_bool& stop
                 callback(VideoCore::LoadCallbackStage::Build, ++built_shaders,
                          transferable->size());
             }
-            runtime_cache.emplace(entry.unique_identifier, std::move(shader));
+            auto& variants = runtime_cache[uid];
+            const bool is_duplicate =
+                std::any_of(variants.begin(), variants.end(), [variant](const auto& stored) {
+                    return stored.variant_identifier == variant;
+                });
+            if (!is_duplicate) {
+                variants.push_back(std::move(shader));
+            }
         }
     };
 
@@ -440,13 +455,13 @@ void ShaderCacheOpenGL::LoadDiskCache(u64 title_id, const std::atomic_bool& stop
     // TODO(Rodrigo): Do state tracking for transferable shaders and do a dummy draw
     // before precompiling them
 
-    for (std::size_t i = 0; i < transferable->size(); ++i) {
-        const u64 id = (*transferable)[i].unique_identifier;
-        const auto it = find_precompiled(id);
-        if (it == gl_cache.end()) {
-            const GLuint program = runtime_cache.at(id).program->source_program.handle;
-            disk_cache.SavePrecompiled(id, program);
-            precompiled_cache_altered = true;
+    for (const auto& [uid, variants] : runtime_cache) {
+        for (const PrecompiledShader& shader : variants) {
+            const u64 id = shader.variant_identifier;
+            if (find_precompiled(id) == gl_cache.end()) {
+                disk_cache.SavePrecompiled(id, shader.program->source_program.handle);
+                precompiled_cache_altered = true;
+            }
         }
     }
 
@@ -480,6 +495,27 @@ ProgramSharedPtr ShaderCacheOpenGL::GeneratePrecompiledProgram(
     return program;
 }
 
+const PrecompiledShader* ShaderCacheOpenGL::FindPrecompiledVariant(
+    u64 unique_identifier, const Tegra::Engines::ConstBufferEngineInterface& engine) {
+    const auto found = runtime_cache.find(unique_identifier);
+    if (found == runtime_cache.end()) {
+        ++runtime_builds;
+        return nullptr;
+    }
+    const auto& variants = found->second;
+    const auto it = std::find_if(variants.begin(), variants.end(), [&engine](const auto& shader) {
+        return shader.registry->IsConsistentWith(engine);
+    });
+    if (it == variants.end()) {
+        LOG_DEBUG(Render_OpenGL, "No precompiled variant of shader {:016X} out of {} matches",
+                  unique_identifier, variants.size());
+        ++runtime_builds;
+        return nullptr;
+    }
+    ++precompiled_uses;
+    return &*it;
+}
+
 Shader* ShaderCacheOpenGL::GetStageProgram(Maxwell::ShaderProgram program,
                                            VideoCommon::Shader::AsyncShaders& async_shaders) {
     if (!maxwell3d.dirty.flags[Dirty::Shaders]) {
@@ -547,12 +583,11 @@ Shader* ShaderCacheOpenGL::GetStageProgram(Maxwell::ShaderProgram program,
                                   *cpu_addr, host_ptr,  unique_identifier};
 
     std::unique_ptr<Shader> shader;
-    const auto found = runtime_cache.find(unique_identifier);
-    if (found == runtime_cache.end()) {
+    if (const auto* const precompiled = FindPrecompiledVariant(unique_identifier, maxwell3d)) {
+        shader = Shader::CreateFromCache(params, *precompiled);
+    } else {
         shader = Shader::CreateStageFromMemory(params, program, std::move(code), std::move(code_b),
                                                async_shaders, cpu_addr.value_or(0));
-    } else {
-        shader = Shader::CreateFromCache(params, found->second);
     }
 
     Shader* const result = shader.get();
@@ -582,11 +617,10 @@ Shader* ShaderCacheOpenGL::GetComputeKernel(GPUVAddr code_addr) {
                                   *cpu_addr, host_ptr,       unique_identifier};
 
     std::unique_ptr<Shader> kernel;
-    const auto found = runtime_cache.find(unique_identifier);
-    if (found == runtime_cache.end()) {
-        kernel = Shader::CreateKernelFromMemory(params, std::move(code));
+    if (const auto* const precompiled = FindPrecompiledVariant(unique_identifier, kepler_compute)) {
+        kernel = Shader::CreateFromCache(params, *precompiled);
     } else {
-        kernel = Shader::CreateFromCache(params, found->second);
+        kernel = Shader::CreateKernelFromMemory(params, std::move(code));
     }
 
     Shader* const result = kernel.get();
@@ -51,6 +51,7 @@ struct ProgramHandle {
 using ProgramSharedPtr = std::shared_ptr<ProgramHandle>;
 
 struct PrecompiledShader {
+    u64 variant_identifier = 0;
     ProgramSharedPtr program;
     std::shared_ptr<VideoCommon::Shader::Registry> registry;
     ShaderEntries entries;
@@ -142,6 +143,10 @@ private:
         const ShaderDiskCacheEntry& entry, const ShaderDiskCachePrecompiled& precompiled_entry,
         const std::unordered_set<GLenum>& supported_formats);
 
+    /// Finds a precompiled variant of the shader whose registry keys match the engine's state
+    const PrecompiledShader* FindPrecompiledVariant(
+        u64 unique_identifier, const Tegra::Engines::ConstBufferEngineInterface& engine);
+
     Core::Frontend::EmuWindow& emu_window;
     Tegra::GPU& gpu;
     Tegra::MemoryManager& gpu_memory;
@@ -150,7 +155,13 @@ private:
     const Device& device;
 
     ShaderDiskCacheOpenGL disk_cache;
-    std::unordered_map<u64, PrecompiledShader> runtime_cache;
+    /// Precompiled shaders, each unique identifier can have variants with different registry keys
+    std::unordered_map<u64, std::vector<PrecompiledShader>> runtime_cache;
+
+    /// Number of shader first uses that were served by a precompiled variant
+    u64 precompiled_uses = 0;
+    /// Number of shader first uses that had to be compiled on demand
+    u64 runtime_builds = 0;
 
     std::unique_ptr<Shader> null_shader;
     std::unique_ptr<Shader> null_kernel;
@@ -2,7 +2,10 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <iterator>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -55,6 +58,13 @@ constexpr std::array FLOAT_TYPES{"float", "vec2", "vec3", "vec4"};
 constexpr std::string_view INPUT_ATTRIBUTE_NAME = "in_attr";
 constexpr std::string_view OUTPUT_ATTRIBUTE_NAME = "out_attr";
 
+constexpr std::size_t NUM_GENERIC_ATTRIBUTES = 32;
+constexpr std::size_t NUM_PREDICATE_NAMES = 16;
+
+// Source size estimates used to reserve the shader writer up front
+constexpr std::size_t DECLARATIONS_SIZE_HINT = 16 * 1024;
+constexpr std::size_t NODE_SIZE_HINT = 96;
+
 struct TextureOffset {};
 struct TextureDerivates {};
 using TextureArgument = std::pair<Type, Node>;
@@ -84,28 +94,32 @@ layout (std140, binding = {}) uniform vs_config {{
 
 class ShaderWriter final {
 public:
-    void AddExpression(std::string_view text) {
-        DEBUG_ASSERT(scope >= 0);
-        if (!text.empty()) {
-            AppendIndentation();
-        }
-        shader_source += text;
+    explicit ShaderWriter(std::size_t size_hint) {
+        shader_source.reserve(size_hint);
     }
 
-    // Forwards all arguments directly to libfmt.
+    // Forwards all arguments directly to libfmt, formatting in place at the end of the source.
     // Note that all formatting requirements for fmt must be
     // obeyed when using this function. (e.g. {{ must be used
     // printing the character '{' is desirable. Ditto for }} and '}',
     // etc).
     template <typename... Args>
     void AddLine(std::string_view text, Args&&... args) {
-        AddExpression(fmt::format(text, std::forward<Args>(args)...));
+        DEBUG_ASSERT(scope >= 0);
+        const std::size_t line_start = shader_source.size();
+        AppendIndentation();
+        const std::size_t text_start = shader_source.size();
+        fmt::format_to(std::back_inserter(shader_source), text, std::forward<Args>(args)...);
+        if (shader_source.size() == text_start) {
+            // Empty lines are not indented
+            shader_source.resize(line_start);
+        }
         AddNewLine();
     }
 
     void AddNewLine() {
         DEBUG_ASSERT(scope >= 0);
-        shader_source += '\n';
+        shader_source.push_back('\n');
     }
 
     std::string GenerateTemporary() {
@@ -113,17 +127,24 @@ public:
     }
 
     std::string GetResult() {
-        return std::move(shader_source);
+        return fmt::to_string(shader_source);
+    }
+
+    std::size_t Size() const {
+        return shader_source.size();
     }
 
     s32 scope = 0;
 
 private:
     void AppendIndentation() {
-        shader_source.append(static_cast<std::size_t>(scope) * 4, ' ');
+        const std::size_t indentation = static_cast<std::size_t>(scope) * 4;
+        const std::size_t size = shader_source.size();
+        shader_source.resize(size + indentation);
+        std::fill_n(shader_source.data() + size, indentation, ' ');
     }
 
-    std::string shader_source;
+    fmt::memory_buffer shader_source;
     u32 temporary_index = 1;
 };
 
@@ -420,8 +441,8 @@ public:
                             ShaderType stage_, std::string_view identifier_,
                             std::string_view suffix_)
         : device{device_}, ir{ir_}, registry{registry_}, stage{stage_}, identifier{identifier_},
-          suffix{suffix_}, header{ir.GetHeader()}, use_unified_uniforms{
-                                                       UseUnifiedUniforms(device_, ir_, stage_)} {
+          suffix{suffix_}, header{ir.GetHeader()},
+          use_unified_uniforms{UseUnifiedUniforms(device_, ir_, stage_)}, code{EstimateSize(ir_)} {
         if (stage != ShaderType::Compute) {
             transform_feedback = BuildTransformFeedback(registry.GetGraphicsInfo());
         }
@@ -467,6 +488,10 @@ public:
         return code.GetResult();
     }
 
+    std::size_t GetResultSize() const {
+        return code.Size();
+    }
+
 private:
     friend class ASTDecompiler;
     friend class ExprDecompiler;
@@ -2686,20 +2711,21 @@ private:
     };
     static_assert(operation_decompilers.size() == static_cast<std::size_t>(OperationCode::Amount));
 
-    std::string GetRegister(u32 index) const {
-        return AppendSuffix(index, "gpr");
+    const std::string& GetRegister(u32 index) const {
+        return InternName(register_names, index, "gpr");
     }
 
     std::string GetCustomVariable(u32 index) const {
         return AppendSuffix(index, "custom_var");
     }
 
-    std::string GetPredicate(Tegra::Shader::Pred pred) const {
-        return AppendSuffix(static_cast<u32>(pred), "pred");
+    const std::string& GetPredicate(Tegra::Shader::Pred pred) const {
+        return InternName(predicate_names, static_cast<u32>(pred), "pred");
     }
 
-    std::string GetGenericInputAttribute(Attribute::Index attribute) const {
-        return AppendSuffix(GetGenericAttributeIndex(attribute), INPUT_ATTRIBUTE_NAME);
+    const std::string& GetGenericInputAttribute(Attribute::Index attribute) const {
+        return InternName(input_attribute_names, GetGenericAttributeIndex(attribute),
+                          INPUT_ATTRIBUTE_NAME);
     }
 
     std::unordered_map<u8, GenericVaryingDescription> varying_description;
@@ -2759,6 +2785,26 @@ private:
         return AppendSuffix(image.index, "image");
     }
 
+    /// Formats a frequently used name once and returns the cached string afterwards.
+    template <std::size_t N>
+    const std::string& InternName(std::array<std::string, N>& names, u32 index,
+                                  std::string_view name) const {
+        ASSERT(index < N);
+        std::string& interned = names[index];
+        if (interned.empty()) {
+            interned = AppendSuffix(index, name);
+        }
+        return interned;
+    }
+
+    static std::size_t EstimateSize(const ShaderIR& ir) {
+        std::size_t num_nodes = 0;
+        for (const auto& [address, block] : ir.GetBasicBlocks()) {
+            num_nodes += block.size();
+        }
+        return DECLARATIONS_SIZE_HINT + num_nodes * NODE_SIZE_HINT;
+    }
+
     std::string AppendSuffix(u32 index, std::string_view name) const {
         if (suffix.empty()) {
             return fmt::format("{}{}", name, index);
@@ -2792,6 +2838,10 @@ private:
     ShaderWriter code;
 
     std::optional<u32> max_input_vertices;
+
+    mutable std::array<std::string, Register::NumRegisters> register_names;
+    mutable std::array<std::string, NUM_PREDICATE_NAMES> predicate_names;
+    mutable std::array<std::string, NUM_GENERIC_ATTRIBUTES> input_attribute_names;
 };
 
 std::string GetFlowVariable(u32 index) {
@@ -3010,8 +3060,14 @@ ShaderEntries MakeEntries(const Device& device, const ShaderIR& ir, ShaderType s
 std::string DecompileShader(const Device& device, const ShaderIR& ir, const Registry& registry,
                             ShaderType stage, std::string_view identifier,
                             std::string_view suffix) {
+    const auto start_time = std::chrono::steady_clock::now();
     GLSLDecompiler decompiler(device, ir, registry, stage, identifier, suffix);
     decompiler.Decompile();
+    LOG_TRACE(Render_OpenGL, "Emitted {} ({} bytes) in {} us", identifier,
+              decompiler.GetResultSize(),
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::steady_clock::now() - start_time)
+                  .count());
     return decompiler.GetResult();
 }
 
@@ -60,10 +60,17 @@ struct BindlessSamplerEntry {
 
 constexpr u32 NativeVersion = 21;
 
+/// Version of the precompiled cache, stored at the end of its version hash. Bumped when the
+/// identifiers of precompiled programs change, 1 keys them by registry variant.
+constexpr u32 PrecompiledVersion = 1;
+
 ShaderCacheVersionHash GetShaderCacheVersionHash() {
     ShaderCacheVersionHash hash{};
-    const std::size_t length = std::min(std::strlen(Common::g_shader_cache_version), hash.size());
+    const std::size_t length = std::min(std::strlen(Common::g_shader_cache_version),
+                                        hash.size() - sizeof(PrecompiledVersion));
     std::memcpy(hash.data(), Common::g_shader_cache_version, length);
+    std::memcpy(hash.data() + hash.size() - sizeof(PrecompiledVersion), &PrecompiledVersion,
+                sizeof(PrecompiledVersion));
     return hash;
 }
 
@@ -306,7 +313,7 @@ std::optional<std::vector<ShaderDiskCachePrecompiled>> ShaderDiskCacheOpenGL::Lo
     while (precompiled_cache_virtual_file_offset < precompiled_cache_virtual_file.GetSize()) {
         u32 binary_size;
         auto& entry = entries.emplace_back();
-        if (!LoadObjectFromPrecompiled(entry.unique_identifier) ||
+        if (!LoadObjectFromPrecompiled(entry.variant_identifier) ||
             !LoadObjectFromPrecompiled(entry.binary_format) ||
             !LoadObjectFromPrecompiled(binary_size)) {
             return std::nullopt;
@@ -342,7 +349,7 @@ void ShaderDiskCacheOpenGL::SaveEntry(const ShaderDiskCacheEntry& entry) {
         return;
     }
 
-    const u64 id = entry.unique_identifier;
+    const u64 id = entry.VariantIdentifier();
     if (stored_transferable.contains(id)) {
         // The shader already exists
         return;
@@ -362,7 +369,7 @@ void ShaderDiskCacheOpenGL::SaveEntry(const ShaderDiskCacheEntry& entry) {
     stored_transferable.insert(id);
 }
 
-void ShaderDiskCacheOpenGL::SavePrecompiled(u64 unique_identifier, GLuint program) {
+void ShaderDiskCacheOpenGL::SavePrecompiled(u64 variant_identifier, GLuint program) {
     if (!is_usable) {
         return;
     }
@@ -381,11 +388,11 @@ void ShaderDiskCacheOpenGL::SavePrecompiled(u64 unique_identifier, GLuint progra
     std::vector<u8> binary(binary_length);
     glGetProgramBinary(program, binary_length, nullptr, &binary_format, binary.data());
 
-    if (!SaveObjectToPrecompiled(unique_identifier) || !SaveObjectToPrecompiled(binary_format) ||
+    if (!SaveObjectToPrecompiled(variant_identifier) || !SaveObjectToPrecompiled(binary_format) ||
         !SaveObjectToPrecompiled(static_cast<u32>(binary.size())) ||
         !SaveArrayToPrecompiled(binary.data(), binary.size())) {
         LOG_ERROR(Render_OpenGL, "Failed to save binary program file in shader={:016X}, removing",
-                  unique_identifier);
+                  variant_identifier);
         InvalidatePrecompiled();
     }
 }
@@ -42,6 +42,12 @@ struct ShaderDiskCacheEntry {
         return !code.empty() && !code_b.empty();
     }
 
+    /// Identifies the shader together with the registry keys it was compiled with.
+    u64 VariantIdentifier() const {
+        return unique_identifier ^
+               VideoCommon::Shader::HashKeys(keys, bound_samplers, bindless_samplers);
+    }
+
     Tegra::Engines::ShaderType type{};
     ProgramCode code;
     ProgramCode code_b;
@@ -59,7 +65,7 @@ struct ShaderDiskCacheEntry {
 
 /// Contains an OpenGL dumped binary program
 struct ShaderDiskCachePrecompiled {
-    u64 unique_identifier = 0;
+    u64 variant_identifier = 0;
     GLenum binary_format = 0;
     std::vector<u8> binary;
 };
@@ -84,11 +90,12 @@ public:
     /// Removes the precompiled cache file and clears virtual precompiled cache file.
     void InvalidatePrecompiled();
 
-    /// Saves a raw dump to the transferable file. Checks for collisions.
+    /// Saves a raw dump to the transferable file. Checks for collisions. Entries of the same shader
+    /// with different registry keys are stored as separate variants.
     void SaveEntry(const ShaderDiskCacheEntry& entry);
 
     /// Saves a dump entry to the precompiled file. Does not check for collisions.
-    void SavePrecompiled(u64 unique_identifier, GLuint program);
+    void SavePrecompiled(u64 variant_identifier, GLuint program);
 
     /// Serializes virtual precompiled shader cache file to real file
     void SaveVirtualPrecompiledFile();
@@ -162,7 +169,7 @@ private:
     // Stores the current offset of the precompiled cache file for IO purposes
     std::size_t precompiled_cache_virtual_file_offset = 0;
 
-    // Stored transferable shaders
+    // Stored transferable shader variants
     std::unordered_set<u64> stored_transferable;
 
     /// Title ID to operate on
@@ -31,6 +31,7 @@ using Tegra::Texture::TextureType;
 using Tegra::Texture::TICEntry;
 using Tegra::Texture::TSCEntry;
 using VideoCommon::CalculateLevelStrideAlignment;
+using VideoCommon::CalculateTranscodedSizeBytes;
 using VideoCommon::ImageCopy;
 using VideoCommon::ImageFlagBits;
 using VideoCommon::ImageType;
@@ -654,6 +655,15 @@ Image::Image(TextureCacheRuntime& runtime, const VideoCommon::ImageInfo& info_,
         gl_internal_format = IsPixelFormatSRGB(info.format) ? GL_SRGB8_ALPHA8 : GL_RGBA8;
         gl_format = GL_RGBA;
         gl_type = GL_UNSIGNED_INT_8_8_8_8_REV;
+        if (IsPixelFormatASTC(info.format) && runtime.device.UseBC7ForASTC()) {
+            flags |= ImageFlagBits::Transcoded;
+            converted_size_bytes = CalculateTranscodedSizeBytes(info);
+            gl_internal_format = IsPixelFormatSRGB(info.format)
+                                     ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM
+                                     : GL_COMPRESSED_RGBA_BPTC_UNORM;
+            gl_format = GL_NONE;
+            gl_type = GL_NONE;
+        }
     } else {
         const auto& tuple = GetFormatTuple(info.format);
         gl_internal_format = tuple.internal_format;
@@ -867,7 +877,10 @@ ImageView::ImageView(TextureCacheRuntime& runtime, const VideoCommon::ImageViewI
                      ImageId image_id_, Image& image)
     : VideoCommon::ImageViewBase{info, image.info, image_id_}, views{runtime.null_image_views} {
     const Device& device = runtime.device;
-    if (True(image.flags & ImageFlagBits::Converted)) {
+    if (True(image.flags & ImageFlagBits::Transcoded)) {
+        internal_format = IsPixelFormatSRGB(info.format) ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM
+                                                         : GL_COMPRESSED_RGBA_BPTC_UNORM;
+    } else if (True(image.flags & ImageFlagBits::Converted)) {
         internal_format = IsPixelFormatSRGB(info.format) ? GL_SRGB8_ALPHA8 : GL_RGBA8;
     } else {
         internal_format = GetFormatTuple(format).internal_format;
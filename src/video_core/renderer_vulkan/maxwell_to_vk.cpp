@@ -231,10 +231,15 @@ FormatInfo SurfaceFormat(const Device& device, FormatType format_type, PixelForm
         return {VK_FORMAT_A8B8G8R8_UNORM_PACK32, true, true};
     }
 
-    // Use A8B8G8R8_UNORM on hardware that doesn't support ASTC natively
+    // Use A8B8G8R8_UNORM, or BC7 when transcoding, on hardware that doesn't support ASTC natively
     if (!device.IsOptimalAstcSupported() && VideoCore::Surface::IsPixelFormatASTC(pixel_format)) {
         const bool is_srgb = VideoCore::Surface::IsPixelFormatSRGB(pixel_format);
-        tuple.format = is_srgb ? VK_FORMAT_A8B8G8R8_SRGB_PACK32 : VK_FORMAT_A8B8G8R8_UNORM_PACK32;
+        if (device.UseBC7ForASTC()) {
+            tuple.format = is_srgb ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+        } else {
+            tuple.format =
+                is_srgb ? VK_FORMAT_A8B8G8R8_SRGB_PACK32 : VK_FORMAT_A8B8G8R8_UNORM_PACK32;
+        }
     }
     const bool attachable = tuple.usage & Attachable;
     const bool storage = tuple.usage & Storage;
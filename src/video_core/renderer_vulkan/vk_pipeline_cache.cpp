@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <memory>
 #include <vector>
 
@@ -56,6 +57,26 @@ constexpr VideoCommon::Shader::CompilerSettings compiler_settings{
     .disable_else_derivation = true,
 };
 
+ShaderStageCacheKey MakeStageCacheKey(GPUVAddr gpu_addr, std::size_t stage,
+                                      const Specialization& specialization) {
+    ShaderStageCacheKey key{
+        .shader = gpu_addr,
+        .stage = static_cast<u32>(stage),
+        .base_binding = specialization.base_binding,
+        .point_size = Common::BitCast<u32>(specialization.point_size.value_or(0.0f)),
+        .enabled_attributes = static_cast<u32>(specialization.enabled_attributes.to_ulong()),
+        .attribute_types = {},
+        .ndc_minus_one_to_one = specialization.ndc_minus_one_to_one ? 1U : 0U,
+        .early_fragment_tests = specialization.early_fragment_tests ? 1U : 0U,
+        .alpha_test_ref = Common::BitCast<u32>(specialization.alpha_test_ref),
+        .alpha_test_func = static_cast<u32>(specialization.alpha_test_func),
+    };
+    for (std::size_t i = 0; i < key.attribute_types.size(); ++i) {
+        key.attribute_types[i] = static_cast<u32>(specialization.attribute_types[i]);
+    }
+    return key;
+}
+
 constexpr std::size_t GetStageFromProgram(std::size_t program) {
     return program == 0 ? 0 : program - 1;
 }
@@ -138,6 +159,15 @@ bool ComputePipelineCacheKey::operator==(const ComputePipelineCacheKey& rhs) con
     return std::memcmp(&rhs, this, sizeof *this) == 0;
 }
 
+std::size_t ShaderStageCacheKey::Hash() const noexcept {
+    const u64 hash = Common::CityHash64(reinterpret_cast<const char*>(this), sizeof *this);
+    return static_cast<std::size_t>(hash);
+}
+
+bool ShaderStageCacheKey::operator==(const ShaderStageCacheKey& rhs) const noexcept {
+    return std::memcmp(&rhs, this, sizeof *this) == 0;
+}
+
 Shader::Shader(Tegra::Engines::ConstBufferEngineInterface& engine_, ShaderType stage_,
                GPUVAddr gpu_addr_, VAddr cpu_addr_, ProgramCode program_code_, u32 main_offset_)
     : gpu_addr(gpu_addr_), program_code(std::move(program_code_)), registry(stage_, engine_),
@@ -154,10 +184,23 @@ VKPipelineCache::VKPipelineCache(RasterizerVulkan& rasterizer_, Tegra::GPU& gpu_
                                  VKUpdateDescriptorQueue& update_descriptor_queue_)
     : VideoCommon::ShaderCache<Shader>{rasterizer_}, gpu{gpu_}, maxwell3d{maxwell3d_},
       kepler_compute{kepler_compute_}, gpu_memory{gpu_memory_}, device{device_},
-      scheduler{scheduler_}, descriptor_pool{descriptor_pool_}, update_descriptor_queue{
-                                                                    update_descriptor_queue_} {}
-
-VKPipelineCache::~VKPipelineCache() = default;
+      scheduler{scheduler_}, descriptor_pool{descriptor_pool_},
+      update_descriptor_queue{update_descriptor_queue_},
+      driver_pipeline_cache{device.GetLogical().CreatePipelineCache({
+          .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+          .pNext = nullptr,
+          .flags = 0,
+          .initialDataSize = 0,
+          .pInitialData = nullptr,
+      })} {}
+
+VKPipelineCache::~VKPipelineCache() {
+    const u64 num_pipelines = pipelines_with_cached_stages + pipelines_with_new_stages;
+    if (num_pipelines != 0) {
+        LOG_INFO(Render_Vulkan, "{} of {} graphics pipelines reused already decompiled stages",
+                 pipelines_with_cached_stages, num_pipelines);
+    }
+}
 
 std::array<Shader*, Maxwell::MaxShaderProgram> VKPipelineCache::GetShaders() {
     std::array<Shader*, Maxwell::MaxShaderProgram> shaders{};
@@ -230,9 +273,9 @@ VKGraphicsPipeline* VKPipelineCache::GetGraphicsPipeline(
         gpu.ShaderNotify().MarkSharderBuilding();
         LOG_INFO(Render_Vulkan, "Compile 0x{:016X}", key.Hash());
         const auto [program, bindings] = DecompileShaders(key.fixed_state);
-        entry = std::make_unique<VKGraphicsPipeline>(device, scheduler, descriptor_pool,
-                                                     update_descriptor_queue, key, bindings,
-                                                     program, num_color_buffers);
+        entry = std::make_unique<VKGraphicsPipeline>(
+            device, scheduler, descriptor_pool, update_descriptor_queue, key, bindings, program,
+            num_color_buffers, *driver_pipeline_cache);
         gpu.ShaderNotify().MarkShaderComplete();
     }
     last_graphics_pipeline = entry.get();
@@ -328,6 +371,13 @@ void VKPipelineCache::OnShaderRemoval(Shader* shader) {
         Finish();
         it = compute_cache.erase(it);
     }
+    for (auto it = stage_cache.begin(); it != stage_cache.end();) {
+        if (it->first.shader != invalidated_addr) {
+            ++it;
+            continue;
+        }
+        it = stage_cache.erase(it);
+    }
 }
 
 std::pair<SPIRVProgram, std::vector<VkDescriptorSetLayoutBinding>>
@@ -354,6 +404,7 @@ VKPipelineCache::DecompileShaders(const FixedPipelineState& fixed_state) {
 
     SPIRVProgram program;
     std::vector<VkDescriptorSetLayoutBinding> bindings;
+    bool has_new_stages = false;
 
     for (std::size_t index = 0; index < Maxwell::MaxShaderProgram; ++index) {
         const auto program_enum = static_cast<Maxwell::ShaderProgram>(index);
@@ -370,9 +421,22 @@ VKPipelineCache::DecompileShaders(const FixedPipelineState& fixed_state) {
         const std::size_t stage = index == 0 ? 0 : index - 1; // Stage indices are 0 - 5
         const ShaderType program_type = GetShaderType(program_enum);
         const auto& entries = shader->GetEntries();
-        program[stage] = {
-            Decompile(device, shader->GetIR(), program_type, shader->GetRegistry(), specialization),
-            entries};
+        const auto decompile = [&] {
+            has_new_stages = true;
+            return Decompile(device, shader->GetIR(), program_type, shader->GetRegistry(),
+                             specialization);
+        };
+        if (cpu_addr) {
+            // Stages are only cached when they can be invalidated through their CPU address
+            const auto [stage_entry, is_cache_miss] =
+                stage_cache.try_emplace(MakeStageCacheKey(gpu_addr, stage, specialization));
+            if (is_cache_miss) {
+                stage_entry->second = decompile();
+            }
+            program[stage] = {stage_entry->second, entries};
+        } else {
+            program[stage] = {decompile(), entries};
+        }
 
         if (program_enum == Maxwell::ShaderProgram::VertexA) {
             // VertexB was combined with VertexA, so we skip the VertexB iteration
@@ -384,6 +448,11 @@ VKPipelineCache::DecompileShaders(const FixedPipelineState& fixed_state) {
             FillDescriptorLayout(entries, bindings, program_enum, specialization.base_binding);
         ASSERT(old_binding + entries.NumBindings() == specialization.base_binding);
     }
+    if (has_new_stages) {
+        ++pipelines_with_new_stages;
+    } else {
+        ++pipelines_with_cached_stages;
+    }
     return {std::move(program), std::move(bindings)};
 }
 
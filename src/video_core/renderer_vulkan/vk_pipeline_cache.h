@@ -59,6 +59,30 @@ static_assert(std::has_unique_object_representations_v<ComputePipelineCacheKey>)
 static_assert(std::is_trivially_copyable_v<ComputePipelineCacheKey>);
 static_assert(std::is_trivially_constructible_v<ComputePipelineCacheKey>);
 
+/// Identifies a decompiled shader stage by its address and the specialization it was built with.
+struct ShaderStageCacheKey {
+    GPUVAddr shader;
+    u32 stage;
+    u32 base_binding;
+    u32 point_size; ///< Zero when the point size is not specialized
+    u32 enabled_attributes;
+    std::array<u32, Maxwell::NumVertexAttributes> attribute_types;
+    u32 ndc_minus_one_to_one;
+    u32 early_fragment_tests;
+    u32 alpha_test_ref;
+    u32 alpha_test_func;
+
+    std::size_t Hash() const noexcept;
+
+    bool operator==(const ShaderStageCacheKey& rhs) const noexcept;
+
+    bool operator!=(const ShaderStageCacheKey& rhs) const noexcept {
+        return !operator==(rhs);
+    }
+};
+static_assert(std::has_unique_object_representations_v<ShaderStageCacheKey>);
+static_assert(std::is_trivially_copyable_v<ShaderStageCacheKey>);
+
 } // namespace Vulkan
 
 namespace std {
@@ -77,6 +101,13 @@ struct hash<Vulkan::ComputePipelineCacheKey> {
     }
 };
 
+template <>
+struct hash<Vulkan::ShaderStageCacheKey> {
+    std::size_t operator()(const Vulkan::ShaderStageCacheKey& k) const noexcept {
+        return k.Hash();
+    }
+};
+
 } // namespace std
 
 namespace Vulkan {
@@ -136,6 +167,11 @@ public:
 
     void EmplacePipeline(std::unique_ptr<VKGraphicsPipeline> pipeline);
 
+    /// Returns the driver pipeline cache shared by all graphics pipelines
+    VkPipelineCache GetDriverPipelineCache() const {
+        return *driver_pipeline_cache;
+    }
+
 protected:
     void OnShaderRemoval(Shader* shader) final;
 
@@ -153,6 +189,9 @@ private:
     VKDescriptorPool& descriptor_pool;
     VKUpdateDescriptorQueue& update_descriptor_queue;
 
+    /// Lets the driver reuse compiled stages between pipelines that only differ in fixed state
+    vk::PipelineCache driver_pipeline_cache;
+
     std::unique_ptr<Shader> null_shader;
     std::unique_ptr<Shader> null_kernel;
 
@@ -165,6 +204,12 @@ private:
     std::unordered_map<GraphicsPipelineCacheKey, std::unique_ptr<VKGraphicsPipeline>>
         graphics_cache;
     std::unordered_map<ComputePipelineCacheKey, std::unique_ptr<VKComputePipeline>> compute_cache;
+
+    /// Decompiled SPIR-V of graphics stages, shared by pipelines with the same specialization
+    std::unordered_map<ShaderStageCacheKey, std::vector<u32>> stage_cache;
+
+    u64 pipelines_with_cached_stages = 0; ///< Pipelines built without decompiling any stage
+    u64 pipelines_with_new_stages = 0;    ///< Pipelines that had to decompile at least one stage
 };
 
 void FillDescriptorUpdateTemplateEntries(
@@ -134,4 +134,27 @@ u64 HostCounter::BlockingQuery() const {
     }
 }
 
+std::optional<u64> HostCounter::NonBlockingQuery() const {
+    if (tick >= cache.GetScheduler().CurrentTick()) {
+        // The query has not been submitted, its result can't be available
+        return std::nullopt;
+    }
+
+    u64 data;
+    const VkResult query_result = cache.GetDevice().GetLogical().GetQueryResults(
+        query.first, query.second, 1, sizeof(data), &data, sizeof(data), VK_QUERY_RESULT_64_BIT);
+
+    switch (query_result) {
+    case VK_SUCCESS:
+        return data;
+    case VK_NOT_READY:
+        return std::nullopt;
+    case VK_ERROR_DEVICE_LOST:
+        cache.GetDevice().ReportLoss();
+        [[fallthrough]];
+    default:
+        throw vk::Exception(query_result);
+    }
+}
+
 } // namespace Vulkan
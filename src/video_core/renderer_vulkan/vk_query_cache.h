@@ -6,6 +6,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -86,6 +87,7 @@ public:
 
 private:
     u64 BlockingQuery() const override;
+    std::optional<u64> NonBlockingQuery() const override;
 
     VKQueryCache& cache;
     const VideoCore::QueryType type;
@@ -802,6 +802,10 @@ Image::Image(TextureCacheRuntime& runtime, const ImageInfo& info_, GPUVAddr gpu_
     }
     if (IsPixelFormatASTC(info.format) && !runtime.device.IsOptimalAstcSupported()) {
         flags |= VideoCommon::ImageFlagBits::Converted;
+        if (runtime.device.UseBC7ForASTC()) {
+            flags |= VideoCommon::ImageFlagBits::Transcoded;
+            converted_size_bytes = VideoCommon::CalculateTranscodedSizeBytes(info);
+        }
     }
     if (runtime.device.HasDebuggingToolAttached()) {
         if (image) {
@@ -205,7 +205,7 @@ void AsyncShaders::ShaderCompilerThread(Core::Frontend::GraphicsContext* context
             auto pipeline = std::make_unique<Vulkan::VKGraphicsPipeline>(
                 *work.vk_device, *work.scheduler, *work.descriptor_pool,
                 *work.update_descriptor_queue, work.key, work.bindings, work.program,
-                work.num_color_buffers);
+                work.num_color_buffers, work.pp_cache->GetDriverPipelineCache());
 
             work.pp_cache->EmplacePipeline(std::move(pipeline));
         }
@@ -53,8 +53,35 @@ ComputeInfo MakeComputeInfo(ShaderType shader_stage, ConstBufferEngineInterface&
     };
 }
 
+/// Mixes the bits of a value, this is the finalizer of SplitMix64.
+constexpr u64 MixBits(u64 value) {
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+constexpr u64 HashEntry(u64 kind, u64 first, u64 second, u64 value) {
+    return MixBits(MixBits(MixBits(kind ^ (first << 8)) ^ second) ^ value);
+}
+
 } // Anonymous namespace
 
+u64 HashKeys(const KeyMap& keys, const BoundSamplerMap& bound_samplers,
+             const BindlessSamplerMap& bindless_samplers) {
+    // Entries are summed so the result does not depend on the order of the hash maps
+    u64 hash = 0;
+    for (const auto& [key, value] : keys) {
+        hash += HashEntry(1, key.first, key.second, value);
+    }
+    for (const auto& [offset, sampler] : bound_samplers) {
+        hash += HashEntry(2, offset, 0, sampler.raw);
+    }
+    for (const auto& [key, sampler] : bindless_samplers) {
+        hash += HashEntry(3, key.first, key.second, sampler.raw);
+    }
+    return hash;
+}
+
 Registry::Registry(ShaderType shader_stage, const SerializedRegistryInfo& info)
     : stage{shader_stage}, stored_guest_driver_profile{info.guest_driver_profile},
       bound_buffer{info.bound_buffer}, graphics_info{info.graphics}, compute_info{info.compute} {}
@@ -144,22 +171,26 @@ bool Registry::IsConsistent() const {
     if (!engine) {
         return true;
     }
+    return IsConsistentWith(*engine);
+}
+
+bool Registry::IsConsistentWith(const ConstBufferEngineInterface& engine_) const {
     return std::all_of(keys.begin(), keys.end(),
-                       [this](const auto& pair) {
+                       [this, &engine_](const auto& pair) {
                            const auto [cbuf, offset] = pair.first;
                            const auto value = pair.second;
-                           return value == engine->AccessConstBuffer32(stage, cbuf, offset);
+                           return value == engine_.AccessConstBuffer32(stage, cbuf, offset);
                        }) &&
            std::all_of(bound_samplers.begin(), bound_samplers.end(),
-                       [this](const auto& sampler) {
+                       [this, &engine_](const auto& sampler) {
                            const auto [key, value] = sampler;
-                           return value == engine->AccessBoundSampler(stage, key);
+                           return value == engine_.AccessBoundSampler(stage, key);
                        }) &&
            std::all_of(bindless_samplers.begin(), bindless_samplers.end(),
-                       [this](const auto& sampler) {
+                       [this, &engine_](const auto& sampler) {
                            const auto [cbuf, offset] = sampler.first;
                            const auto value = sampler.second;
-                           return value == engine->AccessBindlessSampler(stage, cbuf, offset);
+                           return value == engine_.AccessBindlessSampler(stage, cbuf, offset);
                        });
 }
 
@@ -77,6 +77,10 @@ struct ComputeInfo {
 };
 static_assert(std::is_trivially_copyable_v<ComputeInfo> && std::is_standard_layout_v<ComputeInfo>);
 
+/// Hashes a set of keys independently of their iteration order. Returns zero when all are empty.
+u64 HashKeys(const KeyMap& keys, const BoundSamplerMap& bound_samplers,
+             const BindlessSamplerMap& bindless_samplers);
+
 struct SerializedRegistryInfo {
     VideoCore::GuestDriverProfile guest_driver_profile;
     u32 bound_buffer = 0;
@@ -122,6 +126,10 @@ public:
     /// Returns true if they are the same value, false otherwise.
     bool IsConsistent() const;
 
+    /// Checks keys and samplers against the passed engine's current const buffers.
+    /// Returns true if they are the same value, false otherwise.
+    bool IsConsistentWith(const Tegra::Engines::ConstBufferEngineInterface& engine_) const;
+
     /// Returns true if the keys are equal to the other ones in the registry.
     bool HasEqualKeys(const Registry& rhs) const;
 
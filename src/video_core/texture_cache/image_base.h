@@ -25,6 +25,7 @@ enum class ImageFlagBits : u32 {
     Strong = 1 << 5,      ///< Exists in the image table, the dimensions are can be trusted
     Registered = 1 << 6,  ///< True when the image is registered
     Picked = 1 << 7,      ///< Temporary flag to mark the image as picked
+    Transcoded = 1 << 8,  ///< Converted ASTC contents are stored as BC7 instead of RGBA8
 };
 DECLARE_ENUM_FLAG_OPERATORS(ImageFlagBits)
 
@@ -63,6 +64,9 @@ struct ImageBase {
     u64 modification_tick = 0;
     u64 frame_tick = 0;
 
+    /// Hash of the guest contents last uploaded, cleared when the host contents change otherwise
+    std::optional<u64> content_hash;
+
     std::array<u32, MAX_MIP_LEVELS> mip_level_offsets{};
 
     std::vector<ImageViewInfo> image_view_infos;
@@ -22,6 +22,7 @@
 #include "common/common_funcs.h"
 #include "common/common_types.h"
 #include "common/logging/log.h"
+#include "core/settings.h"
 #include "video_core/compatible_formats.h"
 #include "video_core/delayed_destruction_ring.h"
 #include "video_core/dirty_flags.h"
@@ -42,6 +43,7 @@
 #include "video_core/texture_cache/samples_helper.h"
 #include "video_core/texture_cache/slot_vector.h"
 #include "video_core/texture_cache/types.h"
+#include "video_core/texture_cache/upload_deduplicator.h"
 #include "video_core/texture_cache/util.h"
 #include "video_core/textures/texture.h"
 
@@ -70,6 +72,11 @@ class TextureCache {
     /// True when some copies have to be emulated
     static constexpr bool HAS_EMULATED_COPIES = P::HAS_EMULATED_COPIES;
 
+    /// Maximum number of guest bytes hashed per frame to deduplicate uploads
+    static constexpr size_t UPLOAD_HASH_BUDGET_PER_FRAME = 32ULL * 1024 * 1024;
+    /// Number of frames between logs of the deduplicated upload counters
+    static constexpr u64 UPLOAD_STATISTICS_INTERVAL = 600;
+
     /// Image view ID for null descriptors
     static constexpr ImageViewId NULL_IMAGE_VIEW_ID{0};
     /// Sampler ID for bugged sampler ids
@@ -179,6 +186,9 @@ public:
     /// Return true when a CPU region is modified from the GPU
     [[nodiscard]] bool IsRegionGpuModified(VAddr addr, size_t size);
 
+    /// Return the counters of deduplicated texture uploads
+    [[nodiscard]] const UploadDeduplicatorStatistics& GetUploadStatistics() const noexcept;
+
 private:
     /// Iterate over all page indices in a range
     template <typename Func>
@@ -209,7 +219,16 @@ private:
     FramebufferId GetFramebufferId(const RenderTargets& key);
 
     /// Refresh the contents (pixel data) of an image
-    void RefreshContents(Image& image);
+    void RefreshContents(Image& image, ImageId image_id);
+
+    /// Hash the guest contents of an image, returns nullopt when the frame budget is exhausted
+    [[nodiscard]] std::optional<u64> HashGuestContents(const Image& image);
+
+    /// Copy the contents of another image holding the same guest contents, returns true on success
+    [[nodiscard]] bool CopyDeduplicatedContents(Image& image, u64 hash);
+
+    /// Drop the content hash of an image whose host contents are being changed
+    void ForgetContentHash(ImageBase& image) noexcept;
 
     /// Upload data from guest to an image
     template <typename MapBuffer>
@@ -354,6 +373,10 @@ private:
 
     u64 modification_tick = 0;
     u64 frame_tick = 0;
+
+    const bool deduplicate_uploads = Settings::values.deduplicate_texture_uploads;
+    UploadDeduplicator upload_deduplicator{UPLOAD_HASH_BUDGET_PER_FRAME};
+    std::vector<u8> upload_hash_scratch;
 };
 
 template <class P>
@@ -382,7 +405,16 @@ void TextureCache<P>::TickFrame() {
     sentenced_images.Tick();
     sentenced_framebuffers.Tick();
     sentenced_image_view.Tick();
+    upload_deduplicator.TickFrame();
     ++frame_tick;
+    if (deduplicate_uploads && frame_tick % UPLOAD_STATISTICS_INTERVAL == 0) {
+        const UploadDeduplicatorStatistics& stats = GetUploadStatistics();
+        LOG_DEBUG(HW_GPU,
+                  "Texture uploads: {} skipped, {} reused images, {} misses, {} over budget, "
+                  "{} MiB hashed",
+                  stats.num_skipped_uploads, stats.num_reused_images, stats.num_misses,
+                  stats.num_over_budget, stats.hashed_bytes / (1024 * 1024));
+    }
 }
 
 template <class P>
@@ -794,7 +826,12 @@ bool TextureCache<P>::IsRegionGpuModified(VAddr addr, size_t size) {
 }
 
 template <class P>
-void TextureCache<P>::RefreshContents(Image& image) {
+const UploadDeduplicatorStatistics& TextureCache<P>::GetUploadStatistics() const noexcept {
+    return upload_deduplicator.Statistics();
+}
+
+template <class P>
+void TextureCache<P>::RefreshContents(Image& image, ImageId image_id) {
     if (False(image.flags & ImageFlagBits::CpuModified)) {
         // Only upload modified images
         return;
@@ -806,9 +843,74 @@ void TextureCache<P>::RefreshContents(Image& image) {
         LOG_WARNING(HW_GPU, "MSAA image uploads are not implemented");
         return;
     }
-    auto map = runtime.MapUploadBuffer(MapSizeBytes(image));
-    UploadImageContents(image, map, 0);
-    runtime.InsertUploadMemoryBarrier();
+    std::optional<u64> hash;
+    if (deduplicate_uploads) {
+        hash = HashGuestContents(image);
+        if (hash && image.content_hash == hash) {
+            // The guest wrote back the same contents the image already holds
+            upload_deduplicator.CountSkippedUpload();
+            return;
+        }
+    }
+    ForgetContentHash(image);
+    if (hash && CopyDeduplicatedContents(image, *hash)) {
+        upload_deduplicator.CountReusedImage();
+    } else {
+        if (hash) {
+            upload_deduplicator.CountMiss();
+        }
+        auto map = runtime.MapUploadBuffer(MapSizeBytes(image));
+        UploadImageContents(image, map, 0);
+        runtime.InsertUploadMemoryBarrier();
+    }
+    if (hash) {
+        image.content_hash = hash;
+        upload_deduplicator.Insert(*hash, image_id);
+    }
+}
+
+template <class P>
+std::optional<u64> TextureCache<P>::HashGuestContents(const Image& image) {
+    const size_t size = image.guest_size_bytes;
+    if (!upload_deduplicator.ConsumeBudget(size)) {
+        return std::nullopt;
+    }
+    const u8* data = gpu_memory.GetPointerRange(image.gpu_addr, size);
+    if (!data) {
+        upload_hash_scratch.resize(size);
+        gpu_memory.ReadBlockUnsafe(image.gpu_addr, upload_hash_scratch.data(), size);
+        data = upload_hash_scratch.data();
+    }
+    return upload_deduplicator.Hash(image.info, std::span(data, size));
+}
+
+template <class P>
+bool TextureCache<P>::CopyDeduplicatedContents(Image& image, u64 hash) {
+    const ImageId source_id = upload_deduplicator.Find(hash);
+    if (!source_id) {
+        return false;
+    }
+    Image& source = slot_images[source_id];
+    ASSERT(source.content_hash == hash);
+    if constexpr (HAS_EMULATED_COPIES) {
+        if (!runtime.CanImageBeCopied(image, source)) {
+            return false;
+        }
+    }
+    // Hashes include the image parameters, so both images have the same layout
+    const auto copies = MakeShrinkImageCopies(image.info, source.info, SubresourceBase{});
+    runtime.CopyImage(image, source, copies);
+    return true;
+}
+
+template <class P>
+void TextureCache<P>::ForgetContentHash(ImageBase& image) noexcept {
+    if (!image.content_hash) {
+        return;
+    }
+    // Other images with the same hash may be registered instead, dropping them is conservative
+    upload_deduplicator.Erase(*image.content_hash);
+    image.content_hash = std::nullopt;
 }
 
 template <class P>
@@ -824,7 +926,8 @@ void TextureCache<P>::UploadImageContents(Image& image, MapBuffer& map, size_t b
     } else if (True(image.flags & ImageFlagBits::Converted)) {
         std::vector<u8> unswizzled_data(image.unswizzled_size_bytes);
         auto copies = UnswizzleImage(gpu_memory, gpu_addr, image.info, unswizzled_data);
-        ConvertImage(unswizzled_data, image.info, mapped_span, copies);
+        ConvertImage(unswizzled_data, image.info, mapped_span, copies,
+                     True(image.flags & ImageFlagBits::Transcoded));
         image.UploadMemory(map, buffer_offset, copies);
     } else if (image.info.type == ImageType::Buffer) {
         const std::array copies{UploadBufferCopy(gpu_memory, gpu_addr, image, mapped_span)};
@@ -965,7 +1068,7 @@ ImageId TextureCache<P>::JoinImages(const ImageInfo& info, GPUVAddr gpu_addr, VA
     Image& new_image = slot_images[new_image_id];
 
     // TODO: Only upload what we need
-    RefreshContents(new_image);
+    RefreshContents(new_image, new_image_id);
 
     for (const ImageId overlap_id : overlap_ids) {
         Image& overlap = slot_images[overlap_id];
@@ -974,6 +1077,7 @@ ImageId TextureCache<P>::JoinImages(const ImageInfo& info, GPUVAddr gpu_addr, VA
         } else {
             const SubresourceBase base = new_image.TryFindBase(overlap.gpu_addr).value();
             const auto copies = MakeShrinkImageCopies(new_info, overlap.info, base);
+            ForgetContentHash(new_image);
             runtime.CopyImage(new_image, overlap, copies);
         }
         if (True(overlap.flags & ImageFlagBits::Tracked)) {
@@ -1216,6 +1320,7 @@ void TextureCache<P>::DeleteImage(ImageId image_id) {
     }
     ASSERT_MSG(False(image.flags & ImageFlagBits::Tracked), "Image was not untracked");
     ASSERT_MSG(False(image.flags & ImageFlagBits::Registered), "Image was not unregistered");
+    ForgetContentHash(image);
 
     // Mark render targets as dirty
     auto& dirty = maxwell3d.dirty.flags;
@@ -1290,6 +1395,7 @@ void TextureCache<P>::RemoveFramebuffers(std::span<const ImageViewId> removed_vi
 
 template <class P>
 void TextureCache<P>::MarkModification(ImageBase& image) noexcept {
+    ForgetContentHash(image);
     image.flags |= ImageFlagBits::GpuModified;
     image.modification_tick = ++modification_tick;
 }
@@ -1329,7 +1435,7 @@ void TextureCache<P>::PrepareImage(ImageId image_id, bool is_modification, bool
             TrackImage(image);
         }
     } else {
-        RefreshContents(image);
+        RefreshContents(image, image_id);
         SynchronizeAliases(image_id);
     }
     if (is_modification) {
@@ -1352,6 +1458,7 @@ template <class P>
 void TextureCache<P>::CopyImage(ImageId dst_id, ImageId src_id, std::span<const ImageCopy> copies) {
     Image& dst = slot_images[dst_id];
     Image& src = slot_images[src_id];
+    ForgetContentHash(dst);
     const auto dst_format_type = GetFormatType(dst.info.format);
     const auto src_format_type = GetFormatType(src.info.format);
     if (src_format_type == dst_format_type) {
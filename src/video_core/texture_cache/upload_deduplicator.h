@@ -0,0 +1,122 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <span>
+#include <unordered_map>
+
+#include "common/cityhash.h"
+#include "common/common_types.h"
+#include "video_core/texture_cache/image_info.h"
+#include "video_core/texture_cache/types.h"
+
+namespace VideoCommon {
+
+struct UploadDeduplicatorStatistics {
+    u64 num_skipped_uploads = 0; ///< Uploads skipped because the image already had the contents
+    u64 num_reused_images = 0;   ///< Uploads replaced with a copy from another image
+    u64 num_misses = 0;          ///< Hashed uploads without a match
+    u64 num_over_budget = 0;     ///< Uploads not hashed because the frame budget was exhausted
+    u64 hashed_bytes = 0;        ///< Total number of guest bytes hashed
+};
+
+/**
+ * Tracks hashes of the guest contents uploaded to images, so uploads of contents an image already
+ * holds can be skipped, and identical contents can be copied from another image on the host.
+ * Hashes include the image parameters, equal hashes imply images with the same layout.
+ *
+ * Every image registered with a hash has to be erased when its host contents change or when it is
+ * deleted, this keeps all the images in the table alive and holding the hashed contents.
+ */
+class UploadDeduplicator {
+public:
+    explicit UploadDeduplicator(size_t frame_budget_bytes_)
+        : frame_budget_bytes{frame_budget_bytes_} {}
+
+    /// Takes size bytes from the hashing budget of the current frame, returns false when they do
+    /// not fit and the contents should be uploaded without hashing
+    [[nodiscard]] bool ConsumeBudget(size_t size) noexcept {
+        if (size > frame_budget_bytes - frame_hashed_bytes) {
+            ++statistics.num_over_budget;
+            return false;
+        }
+        frame_hashed_bytes += size;
+        return true;
+    }
+
+    /// Returns the hash of the guest contents of an image with the given parameters
+    [[nodiscard]] u64 Hash(const ImageInfo& info, std::span<const u8> guest_data) {
+        statistics.hashed_bytes += guest_data.size();
+        return Common::CityHash64WithSeed(reinterpret_cast<const char*>(guest_data.data()),
+                                          guest_data.size(), HashInfo(info));
+    }
+
+    /// Returns an image holding the contents of the given hash, or an invalid id
+    [[nodiscard]] ImageId Find(u64 hash) const {
+        const auto it = images.find(hash);
+        return it != images.end() ? it->second : ImageId{};
+    }
+
+    /// Registers an image as holding the contents of the given hash
+    void Insert(u64 hash, ImageId image_id) {
+        images.insert_or_assign(hash, image_id);
+    }
+
+    /// Unregisters the image holding the contents of the given hash
+    void Erase(u64 hash) {
+        images.erase(hash);
+    }
+
+    /// Restores the hashing budget, called once per frame
+    void TickFrame() noexcept {
+        frame_hashed_bytes = 0;
+    }
+
+    void CountSkippedUpload() noexcept {
+        ++statistics.num_skipped_uploads;
+    }
+
+    void CountReusedImage() noexcept {
+        ++statistics.num_reused_images;
+    }
+
+    void CountMiss() noexcept {
+        ++statistics.num_misses;
+    }
+
+    [[nodiscard]] const UploadDeduplicatorStatistics& Statistics() const noexcept {
+        return statistics;
+    }
+
+private:
+    [[nodiscard]] static u64 HashInfo(const ImageInfo& info) noexcept {
+        const bool is_linear = info.type == ImageType::Linear;
+        const std::array<u32, 14> key{
+            static_cast<u32>(info.format),
+            static_cast<u32>(info.type),
+            static_cast<u32>(info.resources.levels),
+            static_cast<u32>(info.resources.layers),
+            info.size.width,
+            info.size.height,
+            info.size.depth,
+            is_linear ? info.pitch : info.block.width,
+            is_linear ? 0 : info.block.height,
+            is_linear ? 0 : info.block.depth,
+            info.layer_stride,
+            info.maybe_unaligned_layer_stride,
+            info.num_samples,
+            info.tile_width_spacing,
+        };
+        return Common::CityHash64(reinterpret_cast<const char*>(key.data()), sizeof(key));
+    }
+
+    size_t frame_budget_bytes;
+    size_t frame_hashed_bytes = 0;
+    std::unordered_map<u64, ImageId> images;
+    UploadDeduplicatorStatistics statistics;
+};
+
+} // namespace VideoCommon
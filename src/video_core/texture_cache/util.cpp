@@ -31,6 +31,7 @@
 #include <numeric>
 #include <optional>
 #include <span>
+#include <thread>
 #include <vector>
 
 #include "common/alignment.h"
@@ -38,6 +39,7 @@
 #include "common/bit_util.h"
 #include "common/common_types.h"
 #include "common/div_ceil.h"
+#include "common/thread_worker.h"
 #include "video_core/compatible_formats.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/memory_manager.h"
@@ -48,6 +50,7 @@
 #include "video_core/texture_cache/samples_helper.h"
 #include "video_core/texture_cache/util.h"
 #include "video_core/textures/astc.h"
+#include "video_core/textures/bc7.h"
 #include "video_core/textures/decoders.h"
 
 namespace VideoCommon {
@@ -79,6 +82,14 @@ using VideoCore::Surface::PixelFormatFromRenderTargetFormat;
 using VideoCore::Surface::SurfaceType;
 
 constexpr u32 CONVERTED_BYTES_PER_BLOCK = BytesPerBlock(PixelFormat::A8B8G8R8_UNORM);
+constexpr u32 ASTC_BYTES_PER_BLOCK = BytesPerBlock(PixelFormat::ASTC_2D_4X4_UNORM);
+constexpr u32 TRANSCODED_BYTES_PER_BLOCK = BytesPerBlock(PixelFormat::BC7_UNORM);
+constexpr Extent2D TRANSCODED_TILE_SIZE{4, 4};
+
+/// Rows of pixels transcoded by each task, rounded up to a multiple of both tile heights
+constexpr u32 TRANSCODE_BAND_HEIGHT = 64;
+/// Images with fewer pixels than this are transcoded on the calling thread
+constexpr u32 PARALLEL_TRANSCODE_THRESHOLD = 256 * 256;
 
 struct LevelInfo {
     Extent3D size;
@@ -623,6 +634,56 @@ void SwizzleBlockLinearImage(Tegra::MemoryManager& gpu_memory, GPUVAddr gpu_addr
     ASSERT(host_offset - copy.buffer_offset == copy.buffer_size);
 }
 
+Common::ThreadWorker& TranscodeWorkers() {
+    static Common::ThreadWorker workers(
+        std::max<std::size_t>(std::thread::hardware_concurrency() / 2, 1), "yuzu:AstcTranscode");
+    return workers;
+}
+
+/// Decodes the ASTC layers of a mip level and encodes them again as BC7, in bands of rows
+void TranscodeASTCToBC7(std::span<const u8> input, std::span<u8> output, Extent3D size,
+                        u32 num_layers, Extent2D tile_size) {
+    const u32 band_height = Common::AlignUp(
+        TRANSCODE_BAND_HEIGHT, std::lcm(tile_size.height, TRANSCODED_TILE_SIZE.height));
+    const size_t input_row_size =
+        static_cast<size_t>(Common::DivCeil(size.width, tile_size.width)) * ASTC_BYTES_PER_BLOCK;
+    const size_t input_layer_size = input_row_size * Common::DivCeil(size.height, tile_size.height);
+    const size_t output_row_size =
+        static_cast<size_t>(Common::DivCeil(size.width, TRANSCODED_TILE_SIZE.width)) *
+        TRANSCODED_BYTES_PER_BLOCK;
+    const size_t output_layer_size =
+        output_row_size * Common::DivCeil(size.height, TRANSCODED_TILE_SIZE.height);
+
+    const auto transcode_band = [=](u32 layer, u32 first_row) {
+        const u32 num_rows = std::min(band_height, size.height - first_row);
+        std::vector<u8> pixels(static_cast<size_t>(size.width) * num_rows * 4);
+        Tegra::Texture::ASTC::Decompress(
+            input.subspan(layer * input_layer_size + first_row / tile_size.height * input_row_size),
+            size.width, num_rows, 1, tile_size.width, tile_size.height, pixels);
+        Tegra::Texture::BC7::Encode(
+            pixels, size.width, num_rows,
+            output.subspan(layer * output_layer_size +
+                           first_row / TRANSCODED_TILE_SIZE.height * output_row_size));
+    };
+    if (size.width * size.height * num_layers < PARALLEL_TRANSCODE_THRESHOLD) {
+        for (u32 layer = 0; layer < num_layers; ++layer) {
+            for (u32 first_row = 0; first_row < size.height; first_row += band_height) {
+                transcode_band(layer, first_row);
+            }
+        }
+        return;
+    }
+    Common::ThreadWorker& workers = TranscodeWorkers();
+    for (u32 layer = 0; layer < num_layers; ++layer) {
+        for (u32 first_row = 0; first_row < size.height; first_row += band_height) {
+            workers.QueueWork([&transcode_band, layer, first_row] {
+                transcode_band(layer, first_row);
+            });
+        }
+    }
+    workers.WaitForRequests();
+}
+
 } // Anonymous namespace
 
 u32 CalculateGuestSizeInBytes(const ImageInfo& info) noexcept {
@@ -663,6 +724,11 @@ u32 CalculateConvertedSizeBytes(const ImageInfo& info) noexcept {
     return NumBlocksPerLayer(info, TILE_SIZE) * info.resources.layers * CONVERTED_BYTES_PER_BLOCK;
 }
 
+u32 CalculateTranscodedSizeBytes(const ImageInfo& info) noexcept {
+    return NumBlocksPerLayer(info, TRANSCODED_TILE_SIZE) * info.resources.layers *
+           TRANSCODED_BYTES_PER_BLOCK;
+}
+
 u32 CalculateLayerStride(const ImageInfo& info) noexcept {
     ASSERT(info.type != ImageType::Linear);
     const u32 layer_size = CalculateLayerSize(info);
@@ -901,7 +967,7 @@ BufferCopy UploadBufferCopy(Tegra::MemoryManager& gpu_memory, GPUVAddr gpu_addr,
 }
 
 void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
-                  std::span<BufferImageCopy> copies) {
+                  std::span<BufferImageCopy> copies, bool transcode_bc7) {
     u32 output_offset = 0;
 
     const Extent2D tile_size = DefaultBlockSize(info.format);
@@ -914,6 +980,22 @@ void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8
         ASSERT(copy.buffer_row_length == Common::AlignUp(mip_size.width, tile_size.width));
         ASSERT(copy.buffer_image_height == Common::AlignUp(mip_size.height, tile_size.height));
 
+        if (IsPixelFormatASTC(info.format) && transcode_bc7) {
+            ASSERT(copy.image_extent.depth == 1);
+            const u32 num_layers = copy.image_subresource.num_layers;
+            TranscodeASTCToBC7(input.subspan(copy.buffer_offset), output.subspan(output_offset),
+                               copy.image_extent, num_layers, tile_size);
+            const u32 size_bytes =
+                NumBlocks(mip_size, TRANSCODED_TILE_SIZE) * num_layers * TRANSCODED_BYTES_PER_BLOCK;
+            copy.buffer_offset = output_offset;
+            copy.buffer_size = size_bytes;
+            copy.buffer_row_length = Common::AlignUp(mip_size.width, TRANSCODED_TILE_SIZE.width);
+            copy.buffer_image_height =
+                Common::AlignUp(mip_size.height, TRANSCODED_TILE_SIZE.height);
+
+            output_offset += size_bytes;
+            continue;
+        }
         if (IsPixelFormatASTC(info.format)) {
             ASSERT(copy.image_extent.depth == 1);
             Tegra::Texture::ASTC::Decompress(input.subspan(copy.buffer_offset),
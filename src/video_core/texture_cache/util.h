@@ -32,6 +32,8 @@ struct OverlapResult {
 
 [[nodiscard]] u32 CalculateConvertedSizeBytes(const ImageInfo& info) noexcept;
 
+[[nodiscard]] u32 CalculateTranscodedSizeBytes(const ImageInfo& info) noexcept;
+
 [[nodiscard]] u32 CalculateLayerStride(const ImageInfo& info) noexcept;
 
 [[nodiscard]] u32 CalculateLayerSize(const ImageInfo& info) noexcept;
@@ -64,7 +66,7 @@ struct OverlapResult {
                                           const ImageBase& image, std::span<u8> output);
 
 void ConvertImage(std::span<const u8> input, const ImageInfo& info, std::span<u8> output,
-                  std::span<BufferImageCopy> copies);
+                  std::span<BufferImageCopy> copies, bool transcode_bc7 = false);
 
 [[nodiscard]] std::vector<BufferImageCopy> FullDownloadCopies(const ImageInfo& info);
 
@@ -0,0 +1,317 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "video_core/textures/bc7.h"
+
+namespace Tegra::Texture::BC7 {
+namespace {
+
+constexpr std::size_t NUM_PIXELS = 16;
+constexpr std::size_t NUM_CHANNELS = 4;
+constexpr u32 NUM_INDICES = 16;
+constexpr u32 MODE = 6;
+
+/// Interpolation weights of 4-bit indices, out of 64
+constexpr std::array<u32, NUM_INDICES> WEIGHTS{0,  4,  9,  13, 17, 21, 26, 30,
+                                               34, 38, 43, 47, 51, 55, 60, 64};
+
+using Vector = std::array<float, NUM_CHANNELS>;
+using Color = std::array<u32, NUM_CHANNELS>;
+using Pixels = std::array<Vector, NUM_PIXELS>;
+using Indices = std::array<u32, NUM_PIXELS>;
+
+/// Mode 6 endpoint, 7 bits per channel and a shared least significant bit
+struct Endpoint {
+    Color color{};
+    u32 pbit{};
+
+    Color Expand() const {
+        Color result;
+        for (std::size_t c = 0; c < NUM_CHANNELS; ++c) {
+            result[c] = (color[c] << 1) | pbit;
+        }
+        return result;
+    }
+};
+
+struct Candidate {
+    Endpoint first;
+    Endpoint second;
+    Indices indices{};
+    float error = std::numeric_limits<float>::max();
+};
+
+Endpoint Quantize(const Vector& value) {
+    Endpoint best;
+    float best_error = std::numeric_limits<float>::max();
+    for (u32 pbit = 0; pbit < 2; ++pbit) {
+        Endpoint endpoint{.pbit = pbit};
+        float error = 0.0f;
+        for (std::size_t c = 0; c < NUM_CHANNELS; ++c) {
+            const float clamped = std::clamp(value[c], 0.0f, 255.0f);
+            const float scaled = (clamped - static_cast<float>(pbit)) / 2.0f;
+            endpoint.color[c] = static_cast<u32>(std::clamp(std::lround(scaled), 0L, 127L));
+            const float diff = static_cast<float>((endpoint.color[c] << 1) | pbit) - value[c];
+            error += diff * diff;
+        }
+        if (error < best_error) {
+            best_error = error;
+            best = endpoint;
+        }
+    }
+    return best;
+}
+
+/// Picks the closest palette entry for each pixel and fills the candidate error
+void AssignIndices(const Pixels& pixels, Candidate& candidate) {
+    const Color first = candidate.first.Expand();
+    const Color second = candidate.second.Expand();
+    std::array<Vector, NUM_INDICES> palette;
+    for (u32 i = 0; i < NUM_INDICES; ++i) {
+        for (std::size_t c = 0; c < NUM_CHANNELS; ++c) {
+            const u32 value = ((64 - WEIGHTS[i]) * first[c] + WEIGHTS[i] * second[c] + 32) >> 6;
+            palette[i][c] = static_cast<float>(value);
+        }
+    }
+    // Only the entries next to the projection of each pixel on the endpoint line are considered
+    Vector direction;
+    float direction_length = 0.0f;
+    for (std::size_t c = 0; c < NUM_CHANNELS; ++c) {
+        direction[c] = palette[NUM_INDICES - 1][c] - palette[0][c];
+        direction_length += direction[c] * direction[c];
+    }
+    candidate.error = 0.0f;
+    for (std::size_t pixel = 0; pixel < NUM_PIXELS; ++pixel) {
+        u32 nearest = 0;
+        if (direction_length > 0.0f) {
+            float projection = 0.0f;
+            for (std::size_t c = 0; c < NUM_CHANNELS; ++c) {
+                projection += (pixels[pixel][c] - palette[0][c]) * direction[c];
+            }
+            const float weight = std::clamp(projection / direction_length, 0.0f, 1.0f) * 64.0f;
+            nearest = static_cast<u32>(
+                std::lower_bound(WEIGHTS.begin(), WEIGHTS.end(), weight) - WEIGHTS.begin());
+        }
+        const u32 first_index = nearest == 0 ? 0 : nearest - 1;
+        const u32 last_index = std::min(nearest + 1, NUM_INDICES - 1);
+        float best_error = std::numeric_limits<float>::max();
+        for (u32 i = first_index; i <= last_index; ++i) {
+            float error = 0.0f;
+            for (std::size_t c = 0; c < NUM_CHANNELS; ++c) {
+                const float diff = palette[i][c] - pixels[pixel][c];
+                error += diff * diff;
+            }
+            if (error < best_error) {
+                best_error = error;
+                candidate.indices[pixel] = i;
+            }
+        }
+        candidate.error += best_error;
+    }
+}
+
+/// Fits the endpoints to the extremes of the block along its principal axis
+void FitPrincipalAxis(const Pixels& pixels, Vector& first, Vector& second) {
+    Vector mean{};
+    Vector min_value;
+    Vector max_value;
+    min_value.fill(std::numeric_limits<float>::max());
+    max_value.fill(std::numeric_limits<float>::lowest());
+    for (const Vector& pixel : pixels) {
+        for (std::size_t c = 0; c < NUM_CHANNELS; ++c) {
+            mean[c] += pixel[c] / NUM_PIXELS;
+            min_value[c] = std::min(min_value[c], pixel[c]);
+            max_value[c] = std::max(max_value[c], pixel[c]);
+        }
+    }
+
+    std::array<Vector, NUM_CHANNELS> covariance{};
+    for (const Vector& pixel : pixels) {
+        for (std::size_t i = 0; i < NUM_CHANNELS; ++i) {
+            for (std::size_t j = 0; j < NUM_CHANNELS; ++j) {
+                covariance[i][j] += (pixel[i] - mean[i]) * (pixel[j] - mean[j]);
+            }
+        }
+    }
+
+    // Power iteration, starting from the diagonal of the bounding box
+    Vector axis;
+    for (std::size_t c = 0; c < NUM_CHANNELS; ++c) {
+        axis[c] = max_value[c] - min_value[c];
+    }
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        Vector next{};
+        for (std::size_t i = 0; i < NUM_CHANNELS; ++i) {
+            for (std::size_t j = 0; j < NUM_CHANNELS; ++j) {
+                next[i] += covariance[i][j] * axis[j];
+            }
+        }
+        const float length = std::max({std::abs(next[0]), std::abs(next[1]), std::abs(next[2]),
+                                        std::abs(next[3])});
+        if (length < 1e-6f) {
+            break;
+        }
+        for (std::size_t c = 0; c < NUM_CHANNELS; ++c) {
+            axis[c] = next[c] / length;
+        }
+    }
+    float axis_length = 0.0f;
+    for (const float value : axis) {
+        axis_length += value * value;
+    }
+    if (axis_length < 1e-12f) {
+        first = mean;
+        second = mean;
+        return;
+    }
+
+    float min_projection = std::numeric_limits<float>::max();
+    float max_projection = std::numeric_limits<float>::lowest();
+    for (const Vector& pixel : pixels) {
+        float projection = 0.0f;
+        for (std::size_t c = 0; c < NUM_CHANNELS; ++c) {
+            projection += (pixel[c] - mean[c]) * axis[c];
+        }
+        min_projection = std::min(min_projection, projection);
+        max_projection = std::max(max_projection, projection);
+    }
+    for (std::size_t c = 0; c < NUM_CHANNELS; ++c) {
+        first[c] = mean[c] + axis[c] * min_projection / axis_length;
+        second[c] = mean[c] + axis[c] * max_projection / axis_length;
+    }
+}
+
+/// Solves the endpoints minimizing the error for the given indices. Returns false if singular.
+bool FitLeastSquares(const Pixels& pixels, const Indices& indices, Vector& first,
+                     Vector& second) {
+    float aa = 0.0f;
+    float ab = 0.0f;
+    float bb = 0.0f;
+    Vector first_sum{};
+    Vector second_sum{};
+    for (std::size_t pixel = 0; pixel < NUM_PIXELS; ++pixel) {
+        const float b = static_cast<float>(WEIGHTS[indices[pixel]]) / 64.0f;
+        const float a = 1.0f - b;
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+        for (std::size_t c = 0; c < NUM_CHANNELS; ++c) {
+            first_sum[c] += a * pixels[pixel][c];
+            second_sum[c] += b * pixels[pixel][c];
+        }
+    }
+    const float determinant = aa * bb - ab * ab;
+    if (std::abs(determinant) < 1e-6f) {
+        return false;
+    }
+    for (std::size_t c = 0; c < NUM_CHANNELS; ++c) {
+        first[c] = (bb * first_sum[c] - ab * second_sum[c]) / determinant;
+        second[c] = (aa * second_sum[c] - ab * first_sum[c]) / determinant;
+    }
+    return true;
+}
+
+class BitWriter {
+public:
+    void Write(u32 value, u32 num_bits) {
+        if (position < 64) {
+            words[0] |= static_cast<u64>(value) << position;
+            if (position + num_bits > 64) {
+                words[1] |= static_cast<u64>(value) >> (64 - position);
+            }
+        } else {
+            words[1] |= static_cast<u64>(value) << (position - 64);
+        }
+        position += num_bits;
+    }
+
+    void Store(std::span<u8, BLOCK_SIZE> block) const {
+        std::memcpy(block.data(), words.data(), BLOCK_SIZE);
+    }
+
+private:
+    std::array<u64, 2> words{};
+    u32 position = 0;
+};
+
+void Pack(Candidate& candidate, std::span<u8, BLOCK_SIZE> block) {
+    // The most significant bit of the first index is implicitly zero
+    if (candidate.indices[0] >= NUM_INDICES / 2) {
+        std::swap(candidate.first, candidate.second);
+        for (u32& index : candidate.indices) {
+            index = NUM_INDICES - 1 - index;
+        }
+    }
+    BitWriter writer;
+    writer.Write(1U << MODE, MODE + 1);
+    for (std::size_t c = 0; c < NUM_CHANNELS; ++c) {
+        writer.Write(candidate.first.color[c], 7);
+        writer.Write(candidate.second.color[c], 7);
+    }
+    writer.Write(candidate.first.pbit, 1);
+    writer.Write(candidate.second.pbit, 1);
+    writer.Write(candidate.indices[0], 3);
+    for (std::size_t pixel = 1; pixel < NUM_PIXELS; ++pixel) {
+        writer.Write(candidate.indices[pixel], 4);
+    }
+    writer.Store(block);
+}
+
+} // Anonymous namespace
+
+void EncodeBlock(std::span<const u8, 64> pixels, std::span<u8, BLOCK_SIZE> block) {
+    Pixels values;
+    for (std::size_t pixel = 0; pixel < NUM_PIXELS; ++pixel) {
+        for (std::size_t c = 0; c < NUM_CHANNELS; ++c) {
+            values[pixel][c] = static_cast<float>(pixels[pixel * NUM_CHANNELS + c]);
+        }
+    }
+
+    Vector first;
+    Vector second;
+    FitPrincipalAxis(values, first, second);
+    Candidate best{
+        .first = Quantize(first),
+        .second = Quantize(second),
+    };
+    AssignIndices(values, best);
+
+    if (best.error > 0.0f && FitLeastSquares(values, best.indices, first, second)) {
+        Candidate refined{
+            .first = Quantize(first),
+            .second = Quantize(second),
+        };
+        AssignIndices(values, refined);
+        if (refined.error < best.error) {
+            best = refined;
+        }
+    }
+    Pack(best, block);
+}
+
+void Encode(std::span<const u8> input, u32 width, u32 height, std::span<u8> output) {
+    std::array<u8, 64> pixels;
+    std::size_t block_offset = 0;
+    for (u32 block_y = 0; block_y < height; block_y += 4) {
+        for (u32 block_x = 0; block_x < width; block_x += 4) {
+            for (u32 y = 0; y < 4; ++y) {
+                const u32 row = std::min(block_y + y, height - 1);
+                for (u32 x = 0; x < 4; ++x) {
+                    const u32 column = std::min(block_x + x, width - 1);
+                    std::memcpy(&pixels[(y * 4 + x) * 4], &input[(row * width + column) * 4], 4);
+                }
+            }
+            EncodeBlock(pixels, output.subspan(block_offset).first<BLOCK_SIZE>());
+            block_offset += BLOCK_SIZE;
+        }
+    }
+}
+
+} // namespace Tegra::Texture::BC7
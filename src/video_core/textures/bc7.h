@@ -0,0 +1,33 @@
+// Copyright 2021 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <span>
+
+#include "common/common_types.h"
+
+namespace Tegra::Texture::BC7 {
+
+/// Size in bytes of an encoded 4x4 block.
+constexpr std::size_t BLOCK_SIZE = 16;
+
+/**
+ * Encodes a 4x4 block of RGBA8 pixels, stored row by row, as a BC7 mode 6 block.
+ * Endpoints are fit along the principal axis of the block and refined once with least squares.
+ */
+void EncodeBlock(std::span<const u8, 64> pixels, std::span<u8, BLOCK_SIZE> block);
+
+/**
+ * Encodes a RGBA8 image stored row by row into BC7 blocks.
+ * Partial blocks at the right and bottom edges are filled by replicating the edge pixels.
+ */
+void Encode(std::span<const u8> input, u32 width, u32 height, std::span<u8> output);
+
+/// Returns the size in bytes of a BC7 encoded image with the given dimensions.
+[[nodiscard]] constexpr std::size_t EncodedSize(u32 width, u32 height) {
+    return static_cast<std::size_t>((width + 3) / 4) * ((height + 3) / 4) * BLOCK_SIZE;
+}
+
+} // namespace Tegra::Texture::BC7
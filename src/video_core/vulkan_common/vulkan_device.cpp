@@ -248,7 +248,7 @@ Device::Device(VkInstance instance_, vk::PhysicalDevice physical_, VkSurfaceKHR
         .samplerAnisotropy = true,
         .textureCompressionETC2 = false,
         .textureCompressionASTC_LDR = is_optimal_astc_supported,
-        .textureCompressionBC = false,
+        .textureCompressionBC = is_texture_bc_supported,
         .occlusionQueryPrecise = true,
         .pipelineStatisticsQuery = false,
         .vertexPipelineStoresAndAtomics = true,
@@ -806,6 +806,16 @@ void Device::SetupFeatures() {
     is_formatless_image_load_supported = supported_features.shaderStorageImageReadWithoutFormat;
     is_blit_depth_stencil_supported = TestDepthStencilBlits();
     is_optimal_astc_supported = IsOptimalAstcSupported(supported_features);
+    is_texture_bc_supported = supported_features.textureCompressionBC;
+
+    static constexpr VkFormatFeatureFlags bc7_usage = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT |
+                                                      VK_FORMAT_FEATURE_TRANSFER_SRC_BIT |
+                                                      VK_FORMAT_FEATURE_TRANSFER_DST_BIT;
+    use_bc7_for_astc =
+        Settings::values.transcode_astc_to_bc7 && !is_optimal_astc_supported &&
+        is_texture_bc_supported &&
+        IsFormatSupported(VK_FORMAT_BC7_UNORM_BLOCK, bc7_usage, FormatType::Optimal) &&
+        IsFormatSupported(VK_FORMAT_BC7_SRGB_BLOCK, bc7_usage, FormatType::Optimal);
 }
 
 void Device::CollectTelemetryParameters() {
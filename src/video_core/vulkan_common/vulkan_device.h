@@ -130,6 +130,11 @@ public:
         return is_optimal_astc_supported;
     }
 
+    /// Returns true if ASTC textures are transcoded to BC7 instead of decoded to RGBA8.
+    bool UseBC7ForASTC() const {
+        return use_bc7_for_astc;
+    }
+
     /// Returns true if the device supports float16 natively
     bool IsFloat16Supported() const {
         return is_float16_supported;
@@ -274,6 +279,7 @@ private:
     bool is_warp_potentially_bigger{};      ///< Host warp size can be bigger than guest.
     bool is_formatless_image_load_supported{}; ///< Support for shader image read without format.
     bool is_blit_depth_stencil_supported{};    ///< Support for blitting from and to depth stencil.
+    bool is_texture_bc_supported{};            ///< Support for BC compressed textures.
     bool nv_viewport_swizzle{};                ///< Support for VK_NV_viewport_swizzle.
     bool khr_uniform_buffer_standard_layout{}; ///< Support for std430 on UBOs.
     bool ext_index_type_uint8{};               ///< Support for VK_EXT_index_type_uint8.
@@ -292,6 +298,7 @@ private:
 
     // Asynchronous Graphics Pipeline setting
     bool use_asynchronous_shaders{}; ///< Setting to use asynchronous shaders/graphics pipeline
+    bool use_bc7_for_astc{};         ///< Setting to store non-native ASTC textures as BC7
 
     // Telemetry parameters
     std::string vendor_name;                      ///< Device's driver name.
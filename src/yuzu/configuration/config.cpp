@@ -578,6 +578,12 @@ void Config::ReadCoreValues() {
     qt_config->beginGroup(QStringLiteral("Core"));
 
     ReadSettingGlobal(Settings::values.use_multi_core, QStringLiteral("use_multi_core"), true);
+    Settings::values.cpu_idle_policy = static_cast<Settings::CPUIdlePolicy>(
+        ReadSetting(QStringLiteral("cpu_idle_policy"), 0).toInt());
+    Settings::values.pin_host_threads =
+        ReadSetting(QStringLiteral("pin_host_threads"), false).toBool();
+    Settings::values.use_patched_module_cache =
+        ReadSetting(QStringLiteral("use_patched_module_cache"), false).toBool();
 
     qt_config->endGroup();
 }
@@ -641,6 +647,14 @@ void Config::ReadDebuggingValues() {
     Settings::values.quest_flag = ReadSetting(QStringLiteral("quest_flag"), false).toBool();
     Settings::values.disable_macro_jit =
         ReadSetting(QStringLiteral("disable_macro_jit"), false).toBool();
+    Settings::values.use_host_write_tracking =
+        ReadSetting(QStringLiteral("use_host_write_tracking"), false).toBool();
+    Settings::values.enable_jit_perf_map =
+        ReadSetting(QStringLiteral("enable_jit_perf_map"), false).toBool();
+    Settings::values.enable_guest_profiler =
+        ReadSetting(QStringLiteral("enable_guest_profiler"), false).toBool();
+    Settings::values.enable_jit_block_profile =
+        ReadSetting(QStringLiteral("enable_jit_block_profile"), false).toBool();
     Settings::values.extended_logging =
         ReadSetting(QStringLiteral("extended_logging"), false).toBool();
 
@@ -781,6 +795,7 @@ void Config::ReadRendererValues() {
     ReadSettingGlobal(Settings::values.gpu_accuracy, QStringLiteral("gpu_accuracy"), 0);
     ReadSettingGlobal(Settings::values.use_asynchronous_gpu_emulation,
                       QStringLiteral("use_asynchronous_gpu_emulation"), true);
+    ReadSettingGlobal(Settings::values.query_resolution, QStringLiteral("query_resolution"), 0);
     ReadSettingGlobal(Settings::values.use_nvdec_emulation, QStringLiteral("use_nvdec_emulation"),
                       true);
     ReadSettingGlobal(Settings::values.use_vsync, QStringLiteral("use_vsync"), true);
@@ -790,6 +805,14 @@ void Config::ReadRendererValues() {
                       QStringLiteral("use_asynchronous_shaders"), false);
     ReadSettingGlobal(Settings::values.use_fast_gpu_time, QStringLiteral("use_fast_gpu_time"),
                       true);
+    Settings::values.composition_target_latency_us = static_cast<u16>(
+        ReadSetting(QStringLiteral("composition_target_latency_us"), 0).toUInt());
+    Settings::values.unlock_framerate =
+        ReadSetting(QStringLiteral("unlock_framerate"), false).toBool();
+    Settings::values.transcode_astc_to_bc7 =
+        ReadSetting(QStringLiteral("transcode_astc_to_bc7"), false).toBool();
+    Settings::values.deduplicate_texture_uploads =
+        ReadSetting(QStringLiteral("deduplicate_texture_uploads"), false).toBool();
     ReadSettingGlobal(Settings::values.bg_red, QStringLiteral("bg_red"), 0.0);
     ReadSettingGlobal(Settings::values.bg_green, QStringLiteral("bg_green"), 0.0);
     ReadSettingGlobal(Settings::values.bg_blue, QStringLiteral("bg_blue"), 0.0);
@@ -1191,6 +1214,11 @@ void Config::SaveCoreValues() {
     qt_config->beginGroup(QStringLiteral("Core"));
 
     WriteSettingGlobal(QStringLiteral("use_multi_core"), Settings::values.use_multi_core, true);
+    WriteSetting(QStringLiteral("cpu_idle_policy"),
+                 static_cast<int>(Settings::values.cpu_idle_policy), 0);
+    WriteSetting(QStringLiteral("pin_host_threads"), Settings::values.pin_host_threads, false);
+    WriteSetting(QStringLiteral("use_patched_module_cache"),
+                 Settings::values.use_patched_module_cache, false);
 
     qt_config->endGroup();
 }
@@ -1234,6 +1262,14 @@ void Config::SaveDebuggingValues() {
     WriteSetting(QStringLiteral("dump_nso"), Settings::values.dump_nso, false);
     WriteSetting(QStringLiteral("quest_flag"), Settings::values.quest_flag, false);
     WriteSetting(QStringLiteral("disable_macro_jit"), Settings::values.disable_macro_jit, false);
+    WriteSetting(QStringLiteral("use_host_write_tracking"),
+                 Settings::values.use_host_write_tracking, false);
+    WriteSetting(QStringLiteral("enable_jit_perf_map"), Settings::values.enable_jit_perf_map,
+                 false);
+    WriteSetting(QStringLiteral("enable_guest_profiler"), Settings::values.enable_guest_profiler,
+                 false);
+    WriteSetting(QStringLiteral("enable_jit_block_profile"),
+                 Settings::values.enable_jit_block_profile, false);
 
     qt_config->endGroup();
 }
@@ -1347,6 +1383,9 @@ void Config::SaveRendererValues() {
                        Settings::values.gpu_accuracy.UsingGlobal(), 0);
     WriteSettingGlobal(QStringLiteral("use_asynchronous_gpu_emulation"),
                        Settings::values.use_asynchronous_gpu_emulation, true);
+    WriteSettingGlobal(QStringLiteral("query_resolution"),
+                       static_cast<int>(Settings::values.query_resolution.GetValue(global)),
+                       Settings::values.query_resolution.UsingGlobal(), 0);
     WriteSettingGlobal(QStringLiteral("use_nvdec_emulation"), Settings::values.use_nvdec_emulation,
                        true);
     WriteSettingGlobal(QStringLiteral("use_vsync"), Settings::values.use_vsync, true);
@@ -1356,6 +1395,13 @@ void Config::SaveRendererValues() {
                        Settings::values.use_asynchronous_shaders, false);
     WriteSettingGlobal(QStringLiteral("use_fast_gpu_time"), Settings::values.use_fast_gpu_time,
                        true);
+    WriteSetting(QStringLiteral("composition_target_latency_us"),
+                 Settings::values.composition_target_latency_us, 0);
+    WriteSetting(QStringLiteral("unlock_framerate"), Settings::values.unlock_framerate, false);
+    WriteSetting(QStringLiteral("transcode_astc_to_bc7"), Settings::values.transcode_astc_to_bc7,
+                 false);
+    WriteSetting(QStringLiteral("deduplicate_texture_uploads"),
+                 Settings::values.deduplicate_texture_uploads, false);
     // Cast to double because Qt's written float values are not human-readable
     WriteSettingGlobal(QStringLiteral("bg_red"), Settings::values.bg_red, 0.0);
     WriteSettingGlobal(QStringLiteral("bg_green"), Settings::values.bg_green, 0.0);
@@ -134,3 +134,4 @@ private:
 // These metatype declarations cannot be in core/settings.h because core is devoid of QT
 Q_DECLARE_METATYPE(Settings::RendererBackend);
 Q_DECLARE_METATYPE(Settings::GPUAccuracy);
+Q_DECLARE_METATYPE(Settings::QueryResolution);
@@ -38,6 +38,8 @@ void SetPerGameSetting(QComboBox* combobox,
                        const Settings::Setting<Settings::RendererBackend>* setting);
 void SetPerGameSetting(QComboBox* combobox,
                        const Settings::Setting<Settings::GPUAccuracy>* setting);
+void SetPerGameSetting(QComboBox* combobox,
+                       const Settings::Setting<Settings::QueryResolution>* setting);
 
 void SetHighlight(QWidget* widget, bool highlighted);
 void SetColoredTristate(QCheckBox* checkbox, const Settings::Setting<bool>& setting,
@@ -35,6 +35,8 @@ void ConfigureGraphicsAdvanced::SetConfiguration() {
     if (Settings::IsConfiguringGlobal()) {
         ui->gpu_accuracy->setCurrentIndex(
             static_cast<int>(Settings::values.gpu_accuracy.GetValue()));
+        ui->query_resolution->setCurrentIndex(
+            static_cast<int>(Settings::values.query_resolution.GetValue()));
         ui->anisotropic_filtering_combobox->setCurrentIndex(
             Settings::values.max_anisotropy.GetValue());
     } else {
@@ -43,6 +45,10 @@ void ConfigureGraphicsAdvanced::SetConfiguration() {
                                                &Settings::values.max_anisotropy);
         ConfigurationShared::SetHighlight(ui->label_gpu_accuracy,
                                           !Settings::values.gpu_accuracy.UsingGlobal());
+        ConfigurationShared::SetPerGameSetting(ui->query_resolution,
+                                               &Settings::values.query_resolution);
+        ConfigurationShared::SetHighlight(ui->label_query_resolution,
+                                          !Settings::values.query_resolution.UsingGlobal());
         ConfigurationShared::SetHighlight(ui->af_label,
                                           !Settings::values.max_anisotropy.UsingGlobal());
     }
@@ -53,12 +59,18 @@ void ConfigureGraphicsAdvanced::ApplyConfiguration() {
     const auto gpu_accuracy = static_cast<Settings::GPUAccuracy>(
         ui->gpu_accuracy->currentIndex() -
         ((Settings::IsConfiguringGlobal()) ? 0 : ConfigurationShared::USE_GLOBAL_OFFSET));
+    const auto query_resolution = static_cast<Settings::QueryResolution>(
+        ui->query_resolution->currentIndex() -
+        ((Settings::IsConfiguringGlobal()) ? 0 : ConfigurationShared::USE_GLOBAL_OFFSET));
 
     if (Settings::IsConfiguringGlobal()) {
         // Must guard in case of a during-game configuration when set to be game-specific.
         if (Settings::values.gpu_accuracy.UsingGlobal()) {
             Settings::values.gpu_accuracy.SetValue(gpu_accuracy);
         }
+        if (Settings::values.query_resolution.UsingGlobal()) {
+            Settings::values.query_resolution.SetValue(query_resolution);
+        }
         if (Settings::values.use_vsync.UsingGlobal()) {
             Settings::values.use_vsync.SetValue(ui->use_vsync->isChecked());
         }
@@ -101,6 +113,13 @@ void ConfigureGraphicsAdvanced::ApplyConfiguration() {
             Settings::values.gpu_accuracy.SetGlobal(false);
             Settings::values.gpu_accuracy.SetValue(gpu_accuracy);
         }
+
+        if (ui->query_resolution->currentIndex() == ConfigurationShared::USE_GLOBAL_INDEX) {
+            Settings::values.query_resolution.SetGlobal(true);
+        } else {
+            Settings::values.query_resolution.SetGlobal(false);
+            Settings::values.query_resolution.SetValue(query_resolution);
+        }
     }
 }
 
@@ -120,6 +139,7 @@ void ConfigureGraphicsAdvanced::SetupPerGameUI() {
     // Disable if not global (only happens during game)
     if (Settings::IsConfiguringGlobal()) {
         ui->gpu_accuracy->setEnabled(Settings::values.gpu_accuracy.UsingGlobal());
+        ui->query_resolution->setEnabled(Settings::values.query_resolution.UsingGlobal());
         ui->use_vsync->setEnabled(Settings::values.use_vsync.UsingGlobal());
         ui->use_assembly_shaders->setEnabled(Settings::values.use_assembly_shaders.UsingGlobal());
         ui->use_asynchronous_shaders->setEnabled(
@@ -142,6 +162,9 @@ void ConfigureGraphicsAdvanced::SetupPerGameUI() {
     ConfigurationShared::SetColoredComboBox(
         ui->gpu_accuracy, ui->label_gpu_accuracy,
         static_cast<int>(Settings::values.gpu_accuracy.GetValue(true)));
+    ConfigurationShared::SetColoredComboBox(
+        ui->query_resolution, ui->label_query_resolution,
+        static_cast<int>(Settings::values.query_resolution.GetValue(true)));
     ConfigurationShared::SetColoredComboBox(
         ui->anisotropic_filtering_combobox, ui->af_label,
         static_cast<int>(Settings::values.max_anisotropy.GetValue(true)));
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -17,6 +18,7 @@
 #include "core/core.h"
 #include "core/file_sys/card_image.h"
 #include "core/file_sys/content_archive.h"
+#include "core/file_sys/content_scanner.h"
 #include "core/file_sys/control_metadata.h"
 #include "core/file_sys/mode.h"
 #include "core/file_sys/nca_metadata.h"
@@ -142,6 +144,11 @@ bool HasSupportedFileExtension(const std::string& file_name) {
     return GameList::supported_file_extensions.contains(file.suffix(), Qt::CaseInsensitive);
 }
 
+bool IsContentContainer(Loader::FileType file_type) {
+    return file_type == Loader::FileType::NCA || file_type == Loader::FileType::XCI ||
+           file_type == Loader::FileType::NSP;
+}
+
 bool IsExtractedNCAMain(const std::string& file_name) {
     return QFileInfo(QString::fromStdString(file_name)).fileName() == QStringLiteral("main");
 }
@@ -189,9 +196,10 @@ QString FormatPatchNameVersions(const FileSys::PatchManager& patch_manager,
 }
 
 QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::string& name,
-                                        const std::vector<u8>& icon, Loader::AppLoader& loader,
+                                        const std::vector<u8>& icon, Loader::FileType file_type,
                                         u64 program_id, const CompatibilityList& compatibility_list,
-                                        const FileSys::PatchManager& patch) {
+                                        const FileSys::PatchManager& patch,
+                                        const std::function<QString()>& patch_versions_generator) {
     const auto it = FindMatchingCompatibilityEntry(compatibility_list, program_id);
 
     // The game list uses this as compatibility number for untested games
@@ -200,7 +208,6 @@ QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::stri
         compatibility = it->second.first;
     }
 
-    const auto file_type = loader.GetFileType();
     const auto file_type_string = QString::fromStdString(Loader::GetFileTypeString(file_type));
 
     QList<QStandardItem*> list{
@@ -213,9 +220,7 @@ QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::stri
 
     if (UISettings::values.show_add_ons) {
         const auto patch_versions = GetGameListCachedObject(
-            fmt::format("{:016X}", patch.GetTitleID()), "pv.txt", [&patch, &loader] {
-                return FormatPatchNameVersions(patch, loader, loader.IsRomFSUpdatable());
-            });
+            fmt::format("{:016X}", patch.GetTitleID()), "pv.txt", patch_versions_generator);
         list.insert(2, new GameListItem(patch_versions));
     }
 
@@ -253,6 +258,9 @@ void GameListWorker::AddTitlesToGameList(GameListDir* parent_dir) {
     }
 
     for (const auto& [slot, game] : installed_games) {
+        if (stop_processing) {
+            return;
+        }
         if (slot == ContentProviderUnionSlot::FrontendManual) {
             continue;
         }
@@ -275,89 +283,129 @@ void GameListWorker::AddTitlesToGameList(GameListDir* parent_dir) {
             GetMetadataFromControlNCA(patch, *control, icon, name);
         }
 
-        emit EntryReady(MakeGameListEntry(file->GetFullPath(), name, icon, *loader, program_id,
-                                          compatibility_list, patch),
+        emit EntryReady(MakeGameListEntry(file->GetFullPath(), name, icon, loader->GetFileType(),
+                                          program_id, compatibility_list, patch,
+                                          [&patch, &loader] {
+                                              return FormatPatchNameVersions(
+                                                  patch, *loader, loader->IsRomFSUpdatable());
+                                          }),
                         parent_dir);
     }
 }
 
-void GameListWorker::ScanFileSystem(ScanTarget target, const std::string& dir_path,
-                                    unsigned int recursion, GameListDir* parent_dir) {
+std::vector<std::string> GameListWorker::CollectFiles(const std::string& dir_path,
+                                                      unsigned int recursion) {
+    std::vector<std::string> directories;
+    auto files = FileSys::ContentScanner::CollectFiles(
+        dir_path, recursion,
+        [](const std::string& physical_name) {
+            return HasSupportedFileExtension(physical_name) || IsExtractedNCAMain(physical_name);
+        },
+        &directories);
+
+    for (const auto& directory : directories) {
+        watch_list.append(QString::fromStdString(directory));
+    }
+    return files;
+}
+
+void GameListWorker::FillManualContentProvider(const std::vector<std::string>& files) {
     auto& system = Core::System::GetInstance();
 
-    const auto callback = [this, target, recursion, parent_dir,
-                           &system](u64* num_entries_out, const std::string& directory,
-                                    const std::string& virtual_name) -> bool {
+    // Files are parsed serially, as parsing NSPs registers their title keys in the KeyManager,
+    // which is not thread-safe
+    for (const std::string& physical_name : files) {
         if (stop_processing) {
-            // Breaks the callback loop.
-            return false;
+            return;
         }
 
-        const std::string physical_name = directory + DIR_SEP + virtual_name;
-        const bool is_dir = Common::FS::IsDirectory(physical_name);
-        if (!is_dir &&
-            (HasSupportedFileExtension(physical_name) || IsExtractedNCAMain(physical_name))) {
-            const auto file = vfs->OpenFile(physical_name, FileSys::Mode::Read);
-            auto loader = Loader::GetLoader(system, file);
-            if (!loader) {
-                return true;
-            }
+        std::optional<FileSys::ContentMetadata> cached;
+        if (metadata_cache) {
+            cached = metadata_cache->Find(physical_name, Common::FS::GetSize(physical_name),
+                                          Common::FS::GetModificationTime(physical_name));
+        }
+        if (cached && (!cached->IsValid() || cached->program_id == 0 ||
+                       !IsContentContainer(cached->file_type))) {
+            // Nothing to register, skip opening the file
+            continue;
+        }
 
-            const auto file_type = loader->GetFileType();
-            if (file_type == Loader::FileType::Unknown || file_type == Loader::FileType::Error) {
-                return true;
+        const auto file = vfs->OpenFile(physical_name, FileSys::Mode::Read);
+        if (!file) {
+            continue;
+        }
+
+        auto file_type = Loader::FileType::Unknown;
+        u64 program_id = 0;
+        if (cached) {
+            file_type = cached->file_type;
+            program_id = cached->program_id;
+        } else {
+            const auto loader = Loader::GetLoader(system, file);
+            if (!loader || loader->ReadProgramId(program_id) != Loader::ResultStatus::Success) {
+                continue;
             }
+            file_type = loader->GetFileType();
+        }
 
-            u64 program_id = 0;
-            const auto res2 = loader->ReadProgramId(program_id);
-
-            if (target == ScanTarget::FillManualContentProvider) {
-                if (res2 == Loader::ResultStatus::Success && file_type == Loader::FileType::NCA) {
-                    provider->AddEntry(FileSys::TitleType::Application,
-                                       FileSys::GetCRTypeFromNCAType(FileSys::NCA{file}.GetType()),
-                                       program_id, file);
-                } else if (res2 == Loader::ResultStatus::Success &&
-                           (file_type == Loader::FileType::XCI ||
-                            file_type == Loader::FileType::NSP)) {
-                    const auto nsp = file_type == Loader::FileType::NSP
-                                         ? std::make_shared<FileSys::NSP>(file)
-                                         : FileSys::XCI{file}.GetSecurePartitionNSP();
-                    for (const auto& title : nsp->GetNCAs()) {
-                        for (const auto& entry : title.second) {
-                            provider->AddEntry(entry.first.first, entry.first.second, title.first,
-                                               entry.second->GetBaseFile());
-                        }
-                    }
+        if (file_type == Loader::FileType::NCA) {
+            const auto content_type = FileSys::GetCRTypeFromNCAType(FileSys::NCA{file}.GetType());
+            provider->AddEntry(FileSys::TitleType::Application, content_type, program_id, file);
+        } else if (file_type == Loader::FileType::XCI || file_type == Loader::FileType::NSP) {
+            const auto nsp = file_type == Loader::FileType::NSP
+                                 ? std::make_shared<FileSys::NSP>(file)
+                                 : FileSys::XCI{file}.GetSecurePartitionNSP();
+            for (const auto& title : nsp->GetNCAs()) {
+                for (const auto& entry : title.second) {
+                    provider->AddEntry(entry.first.first, entry.first.second, title.first,
+                                       entry.second->GetBaseFile());
                 }
-            } else {
-                std::vector<u8> icon;
-                [[maybe_unused]] const auto res1 = loader->ReadIcon(icon);
-
-                std::string name = " ";
-                [[maybe_unused]] const auto res3 = loader->ReadTitle(name);
-
-                const FileSys::PatchManager patch{program_id, system.GetFileSystemController(),
-                                                  system.GetContentProvider()};
-
-                emit EntryReady(MakeGameListEntry(physical_name, name, icon, *loader, program_id,
-                                                  compatibility_list, patch),
-                                parent_dir);
             }
-        } else if (is_dir && recursion > 0) {
-            watch_list.append(QString::fromStdString(physical_name));
-            ScanFileSystem(target, physical_name, recursion - 1, parent_dir);
         }
+    }
+}
 
-        return true;
-    };
+void GameListWorker::PopulateGameList(const std::vector<std::string>& files,
+                                      GameListDir* parent_dir) {
+    auto& system = Core::System::GetInstance();
 
-    Common::FS::ForeachDirectoryEntry(nullptr, dir_path, callback);
+    FileSys::ContentScanner scanner{system, vfs, metadata_cache.get()};
+    scanner.Scan(
+        files,
+        [this, &system, parent_dir](const FileSys::ContentMetadata& metadata) {
+            const FileSys::PatchManager patch{metadata.program_id,
+                                              system.GetFileSystemController(),
+                                              system.GetContentProvider()};
+
+            // The loader is only needed to list add-ons whose versions are not cached yet
+            const auto patch_versions_generator = [this, &system, &patch, &metadata] {
+                const auto file = vfs->OpenFile(metadata.path, FileSys::Mode::Read);
+                const auto loader = Loader::GetLoader(system, file);
+                if (!loader) {
+                    return QString{};
+                }
+                return FormatPatchNameVersions(patch, *loader, loader->IsRomFSUpdatable());
+            };
+
+            emit EntryReady(MakeGameListEntry(metadata.path, metadata.title, metadata.icon,
+                                              metadata.file_type, metadata.program_id,
+                                              compatibility_list, patch, patch_versions_generator),
+                            parent_dir);
+        },
+        stop_processing);
 }
 
 void GameListWorker::run() {
     stop_processing = false;
     provider->ClearAllEntries();
 
+    if (UISettings::values.cache_game_list) {
+        metadata_cache = std::make_unique<FileSys::ContentMetadataCache>(
+            Common::FS::GetUserPath(Common::FS::UserPath::CacheDir) + DIR_SEP + "game_list" +
+            DIR_SEP + "content_metadata.bin");
+        metadata_cache->Load();
+    }
+
     for (UISettings::GameDir& game_dir : game_dirs) {
         if (game_dir.path == QStringLiteral("SDMC")) {
             auto* const game_list_dir = new GameListDir(game_dir, GameListItemType::SdmcDir);
@@ -375,11 +423,18 @@ void GameListWorker::run() {
             watch_list.append(game_dir.path);
             auto* const game_list_dir = new GameListDir(game_dir);
             emit DirEntryReady(game_list_dir);
-            ScanFileSystem(ScanTarget::FillManualContentProvider, game_dir.path.toStdString(),
-                           game_dir.deep_scan ? 256 : 0, game_list_dir);
-            ScanFileSystem(ScanTarget::PopulateGameList, game_dir.path.toStdString(),
-                           game_dir.deep_scan ? 256 : 0, game_list_dir);
+            const auto files =
+                CollectFiles(game_dir.path.toStdString(), game_dir.deep_scan ? 256 : 0);
+            FillManualContentProvider(files);
+            PopulateGameList(files, game_list_dir);
+        }
+    }
+
+    if (metadata_cache) {
+        if (!stop_processing) {
+            metadata_cache->PruneUnused();
         }
+        metadata_cache->Save();
     }
 
     emit Finished(watch_list);
@@ -9,6 +9,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <QList>
 #include <QObject>
@@ -22,6 +23,7 @@
 class QStandardItem;
 
 namespace FileSys {
+class ContentMetadataCache;
 class NCA;
 class VfsFilesystem;
 } // namespace FileSys
@@ -65,19 +67,22 @@ signals:
 private:
     void AddTitlesToGameList(GameListDir* parent_dir);
 
-    enum class ScanTarget {
-        FillManualContentProvider,
-        PopulateGameList,
-    };
+    /// Lists the game files in dir_path and adds its subdirectories to the watch list.
+    std::vector<std::string> CollectFiles(const std::string& dir_path, unsigned int recursion);
 
-    void ScanFileSystem(ScanTarget target, const std::string& dir_path, unsigned int recursion,
-                        GameListDir* parent_dir);
+    /// Registers the contents of the given files in the manual content provider, in parallel.
+    void FillManualContentProvider(const std::vector<std::string>& files);
+
+    /// Emits a game list entry for every loadable file, using the metadata cache when possible.
+    void PopulateGameList(const std::vector<std::string>& files, GameListDir* parent_dir);
 
     std::shared_ptr<FileSys::VfsFilesystem> vfs;
     FileSys::ManualContentProvider* provider;
     QVector<UISettings::GameDir>& game_dirs;
     const CompatibilityList& compatibility_list;
 
+    std::unique_ptr<FileSys::ContentMetadataCache> metadata_cache;
+
     QStringList watch_list;
     std::atomic_bool stop_processing;
 };
@@ -89,6 +89,7 @@ static FileSys::VirtualFile VfsDirectoryCreateFileWrapper(const FileSys::Virtual
 #include "core/file_sys/romfs.h"
 #include "core/file_sys/savedata_factory.h"
 #include "core/file_sys/submission_package.h"
+#include "core/file_sys/vfs_streaming_copy.h"
 #include "core/hle/kernel/process.h"
 #include "core/hle/service/am/am.h"
 #include "core/hle/service/filesystem/filesystem.h"
@@ -1865,8 +1866,8 @@ void GMainWindow::OnMenuLoadFolder() {
     }
 }
 
-void GMainWindow::IncrementInstallProgress() {
-    install_progress->setValue(install_progress->value() + 1);
+void GMainWindow::IncrementInstallProgress(int blocks) {
+    install_progress->setValue(install_progress->value() + blocks);
 }
 
 void GMainWindow::OnMenuInstallToNAND() {
@@ -1978,26 +1979,25 @@ void GMainWindow::OnMenuInstallToNAND() {
 
 InstallResult GMainWindow::InstallNSPXCI(const QString& filename) {
     const auto qt_raw_copy = [this](const FileSys::VirtualFile& src,
-                                    const FileSys::VirtualFile& dest, std::size_t block_size) {
-        if (src == nullptr || dest == nullptr) {
-            return false;
-        }
-        if (!dest->Resize(src->GetSize())) {
-            return false;
-        }
-
-        std::array<u8, 0x1000> buffer{};
-
-        for (std::size_t i = 0; i < src->GetSize(); i += buffer.size()) {
+                                    const FileSys::VirtualFile& dest, std::size_t block_size,
+                                    Core::Crypto::SHA256Hash* hash) {
+        // Progress is counted in 0x1000 byte blocks, carry the remainder between chunks
+        std::size_t pending_bytes = 0;
+        const auto progress = [this, &pending_bytes](std::size_t bytes_written) {
             if (install_progress->wasCanceled()) {
-                dest->Resize(0);
                 return false;
             }
-
-            emit UpdateInstallProgress();
-
-            const auto read = src->Read(buffer.data(), buffer.size(), i);
-            dest->Write(buffer.data(), read, i);
+            pending_bytes += bytes_written;
+            emit UpdateInstallProgress(static_cast<int>(pending_bytes / 0x1000));
+            pending_bytes %= 0x1000;
+            return true;
+        };
+        if (!FileSys::VfsStreamingCopy(
+                src, dest, {.chunk_size = block_size, .hash = hash, .progress = progress})) {
+            if (dest != nullptr) {
+                dest->Resize(0);
+            }
+            return false;
         }
         return true;
     };
@@ -2032,26 +2032,25 @@ InstallResult GMainWindow::InstallNSPXCI(const QString& filename) {
 
 InstallResult GMainWindow::InstallNCA(const QString& filename) {
     const auto qt_raw_copy = [this](const FileSys::VirtualFile& src,
-                                    const FileSys::VirtualFile& dest, std::size_t block_size) {
-        if (src == nullptr || dest == nullptr) {
-            return false;
-        }
-        if (!dest->Resize(src->GetSize())) {
-            return false;
-        }
-
-        std::array<u8, 0x1000> buffer{};
-
-        for (std::size_t i = 0; i < src->GetSize(); i += buffer.size()) {
+                                    const FileSys::VirtualFile& dest, std::size_t block_size,
+                                    Core::Crypto::SHA256Hash* hash) {
+        // Progress is counted in 0x1000 byte blocks, carry the remainder between chunks
+        std::size_t pending_bytes = 0;
+        const auto progress = [this, &pending_bytes](std::size_t bytes_written) {
             if (install_progress->wasCanceled()) {
-                dest->Resize(0);
                 return false;
             }
-
-            emit UpdateInstallProgress();
-
-            const auto read = src->Read(buffer.data(), buffer.size(), i);
-            dest->Write(buffer.data(), read, i);
+            pending_bytes += bytes_written;
+            emit UpdateInstallProgress(static_cast<int>(pending_bytes / 0x1000));
+            pending_bytes %= 0x1000;
+            return true;
+        };
+        if (!FileSys::VfsStreamingCopy(
+                src, dest, {.chunk_size = block_size, .hash = hash, .progress = progress})) {
+            if (dest != nullptr) {
+                dest->Resize(0);
+            }
+            return false;
         }
         return true;
     };
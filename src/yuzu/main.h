@@ -119,7 +119,7 @@ signals:
     // Signal that tells widgets to update icons to use the current theme
     void UpdateThemedIcons();
 
-    void UpdateInstallProgress();
+    void UpdateInstallProgress(int blocks);
 
     void ControllerSelectorReconfigureFinished();
 
@@ -227,7 +227,7 @@ private slots:
     void OnGameListOpenPerGameProperties(const std::string& file);
     void OnMenuLoadFile();
     void OnMenuLoadFolder();
-    void IncrementInstallProgress();
+    void IncrementInstallProgress(int blocks);
     void OnMenuInstallToNAND();
     void OnMenuRecentFile();
     void OnConfigure();
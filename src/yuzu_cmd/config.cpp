@@ -368,6 +368,11 @@ void Config::ReadValues() {
     // Core
     Settings::values.use_multi_core.SetValue(
         sdl2_config->GetBoolean("Core", "use_multi_core", true));
+    Settings::values.cpu_idle_policy = static_cast<Settings::CPUIdlePolicy>(
+        sdl2_config->GetInteger("Core", "cpu_idle_policy", 0));
+    Settings::values.pin_host_threads = sdl2_config->GetBoolean("Core", "pin_host_threads", false);
+    Settings::values.use_patched_module_cache =
+        sdl2_config->GetBoolean("Core", "use_patched_module_cache", false);
 
     // Renderer
     const int renderer_backend = sdl2_config->GetInteger(
@@ -392,6 +397,8 @@ void Config::ReadValues() {
     Settings::values.gpu_accuracy.SetValue(static_cast<Settings::GPUAccuracy>(gpu_accuracy_level));
     Settings::values.use_asynchronous_gpu_emulation.SetValue(
         sdl2_config->GetBoolean("Renderer", "use_asynchronous_gpu_emulation", true));
+    Settings::values.query_resolution.SetValue(static_cast<Settings::QueryResolution>(
+        sdl2_config->GetInteger("Renderer", "query_resolution", 0)));
     Settings::values.use_vsync.SetValue(
         static_cast<u16>(sdl2_config->GetInteger("Renderer", "use_vsync", 1)));
     Settings::values.use_assembly_shaders.SetValue(
@@ -402,6 +409,14 @@ void Config::ReadValues() {
         sdl2_config->GetBoolean("Renderer", "use_asynchronous_shaders", false));
     Settings::values.use_fast_gpu_time.SetValue(
         sdl2_config->GetBoolean("Renderer", "use_fast_gpu_time", true));
+    Settings::values.composition_target_latency_us = static_cast<u16>(
+        sdl2_config->GetInteger("Renderer", "composition_target_latency_us", 0));
+    Settings::values.unlock_framerate =
+        sdl2_config->GetBoolean("Renderer", "unlock_framerate", false);
+    Settings::values.transcode_astc_to_bc7 =
+        sdl2_config->GetBoolean("Renderer", "transcode_astc_to_bc7", false);
+    Settings::values.deduplicate_texture_uploads =
+        sdl2_config->GetBoolean("Renderer", "deduplicate_texture_uploads", false);
 
     Settings::values.bg_red.SetValue(
         static_cast<float>(sdl2_config->GetReal("Renderer", "bg_red", 0.0)));
@@ -433,6 +448,14 @@ void Config::ReadValues() {
     Settings::values.quest_flag = sdl2_config->GetBoolean("Debugging", "quest_flag", false);
     Settings::values.disable_macro_jit =
         sdl2_config->GetBoolean("Debugging", "disable_macro_jit", false);
+    Settings::values.use_host_write_tracking =
+        sdl2_config->GetBoolean("Debugging", "use_host_write_tracking", false);
+    Settings::values.enable_jit_perf_map =
+        sdl2_config->GetBoolean("Debugging", "enable_jit_perf_map", false);
+    Settings::values.enable_guest_profiler =
+        sdl2_config->GetBoolean("Debugging", "enable_guest_profiler", false);
+    Settings::values.enable_jit_block_profile =
+        sdl2_config->GetBoolean("Debugging", "enable_jit_block_profile", false);
 
     const auto title_list = sdl2_config->Get("AddOns", "title_ids", "");
     std::stringstream ss(title_list);
@@ -105,6 +105,20 @@ udp_pad_index=
 # 0: Disabled, 1 (default): Enabled
 use_multi_core=
 
+# How idle emulated cores wait for work. Adaptive spins for a short time before blocking, which
+# lowers wake up latency at the cost of host CPU time.
+# 0 (default): Block, 1: Adaptive spin then block
+cpu_idle_policy=
+
+# Pins each emulated core and the GPU thread to its own physical host core
+# 0 (default): Disabled, 1: Enabled
+pin_host_threads=
+
+# Caches executable modules with mods applied on disk, skipping decompression and patching on the
+# next boot. The cache is invalidated when the mods of a module change.
+# 0 (default): Disabled, 1: Enabled
+use_patched_module_cache=
+
 [Cpu]
 # Enable inline page tables optimization (faster guest memory access)
 # 0: Disabled, 1 (default): Enabled
@@ -198,6 +212,32 @@ gpu_accuracy =
 # 0 : Off (slow), 1 (default): On (fast)
 use_asynchronous_gpu_emulation =
 
+# How occlusion query results are returned when the game reads them before the GPU finished them.
+# Conservative avoids waiting for the GPU by returning the previous result of the query, or
+# reporting it as visible, and writes the exact result once it is available.
+# 0 (default): Accurate, 1: Conservative
+query_resolution =
+
+# Time in microseconds before each vsync at which the game's frame is latched for composition,
+# vsync is signalled to the game afterwards. Frames rendered within the rest of the frame are shown
+# at the next vsync, cutting up to a frame of input latency. Too low values cause missed frames.
+# 0 (default): Compose at the start of each frame, 1 - 16666: Target latency
+composition_target_latency_us =
+
+# Composes frames as fast as they complete instead of at the rate requested by the game
+# 0 (default): Off, 1: On
+unlock_framerate =
+
+# Stores ASTC textures as BC7 instead of RGBA8 when the GPU doesn't support ASTC. Uses a quarter of
+# the memory and upload bandwidth, at the cost of some image quality and CPU time on upload.
+# 0 (default): Off, 1: On
+transcode_astc_to_bc7 =
+
+# Hashes guest texture contents before uploading them, skipping uploads of contents an image already
+# holds and copying contents another image holds. Costs CPU time, bounded to 32 MiB per frame.
+# 0 (default): Off, 1: On
+deduplicate_texture_uploads =
+
 # Forces VSync on the display thread. Usually doesn't impact performance, but on some drivers it can
 # so only turn this off if you notice a speed difference.
 # 0: Off, 1 (default): On
@@ -327,6 +367,18 @@ dump_nso=false
 quest_flag =
 # Enables/Disables the macro JIT compiler
 disable_macro_jit=false
+# Detects CPU writes to GPU cached memory with host page protection (Linux only)
+# Reads of that memory skip flushing GPU writes. false (default): Off, true: On
+use_host_write_tracking=false
+# Writes /tmp/perf-<pid>.map for JIT compiled code and /tmp/perf-<pid>.guest.map with the guest
+# symbols of the loaded modules, for use with perf (Linux only). false (default): Off, true: On
+enable_jit_perf_map=false
+# Samples the PC of each core and logs the hottest guest functions on shutdown
+# false (default): Off, true: On
+enable_guest_profiler=false
+# Counts the guest blocks translated by the JIT and logs them, with the translation work done in
+# the first minute, on shutdown. false (default): Off, true: On
+enable_jit_block_profile=false
 
 [WebService]
 # Whether or not to enable telemetry